@@ -21,6 +21,7 @@
 */
 
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/math/solvers1d/brent.hpp>
@@ -28,6 +29,7 @@
 #include <ql/patterns/visitor.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/yieldcurvesnapshot.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
 #include <utility>
 
@@ -1249,4 +1251,422 @@ namespace QuantLib {
         return solver.solve(objFunction, accuracy, guess, step);
     }
 
+
+    // compiled-leg functions
+
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg.hasOccurred(i, settlementDate, includeSettlementDateFlows) &&
+                !leg.tradingExCoupon(i, settlementDate))
+                totalNPV += leg.amount(i) * discountCurve.discount(leg.dates()[i]);
+        }
+
+        return totalNPV/discountCurve.discount(npvDate);
+    }
+
+    Real CashFlows::bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        Real bps = 0.0;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg.isCoupon(i) &&
+                !leg.hasOccurred(i, settlementDate, includeSettlementDateFlows) &&
+                !leg.tradingExCoupon(i, settlementDate))
+                bps += leg.bpsWeight(i) * discountCurve.discount(leg.dates()[i]);
+        }
+        return basisPoint_*bps/discountCurve.discount(npvDate);
+    }
+
+    void CashFlows::npvbps(const CompiledLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps) {
+
+        npv = 0.0;
+        bps = 0.0;
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg.hasOccurred(i, settlementDate, includeSettlementDateFlows) &&
+                !leg.tradingExCoupon(i, settlementDate)) {
+                Real df = discountCurve.discount(leg.dates()[i]);
+                npv += leg.amount(i) * df;
+                if (leg.isCoupon(i))
+                    bps += leg.bpsWeight(i) * df;
+            }
+        }
+        DiscountFactor d = discountCurve.discount(npvDate);
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+    namespace {
+
+        // sums of the given weights, discounted on each curve
+        std::vector<Real> discountedSums(const std::vector<YieldCurveSnapshot>& curves,
+                                         const std::vector<Date>& dates,
+                                         const std::vector<Real>& weights,
+                                         const Date& npvDate) {
+            std::vector<Real> result(curves.size(), 0.0);
+            if (curves.empty())
+                return result;
+
+            const Date& referenceDate = curves.front().referenceDate();
+            const DayCounter& dayCounter = curves.front().dayCounter();
+            for (const auto& curve : curves) {
+                QL_REQUIRE(curve.referenceDate() == referenceDate &&
+                           curve.dayCounter() == dayCounter,
+                           "discount curves with different reference dates "
+                           "or day counters given");
+            }
+
+            // the last time is the one of the NPV date
+            std::vector<Time> times(dates.size() + 1);
+            for (Size i=0; i<dates.size(); ++i)
+                times[i] = dayCounter.yearFraction(referenceDate, dates[i]);
+            times.back() = dayCounter.yearFraction(referenceDate, npvDate);
+
+            std::vector<DiscountFactor> discounts(times.size());
+            for (Size j=0; j<curves.size(); ++j) {
+                curves[j].discount(times.data(), times.data() + times.size(),
+                                   discounts.data());
+                Real sum = 0.0;
+                for (Size i=0; i<weights.size(); ++i)
+                    sum += weights[i] * discounts[i];
+                result[j] = sum / discounts.back();
+            }
+            return result;
+        }
+
+    }
+
+    std::vector<Real> CashFlows::npv(const CompiledLeg& leg,
+                                     const std::vector<YieldCurveSnapshot>& discountCurves,
+                                     bool includeSettlementDateFlows,
+                                     Date settlementDate,
+                                     Date npvDate) {
+        if (leg.empty())
+            return std::vector<Real>(discountCurves.size(), 0.0);
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Date> dates;
+        std::vector<Real> amounts;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg.hasOccurred(i, settlementDate, includeSettlementDateFlows) &&
+                !leg.tradingExCoupon(i, settlementDate)) {
+                dates.push_back(leg.dates()[i]);
+                amounts.push_back(leg.amount(i));
+            }
+        }
+        return discountedSums(discountCurves, dates, amounts, npvDate);
+    }
+
+    std::vector<Real> CashFlows::bps(const CompiledLeg& leg,
+                                     const std::vector<YieldCurveSnapshot>& discountCurves,
+                                     bool includeSettlementDateFlows,
+                                     Date settlementDate,
+                                     Date npvDate) {
+        if (leg.empty())
+            return std::vector<Real>(discountCurves.size(), 0.0);
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Date> dates;
+        std::vector<Real> weights;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg.isCoupon(i) &&
+                !leg.hasOccurred(i, settlementDate, includeSettlementDateFlows) &&
+                !leg.tradingExCoupon(i, settlementDate)) {
+                dates.push_back(leg.dates()[i]);
+                weights.push_back(leg.bpsWeight(i));
+            }
+        }
+        std::vector<Real> result =
+            discountedSums(discountCurves, dates, weights, npvDate);
+        for (auto& x : result)
+            x *= basisPoint_;
+        return result;
+    }
+
+    namespace {
+
+        /* Amounts of the cash flows that have not occurred, and times
+           between them, as used by the Leg functions for a given
+           yield.  Ex-coupon amounts are null.  The calculations
+           follow getStepwiseDiscountTime and the functions using it.
+        */
+        class StepwiseFlows {
+          public:
+            StepwiseFlows(const CompiledLeg& leg,
+                          const DayCounter& dc,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) {
+                Date lastDate = npvDate;
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (leg.hasOccurred(i, settlementDate, includeSettlementDateFlows))
+                        continue;
+
+                    amounts_.push_back(leg.tradingExCoupon(i, settlementDate) ?
+                                       Real(0.0) : leg.amount(i));
+
+                    Date cashFlowDate = leg.dates()[i];
+                    Date refStartDate, refEndDate;
+                    if (leg.isCoupon(i)) {
+                        refStartDate = leg.referencePeriodStart(i);
+                        refEndDate = leg.referencePeriodEnd(i);
+                    } else {
+                        if (lastDate == npvDate) {
+                            // we don't have a previous coupon date,
+                            // so we fake it
+                            refStartDate = cashFlowDate - 1*Years;
+                        } else  {
+                            refStartDate = lastDate;
+                        }
+                        refEndDate = cashFlowDate;
+                    }
+
+                    if (leg.isCoupon(i) && lastDate != leg.accrualStartDate(i)) {
+                        Time couponPeriod = dc.yearFraction(leg.accrualStartDate(i),
+                                                            cashFlowDate, refStartDate, refEndDate);
+                        Time accruedPeriod = dc.yearFraction(leg.accrualStartDate(i),
+                                                             lastDate, refStartDate, refEndDate);
+                        times_.push_back(couponPeriod - accruedPeriod);
+                    } else {
+                        times_.push_back(dc.yearFraction(lastDate, cashFlowDate,
+                                                         refStartDate, refEndDate));
+                    }
+
+                    lastDate = cashFlowDate;
+                }
+            }
+
+            Real npv(const InterestRate& y) const {
+                Real npv = 0.0;
+                DiscountFactor discount = 1.0;
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    discount *= y.discountFactor(times_[i]);
+                    npv += amounts_[i] * discount;
+                }
+                return npv;
+            }
+
+            Real simpleDuration(const InterestRate& y) const {
+                Real P = 0.0;
+                Real dPdy = 0.0;
+                Time t = 0.0;
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    Real c = amounts_[i];
+                    t += times_[i];
+                    DiscountFactor B = y.discountFactor(t);
+                    P += c * B;
+                    dPdy += t * c * B;
+                }
+                if (P == 0.0) // no cashflows
+                    return 0.0;
+                return dPdy/P;
+            }
+
+            Real modifiedDuration(const InterestRate& y) const {
+                Real P = 0.0;
+                Time t = 0.0;
+                Real dPdy = 0.0;
+                Rate r = y.rate();
+                Natural N = y.frequency();
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    Real c = amounts_[i];
+                    t += times_[i];
+                    DiscountFactor B = y.discountFactor(t);
+                    P += c * B;
+                    switch (y.compounding()) {
+                      case Simple:
+                        dPdy -= c * B*B * t;
+                        break;
+                      case Compounded:
+                        dPdy -= c * t * B/(1+r/N);
+                        break;
+                      case Continuous:
+                        dPdy -= c * B * t;
+                        break;
+                      case SimpleThenCompounded:
+                        if (t<=1.0/N)
+                            dPdy -= c * B*B * t;
+                        else
+                            dPdy -= c * t * B/(1+r/N);
+                        break;
+                      case CompoundedThenSimple:
+                        if (t>1.0/N)
+                            dPdy -= c * B*B * t;
+                        else
+                            dPdy -= c * t * B/(1+r/N);
+                        break;
+                      default:
+                        QL_FAIL("unknown compounding convention (" <<
+                                Integer(y.compounding()) << ")");
+                    }
+                }
+
+                if (P == 0.0) // no cashflows
+                    return 0.0;
+                return -dPdy/P; // reverse derivative sign
+            }
+
+            Real macaulayDuration(const InterestRate& y) const {
+                QL_REQUIRE(y.compounding() == Compounded,
+                           "compounded rate required");
+                return (1.0+y.rate()/Integer(y.frequency())) * modifiedDuration(y);
+            }
+
+            const std::vector<Real>& amounts() const { return amounts_; }
+
+          private:
+            std::vector<Real> amounts_;
+            std::vector<Time> times_;
+        };
+
+        class CompiledIrrFinder {
+          public:
+            CompiledIrrFinder(const StepwiseFlows& flows,
+                              Real npv,
+                              DayCounter dayCounter,
+                              Compounding comp,
+                              Frequency freq)
+            : flows_(flows), npv_(npv), dayCounter_(std::move(dayCounter)),
+              compounding_(comp), frequency_(freq) {
+                // same check as in CashFlows::IrrFinder; ex-coupon
+                // amounts are null and don't affect it
+                Integer lastSign = sign(-npv_),
+                        signChanges = 0;
+                for (Real amount : flows_.amounts()) {
+                    Integer thisSign = sign(amount);
+                    if (lastSign * thisSign < 0) // sign change
+                        signChanges++;
+
+                    if (thisSign != 0)
+                        lastSign = thisSign;
+                }
+                QL_REQUIRE(signChanges > 0,
+                           "the given cash flows cannot result in the given market "
+                           "price due to their sign");
+            }
+            Real operator()(Rate y) const {
+                InterestRate yield(y, dayCounter_, compounding_, frequency_);
+                return npv_ - flows_.npv(yield);
+            }
+            Real derivative(Rate y) const {
+                InterestRate yield(y, dayCounter_, compounding_, frequency_);
+                return flows_.modifiedDuration(yield);
+            }
+          private:
+            const StepwiseFlows& flows_;
+            Real npv_;
+            DayCounter dayCounter_;
+            Compounding compounding_;
+            Frequency frequency_;
+        };
+
+    }
+
+    Rate CashFlows::yield(const CompiledLeg& leg,
+                          Real npv,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate,
+                          Real accuracy,
+                          Size maxIterations,
+                          Rate guess) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        StepwiseFlows flows(leg, dayCounter, includeSettlementDateFlows,
+                            settlementDate, npvDate);
+        CompiledIrrFinder objFunction(flows, npv, dayCounter,
+                                      compounding, frequency);
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+    }
+
+    Time CashFlows::duration(const CompiledLeg& leg,
+                             const InterestRate& rate,
+                             Duration::Type type,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        StepwiseFlows flows(leg, rate.dayCounter(), includeSettlementDateFlows,
+                            settlementDate, npvDate);
+        switch (type) {
+          case Duration::Simple:
+            return flows.simpleDuration(rate);
+          case Duration::Modified:
+            return flows.modifiedDuration(rate);
+          case Duration::Macaulay:
+            return flows.macaulayDuration(rate);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
 }
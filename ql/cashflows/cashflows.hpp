@@ -34,7 +34,9 @@
 
 namespace QuantLib {
 
+    class CompiledLeg;
     class YieldTermStructure;
+    class YieldCurveSnapshot;
 
     //! %cashflow-analysis functions
     /*! \todo add tests */
@@ -443,6 +445,70 @@ namespace QuantLib {
         }
         //@}
 
+        //! \name Compiled-leg functions
+        /*! These functions give the same results as the ones above
+            taking a Leg, but read the data stored in a CompiledLeg
+            instead of asking them to each cash flow.
+        */
+        //@{
+        static Real npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static Real bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static void npvbps(const CompiledLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps);
+        //! NPVs of the cash flows over a set of discount curves.
+        /*! The curves must have the same reference date and day
+            counter; the payment times and the amounts of the cash
+            flows are calculated once and used for all of them.  The
+            amounts are read from the cash flows at the time of the
+            call, so the curves only affect discounting.
+        */
+        static std::vector<Real> npv(const CompiledLeg& leg,
+                                     const std::vector<YieldCurveSnapshot>& discountCurves,
+                                     bool includeSettlementDateFlows,
+                                     Date settlementDate = Date(),
+                                     Date npvDate = Date());
+        //! Basis-point sensitivities of the cash flows over a set of discount curves.
+        /*! The same remarks apply as for the NPVs. */
+        static std::vector<Real> bps(const CompiledLeg& leg,
+                                     const std::vector<YieldCurveSnapshot>& discountCurves,
+                                     bool includeSettlementDateFlows,
+                                     Date settlementDate = Date(),
+                                     Date npvDate = Date());
+        /*! The times between cash flows are calculated once, so
+            that the iterations of the solver don't call the day
+            counter.
+        */
+        static Rate yield(const CompiledLeg& leg,
+                          Real npv,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate = Date(),
+                          Date npvDate = Date(),
+                          Real accuracy = 1.0e-10,
+                          Size maxIterations = 100,
+                          Rate guess = 0.05);
+        static Time duration(const CompiledLeg& leg,
+                             const InterestRate& yield,
+                             Duration::Type type,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate = Date(),
+                             Date npvDate = Date());
+        //@}
     };
 
 }
@@ -0,0 +1,48 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    CompiledLeg::CompiledLeg(Leg leg)
+    : leg_(std::move(leg)), dates_(leg_.size()), exCouponDates_(leg_.size()),
+      amounts_(leg_.size(), Null<Real>()), bpsWeights_(leg_.size(), Null<Real>()),
+      accrualStartDates_(leg_.size()), referencePeriodStarts_(leg_.size()),
+      referencePeriodEnds_(leg_.size()) {
+        for (Size i=0; i<leg_.size(); ++i) {
+            const CashFlow& cf = *leg_[i];
+            dates_[i] = cf.date();
+            exCouponDates_[i] = cf.exCouponDate();
+            // the amounts of these cash flows are fixed at construction
+            if (dynamic_cast<const FixedRateCoupon*>(&cf) != nullptr ||
+                dynamic_cast<const SimpleCashFlow*>(&cf) != nullptr)
+                amounts_[i] = cf.amount();
+            auto coupon = dynamic_cast<const Coupon*>(&cf);
+            if (coupon != nullptr) {
+                bpsWeights_[i] = coupon->nominal() * coupon->accrualPeriod();
+                accrualStartDates_[i] = coupon->accrualStartDate();
+                referencePeriodStarts_[i] = coupon->referencePeriodStart();
+                referencePeriodEnds_[i] = coupon->referencePeriodEnd();
+            }
+        }
+    }
+
+}
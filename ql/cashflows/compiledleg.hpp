@@ -0,0 +1,101 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief leg data extracted into contiguous arrays
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/utilities/null.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! leg data extracted into contiguous arrays
+    /*! The payment dates, ex-coupon dates and accrual data of the
+        cash flows are read once and stored in arrays, together with
+        the amounts that cannot change, i.e., those of fixed-rate
+        coupons and simple cash flows.  The amounts of other cash
+        flows are still asked to the cash flows when needed, so that
+        they reflect the current market.
+
+        The compiled leg is used by the CashFlows functions with the
+        same name as those working on a Leg; they give the same
+        results, but don't go through shared pointers and virtual
+        calls for the data stored here.
+
+        \warning the cash flows are assumed not to change their dates
+                 after compilation.
+    */
+    class CompiledLeg {
+      public:
+        CompiledLeg() = default;
+        explicit CompiledLeg(Leg leg);
+        //! \name Inspectors
+        //@{
+        const Leg& leg() const { return leg_; }
+        Size size() const { return leg_.size(); }
+        bool empty() const { return leg_.empty(); }
+        const std::vector<Date>& dates() const { return dates_; }
+        //! the amount, read from the cash flow if not stored
+        Real amount(Size i) const {
+            return amounts_[i] != Null<Real>() ? amounts_[i] : leg_[i]->amount();
+        }
+        //! whether the i-th cash flow is a coupon
+        bool isCoupon(Size i) const { return bpsWeights_[i] != Null<Real>(); }
+        //! nominal times accrual period; null for other cash flows
+        Real bpsWeight(Size i) const { return bpsWeights_[i]; }
+        //! accrual start; null for other cash flows
+        const Date& accrualStartDate(Size i) const { return accrualStartDates_[i]; }
+        //! reference-period start; null for other cash flows
+        const Date& referencePeriodStart(Size i) const { return referencePeriodStarts_[i]; }
+        //! reference-period end; null for other cash flows
+        const Date& referencePeriodEnd(Size i) const { return referencePeriodEnds_[i]; }
+        //@}
+        //! \name Cash-flow status
+        /*! These methods give the same results as the corresponding
+            CashFlow methods; the cash flow is only called when the
+            payment date equals the reference date.
+
+            \pre the reference date must not be null.
+        */
+        //@{
+        bool hasOccurred(Size i, const Date& refDate, bool includeRefDate) const {
+            if (refDate < dates_[i])
+                return false;
+            if (dates_[i] < refDate)
+                return true;
+            return leg_[i]->hasOccurred(refDate, includeRefDate);
+        }
+        bool tradingExCoupon(Size i, const Date& refDate) const {
+            return exCouponDates_[i] != Date() && exCouponDates_[i] <= refDate;
+        }
+        //@}
+      private:
+        Leg leg_;
+        std::vector<Date> dates_, exCouponDates_;
+        std::vector<Real> amounts_, bpsWeights_;
+        std::vector<Date> accrualStartDates_;
+        std::vector<Date> referencePeriodStarts_, referencePeriodEnds_;
+    };
+
+}
+
+#endif
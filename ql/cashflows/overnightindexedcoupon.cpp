@@ -48,26 +48,30 @@ namespace QuantLib {
 
                 const ext::shared_ptr<OvernightIndex> index =
                     ext::dynamic_pointer_cast<OvernightIndex>(coupon_->index());
-                const auto& pastFixings = IndexManager::instance().getHistory(index->name());
 
                 const vector<Date>& fixingDates = coupon_->fixingDates();
                 const vector<Date>& valueDates = coupon_->valueDates();
                 const vector<Time>& dt = coupon_->dt();
 
-                Size i = 0;
                 const size_t n = std::lower_bound(valueDates.begin(), valueDates.end(), date) - valueDates.begin();
-                Real compoundFactor = 1.0;
 
-                // already fixed part
-                while (i < n && fixingDates[i] < today) {
+                // already fixed part; the periods accruing in full
+                // are compounded (and cached) by the coupon
+                const Size nPast =
+                    std::lower_bound(fixingDates.begin(), fixingDates.begin() + n, today)
+                    - fixingDates.begin();
+                Size i = (nPast == n && n > 0 && n < valueDates.size() && date < valueDates[n])
+                    ? n - 1 : nPast;
+                Real compoundFactor = coupon_->pastCompoundFactor(i);
+
+                if (i < nPast) {
                     // rate must have been fixed
-                    const Rate fixing = pastFixings[fixingDates[i]];
+                    const Rate fixing =
+                        IndexManager::instance().getHistory(index->name())[fixingDates[i]];
                     QL_REQUIRE(fixing != Null<Real>(),
                                "Missing " << index->name() <<
                                " fixing for " << fixingDates[i]);
-                    Time span = (date >= valueDates[i+1] ?
-                                 dt[i] :
-                                 index->dayCounter().yearFraction(valueDates[i], date));
+                    Time span = index->dayCounter().yearFraction(valueDates[i], date);
                     compoundFactor *= (1.0 + fixing * span);
                     ++i;
                 }
@@ -76,7 +80,8 @@ namespace QuantLib {
                 if (i < n && fixingDates[i] == today) {
                     // might have been fixed
                     try {
-                        Rate fixing = pastFixings[fixingDates[i]];
+                        Rate fixing =
+                            IndexManager::instance().getHistory(index->name())[fixingDates[i]];
                         if (fixing != Null<Real>()) {
                             Time span = (date >= valueDates[i+1] ?
                                          dt[i] :
@@ -259,6 +264,31 @@ namespace QuantLib {
         return fixings_;
     }
 
+    Real OvernightIndexedCoupon::pastCompoundFactor(Size n) const {
+        QL_REQUIRE(n <= n_, "too many periods (" << n << ") required, "
+                   "only " << n_ << " available");
+        std::vector<Real>& factors = pastCompoundFactors_.values;
+        if (factors.empty()) {
+            // the notifier is replaced if the history was cleared
+            pastCompoundFactors_.unregisterWithAll();
+            pastCompoundFactors_.registerWith(
+                IndexManager::instance().notifier(index_->name()));
+            factors.push_back(1.0);
+        }
+        if (factors.size() <= n) {
+            const TimeSeries<Real>& pastFixings =
+                IndexManager::instance().getHistory(index_->name());
+            for (Size i=factors.size()-1; i<n; ++i) {
+                const Rate fixing = pastFixings[fixingDates_[i]];
+                QL_REQUIRE(fixing != Null<Real>(),
+                           "Missing " << index_->name() <<
+                           " fixing for " << fixingDates_[i]);
+                factors.push_back(factors.back() * (1.0 + fixing * dt_[i]));
+            }
+        }
+        return factors[n];
+    }
+
     void OvernightIndexedCoupon::accept(AcyclicVisitor& v) {
         auto* v1 = dynamic_cast<Visitor<OvernightIndexedCoupon>*>(&v);
         if (v1 != nullptr) {
@@ -71,6 +71,12 @@ namespace QuantLib {
         const std::vector<Rate>& indexFixings() const;
         //! value dates for the rates to be compounded
         const std::vector<Date>& valueDates() const { return valueDates_; }
+        /*! compounding factor over the first \c n periods, whose
+            fixings must be stored in the index history.  The partial
+            products are cached, extended as more fixings are needed,
+            and discarded when the fixings of the index change.
+        */
+        Real pastCompoundFactor(Size n) const;
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -83,10 +89,16 @@ namespace QuantLib {
         void accept(AcyclicVisitor&) override;
         //@}
       private:
+        class CompoundFactors : public Observer {
+          public:
+            void update() override { values.clear(); }
+            std::vector<Real> values;
+        };
         std::vector<Date> valueDates_, fixingDates_;
         mutable std::vector<Rate> fixings_;
         Size n_;
         std::vector<Time> dt_;
+        mutable CompoundFactors pastCompoundFactors_;
 
         Rate averageRate(const Date& date) const;
     };
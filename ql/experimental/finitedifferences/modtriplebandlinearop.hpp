@@ -39,11 +39,11 @@ namespace QuantLib {
         : TripleBandLinearOp(m) { }
 
         Real lower(Size i) const { return lower_[i]; }
-        Real& lower(Size i) { return lower_[i]; }
+        Real& lower(Size i) { factorized_ = false; return lower_[i]; }
         Real diag(Size i) const { return diag_[i]; }
-        Real& diag(Size i) { return diag_[i]; }
+        Real& diag(Size i) { factorized_ = false; return diag_[i]; }
         Real upper(Size i) const { return upper_[i]; }
-        Real& upper(Size i) { return upper_[i]; }
+        Real& upper(Size i) { factorized_ = false; return upper_[i]; }
     };
 }
 
@@ -48,6 +48,10 @@ namespace QuantLib {
         Real drift(Time t, Real x) const override;
         Real diffusion(Time t, Real x) const override;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const override;
+        void evolveBatch(Time t0, const Array& x0,
+                         Time dt, const Array& dw, Array& x) const override {
+            StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x);
+        }
 
       private:
         const Discretization discretization_;
@@ -0,0 +1,231 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/experimental/risk/portfoliovaluation.hpp>
+#include <ql/instruments/bond.hpp>
+#include <ql/instruments/swap.hpp>
+#include <numeric>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        void addCouponPricers(
+                         const Leg& leg,
+                         std::set<const FloatingRateCouponPricer*>& pricers) {
+            for (const auto& cf : leg) {
+                auto coupon =
+                    ext::dynamic_pointer_cast<FloatingRateCoupon>(cf);
+                if (coupon && coupon->pricer())
+                    pricers.insert(coupon->pricer().get());
+            }
+        }
+
+        std::set<const FloatingRateCouponPricer*>
+        couponPricers(const Instrument& instrument) {
+            std::set<const FloatingRateCouponPricer*> pricers;
+            if (const auto* swap = dynamic_cast<const Swap*>(&instrument)) {
+                for (Size j=0; j<swap->numberOfLegs(); ++j)
+                    addCouponPricers(swap->leg(j), pricers);
+            } else if (const auto* bond =
+                                   dynamic_cast<const Bond*>(&instrument)) {
+                addCouponPricers(bond->cashflows(), pricers);
+            }
+            return pricers;
+        }
+
+    }
+
+    PortfolioValuation::PortfolioValuation(
+        std::vector<ext::shared_ptr<Instrument> > instruments)
+    : instruments_(std::move(instruments)) {
+        for (Size i=0; i<instruments_.size(); ++i) {
+            QL_REQUIRE(instruments_[i], "null instrument #" << i);
+            registerWith(instruments_[i]);
+        }
+    }
+
+    PortfolioValuation::PortfolioValuation(
+        std::vector<ext::shared_ptr<Instrument> > instruments,
+        Size maxInstrumentsPerEngine,
+        const EngineFactory& engineFactory)
+    : instruments_(std::move(instruments)) {
+        QL_REQUIRE(maxInstrumentsPerEngine > 0,
+                   "positive number of instruments per engine required");
+        QL_REQUIRE(engineFactory, "null engine factory");
+
+        // for each original engine, the engine currently assigned
+        // and the number of instruments it prices
+        std::map<const PricingEngine*,
+                 std::pair<ext::shared_ptr<PricingEngine>, Size> > engines;
+        for (Size i=0; i<instruments_.size(); ++i) {
+            QL_REQUIRE(instruments_[i], "null instrument #" << i);
+            const ext::shared_ptr<PricingEngine>& engine =
+                instruments_[i]->pricingEngine();
+            if (engine != nullptr) {
+                auto& current = engines.insert(
+                    std::make_pair(engine.get(),
+                                   std::make_pair(engine, Size(0))))
+                    .first->second;
+                if (current.second == maxInstrumentsPerEngine) {
+                    current.first = engineFactory(engine);
+                    QL_REQUIRE(current.first, "null engine returned");
+                    current.second = 0;
+                }
+                if (current.first != engine)
+                    instruments_[i]->setPricingEngine(current.first);
+                ++current.second;
+            }
+            registerWith(instruments_[i]);
+        }
+    }
+
+    Size PortfolioValuation::groups() const {
+        calculate();
+        return groups_.size();
+    }
+
+    const std::vector<Real>& PortfolioValuation::NPVs() const {
+        calculate();
+        return NPVs_;
+    }
+
+    const std::vector<std::map<std::string, boost::any> >&
+    PortfolioValuation::additionalResults() const {
+        calculate();
+        return additionalResults_;
+    }
+
+    Real PortfolioValuation::aggregateNPV(
+                                 const std::vector<Real>& quantities) const {
+        calculate();
+        Size n = NPVs_.size();
+        Real npv = 0.0;
+        if (quantities.empty() ||
+            (quantities.size()==1 && quantities[0]==1.0)) {
+            for (Size k=0; k<n; ++k)
+                npv += NPVs_[k];
+        } else {
+            QL_REQUIRE(quantities.size()==n,
+                       "dimension mismatch between instruments (" << n <<
+                       ") and quantities (" << quantities.size() << ")");
+            for (Size k=0; k<n; ++k)
+                npv += quantities[k] * NPVs_[k];
+        }
+        return npv;
+    }
+
+    void PortfolioValuation::performCalculations() const {
+        Size n = instruments_.size();
+
+        // instruments sharing an engine can't be priced concurrently
+        std::vector<std::vector<Size> > byEngine;
+        std::vector<Size> serial;
+        std::map<const PricingEngine*, Size> engineIndex;
+        for (Size i=0; i<n; ++i) {
+            const PricingEngine* engine =
+                instruments_[i]->pricingEngine().get();
+            if (engine == nullptr) {
+                serial.push_back(i);
+            } else {
+                auto g = engineIndex.insert(
+                               std::make_pair(engine, byEngine.size()));
+                if (g.second)
+                    byEngine.emplace_back();
+                byEngine[g.first->second].push_back(i);
+            }
+        }
+
+        // neither can instruments sharing a coupon pricer, so the
+        // corresponding groups are merged
+        std::vector<Size> parent(byEngine.size());
+        std::iota(parent.begin(), parent.end(), Size(0));
+        auto root = [&parent](Size g) {
+            while (parent[g] != g)
+                g = parent[g] = parent[parent[g]];
+            return g;
+        };
+        std::map<const FloatingRateCouponPricer*, Size> pricerGroup;
+        for (Size g=0; g<byEngine.size(); ++g) {
+            for (auto i : byEngine[g]) {
+                for (auto pricer : couponPricers(*instruments_[i])) {
+                    auto p = pricerGroup.insert(std::make_pair(pricer, g));
+                    if (!p.second)
+                        parent[root(g)] = root(p.first->second);
+                }
+            }
+        }
+
+        groups_.clear();
+        std::map<Size, Size> groupIndex;
+        for (Size g=0; g<byEngine.size(); ++g) {
+            auto k = groupIndex.insert(
+                               std::make_pair(root(g), groups_.size()));
+            if (k.second)
+                groups_.emplace_back();
+            // the first instrument is priced serially below
+            groups_[k.first->second].insert(groups_[k.first->second].end(),
+                                            byEngine[g].begin() + 1,
+                                            byEngine[g].end());
+        }
+
+        NPVs_.assign(n, Null<Real>());
+        additionalResults_.assign(n, std::map<std::string, boost::any>());
+        std::vector<std::string> errors(n);
+
+        auto price = [&](Size i) {
+            try {
+                NPVs_[i] = instruments_[i]->NPV();
+                additionalResults_[i] = instruments_[i]->additionalResults();
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        };
+
+        // shared state is calculated here, once for all groups
+        for (auto i : serial)
+            price(i);
+        for (const auto& group : byEngine)
+            price(group.front());
+
+        // pricing might register observers lazily (e.g., overnight
+        // coupons with the fixings of their index), which is only safe
+        // with the thread-safe observer pattern; with sessions, other
+        // threads would see different settings
+        const auto groups = static_cast<long>(groups_.size());
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+            !defined(QL_ENABLE_SESSIONS) && !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        #pragma omp parallel for schedule(dynamic)
+        #endif
+        for (long g=0; g<groups; ++g) {
+            for (auto i : groups_[g])
+                price(i);
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "could not price instrument #" << i << ": "
+                       << errors[i]);
+    }
+
+}
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliovaluation.hpp
+    \brief batch valuation of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_valuation_hpp
+#define quantlib_portfolio_valuation_hpp
+
+#include <ql/functional.hpp>
+#include <ql/instrument.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Batch valuation of a portfolio of instruments
+    /*! Instruments are grouped by pricing engine, since an engine
+        can only price one instrument at a time.  Groups containing
+        instruments whose coupons share a pricer are merged, since
+        coupon pricers store the coupon being priced (e.g., in
+        BlackIborCouponPricer::initialize); the coupons of swaps
+        and bonds are inspected for this purpose.  The first
+        instrument priced by each engine is priced first, serially;
+        this calculates once and for all the term structures and
+        other lazy objects shared by the portfolio.  The remaining
+        instruments are then priced, each group sequentially and
+        different groups in parallel when the library is compiled
+        with OpenMP support and the thread-safe observer pattern;
+        otherwise, they are priced serially.  Instruments without a
+        pricing engine (e.g., composite instruments) are priced
+        serially as well.
+
+        Therefore, instruments sharing an engine are never priced
+        in parallel; a portfolio using a single engine is priced
+        serially unless an engine factory is passed, in which case
+        each engine prices at most the given number of instruments
+        and the others are assigned new engines built by the
+        factory from the original one.
+
+        Results are cached until any of the instruments changes.
+
+        \warning Market objects shared among groups must not be
+                 modified during the valuation; objects used only by
+                 some instruments of a group are calculated while
+                 other groups are priced, and are assumed not to be
+                 shared with them.  Shared state other than engines
+                 and coupon pricers (e.g., pricers used internally by
+                 engines) is not detected and must be made distinct
+                 by the user.  When sessions are enabled each thread
+                 would have its own settings and fixings; in that
+                 case, groups are priced serially.
+    */
+    class PortfolioValuation : public LazyObject {
+      public:
+        typedef ext::function<ext::shared_ptr<PricingEngine>(
+                     const ext::shared_ptr<PricingEngine>&)> EngineFactory;
+
+        explicit PortfolioValuation(
+            std::vector<ext::shared_ptr<Instrument> > instruments);
+        /*! \warning The engines of the passed instruments are
+                     replaced so that no engine prices more than
+                     \c maxInstrumentsPerEngine of them.
+        */
+        PortfolioValuation(
+            std::vector<ext::shared_ptr<Instrument> > instruments,
+            Size maxInstrumentsPerEngine,
+            const EngineFactory& engineFactory);
+        //! \name Inspectors
+        //@{
+        const std::vector<ext::shared_ptr<Instrument> >& instruments() const {
+            return instruments_;
+        }
+        //! number of groups of instruments priced concurrently
+        Size groups() const;
+        //@}
+        //! \name Results
+        //@{
+        const std::vector<Real>& NPVs() const;
+        const std::vector<std::map<std::string, boost::any> >&
+        additionalResults() const;
+        /*! weighted sum of the NPVs; an empty quantity vector is
+            considered as a unit vector.
+        */
+        Real aggregateNPV(const std::vector<Real>& quantities =
+                                                std::vector<Real>()) const;
+        //@}
+      protected:
+        void performCalculations() const override;
+      private:
+        std::vector<ext::shared_ptr<Instrument> > instruments_;
+        mutable std::vector<std::vector<Size> > groups_;
+        mutable std::vector<Real> NPVs_;
+        mutable std::vector<std::map<std::string, boost::any> >
+            additionalResults_;
+    };
+
+}
+
+#endif
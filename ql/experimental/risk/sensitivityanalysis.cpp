@@ -17,6 +17,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/experimental/risk/portfoliovaluation.hpp>
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
@@ -39,7 +40,11 @@ namespace QuantLib {
     }
 
     Real aggregateNPV(const vector<ext::shared_ptr<Instrument> >& instruments,
-                      const vector<Real>& quant) {
+                      const vector<Real>& quant,
+                      bool batched) {
+        if (batched)
+            return PortfolioValuation(instruments).aggregateNPV(quant);
+
         Size n = instruments.size();
         Real npv = 0.0;
         if (quant.empty() || (quant.size()==1 && quant[0]==1.0)) {
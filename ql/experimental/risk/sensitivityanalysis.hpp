@@ -48,8 +48,13 @@ namespace QuantLib {
                              SensitivityAnalysis);
 
     //! utility fuction for weighted sum of NPVs
+    /*! If batched, the instruments are priced through a
+        PortfolioValuation, i.e., grouped by pricing engine and with
+        groups priced in parallel; see the related requirements.
+    */
     Real aggregateNPV(const std::vector<ext::shared_ptr<Instrument> >&,
-                      const std::vector<Real>& quantities);
+                      const std::vector<Real>& quantities,
+                      bool batched = false);
 
     //! parallel shift PV01 sensitivity analysis for a SimpleQuote vector
     /*! returns a pair of first and second derivative values calculated as
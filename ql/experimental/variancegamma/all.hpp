@@ -2,6 +2,7 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/experimental/variancegamma/analyticvariancegammaengine.hpp>
+#include <ql/experimental/variancegamma/cosvariancegammaengine.hpp>
 #include <ql/experimental/variancegamma/fftengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/experimental/variancegamma/fftvariancegammaengine.hpp>
@@ -0,0 +1,47 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/cosvariancegammaengine.hpp>
+
+namespace QuantLib {
+
+    COSVarianceGammaEngine::COSVarianceGammaEngine(
+        const ext::shared_ptr<VarianceGammaProcess>& process, Real L, Size N)
+    : COSSurfaceEngine(process->riskFreeRate(), process->dividendYield(), L, N),
+      process_(process) {
+        registerWith(process_);
+    }
+
+    std::complex<Real> COSVarianceGammaEngine::chF(Real u, Time t) const {
+        const Real sigma = process_->sigma();
+        const Real nu = process_->nu();
+        const Real theta = process_->theta();
+
+        const Real omega =
+            std::log(1.0 - theta*nu - sigma*sigma*nu/2.0) / nu;
+
+        return std::exp(std::complex<Real>(0.0, u*omega*t))
+            * std::pow(std::complex<Real>(1.0 + sigma*sigma*nu*u*u/2.0,
+                                          -theta*nu*u),
+                       -t/nu);
+    }
+
+    Real COSVarianceGammaEngine::underlying() const {
+        return process_->x0();
+    }
+
+}
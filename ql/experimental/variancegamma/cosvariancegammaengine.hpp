@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cosvariancegammaengine.hpp
+    \brief Fourier-cosine engine for vanilla options under a Variance Gamma process
+*/
+
+#ifndef quantlib_cos_variancegamma_engine_hpp
+#define quantlib_cos_variancegamma_engine_hpp
+
+#include <ql/experimental/variancegamma/variancegammaprocess.hpp>
+#include <ql/pricingengines/vanilla/cossurfaceengine.hpp>
+
+namespace QuantLib {
+
+    //! Fourier-cosine engine for vanilla options under a Variance Gamma process
+    /*! Unlike FFTVarianceGammaEngine, no precalculation is needed;
+        the series coefficients are cached for each maturity as
+        options are priced.  The density of a Variance Gamma process
+        has a cusp for short maturities, so that more terms might be
+        needed than for diffusion models.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic approach.
+    */
+    class COSVarianceGammaEngine : public COSSurfaceEngine {
+      public:
+        explicit COSVarianceGammaEngine(
+            const ext::shared_ptr<VarianceGammaProcess>& process,
+            Real L = 16, Size N = 400);
+
+        std::complex<Real> chF(Real u, Time t) const override;
+
+      protected:
+        Real underlying() const override;
+
+      private:
+        const ext::shared_ptr<VarianceGammaProcess> process_;
+    };
+
+}
+
+#endif
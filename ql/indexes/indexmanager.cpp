@@ -26,26 +26,84 @@
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #    pragma GCC diagnostic pop
 #endif
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <istream>
+#include <ostream>
 
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        const char fixingsTag[8] = { 'Q', 'L', 'F', 'I', 'X', 'I', 'N', 'G' };
+        const boost::uint32_t fixingsVersion = 1;
+        // written as is; it reads differently on platforms with
+        // different byte order
+        const boost::uint32_t byteOrderMark = 0x01020304;
+
+        template <class T>
+        void write(std::ostream& out, const T* data, std::size_t n) {
+            out.write(reinterpret_cast<const char*>(data),
+                      std::streamsize(n * sizeof(T)));
+        }
+
+        template <class T>
+        void read(std::istream& in, T* data, std::size_t n) {
+            in.read(reinterpret_cast<char*>(data),
+                    std::streamsize(n * sizeof(T)));
+            QL_REQUIRE(in, "unexpected end of fixing data");
+        }
+
+        // the size comes from the stream, so it's not trusted: the
+        // data are read in chunks and corrupted or truncated input
+        // fails at its end instead of causing a huge allocation
+        template <class T>
+        void read(std::istream& in, std::vector<T>& data,
+                  boost::uint64_t size) {
+            const boost::uint64_t chunk = 65536;
+            data.clear();
+            while (data.size() < size) {
+                const std::size_t offset = data.size();
+                const std::size_t n =
+                    std::size_t(std::min(chunk, size - offset));
+                data.resize(offset + n);
+                read(in, &data[offset], n);
+            }
+        }
+
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
         return data_.find(to_upper_copy(name)) != data_.end();
     }
 
     const TimeSeries<Real>& IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        // no entry is added, so that concurrent lookups are safe
+        static const TimeSeries<Real> empty;
+        auto i = data_.find(to_upper_copy(name));
+        return i != data_.end() ? i->second : empty;
     }
 
     void IndexManager::setHistory(const string& name, const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        string upperName = to_upper_copy(name);
+        data_[upperName] = history;
+        notifyObservers(upperName);
     }
 
     ext::shared_ptr<Observable> IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        ext::shared_ptr<Observable>& notifier = notifiers_[to_upper_copy(name)];
+        if (!notifier)
+            notifier = ext::make_shared<Observable>();
+        return notifier;
+    }
+
+    void IndexManager::notifyObservers(const string& upperName) const {
+        auto i = notifiers_.find(upperName);
+        if (i != notifiers_.end())
+            i->second->notifyObservers();
     }
 
     std::vector<string> IndexManager::histories() const {
@@ -56,14 +114,96 @@ namespace QuantLib {
         return temp;
     }
 
-    void IndexManager::clearHistory(const string& name) { data_.erase(to_upper_copy(name)); }
+    void IndexManager::clearHistory(const string& name) {
+        string upperName = to_upper_copy(name);
+        if (data_.erase(upperName) != 0U)
+            notifyObservers(upperName);
+    }
 
-    void IndexManager::clearHistories() { data_.clear(); }
+    void IndexManager::clearHistories() {
+        history_map cleared;
+        cleared.swap(data_);
+        for (const auto& i : cleared)
+            notifyObservers(i.first);
+    }
 
     bool IndexManager::hasHistoricalFixing(const std::string& name, const Date& fixingDate) const {
         auto const& indexIter = data_.find(to_upper_copy(name));
         return (indexIter != data_.end()) &&
-               ((*indexIter).second.value()[fixingDate] != Null<Real>());
+               ((*indexIter).second[fixingDate] != Null<Real>());
+    }
+
+    void IndexManager::saveHistories(std::ostream& out) const {
+        write(out, fixingsTag, sizeof(fixingsTag));
+        write(out, &fixingsVersion, 1);
+        write(out, &byteOrderMark, 1);
+        boost::uint64_t n = data_.size();
+        write(out, &n, 1);
+
+        std::vector<boost::int32_t> dates;
+        std::vector<double> values;
+        for (const auto& i : data_) {
+            const string& name = i.first;
+            n = name.size();
+            write(out, &n, 1);
+            write(out, name.data(), name.size());
+
+            const TimeSeries<Real>& history = i.second;
+            dates.clear();
+            values.clear();
+            for (const auto& fixing : history) {
+                dates.push_back(boost::int32_t(fixing.first.serialNumber()));
+                values.push_back(fixing.second);
+            }
+            n = dates.size();
+            write(out, &n, 1);
+            write(out, dates.data(), dates.size());
+            write(out, values.data(), values.size());
+        }
+        QL_REQUIRE(out, "error while writing fixing data");
+    }
+
+    void IndexManager::loadHistories(std::istream& in) {
+        char tag[sizeof(fixingsTag)];
+        read(in, tag, sizeof(tag));
+        QL_REQUIRE(std::equal(tag, tag + sizeof(tag), fixingsTag),
+                   "fixing data not in the expected format");
+        boost::uint32_t version, mark;
+        read(in, &version, 1);
+        QL_REQUIRE(version == fixingsVersion,
+                   "unsupported version (" << version << ") of fixing data");
+        read(in, &mark, 1);
+        QL_REQUIRE(mark == byteOrderMark,
+                   "fixing data written on a platform with different byte order");
+        boost::uint64_t n;
+        read(in, &n, 1);
+
+        // read everything before storing anything, so that a
+        // corrupted file leaves the stored fixings alone
+        std::vector<std::pair<string, TimeSeries<Real> > > histories;
+        std::vector<char> name;
+        std::vector<boost::int32_t> serials;
+        std::vector<double> values;
+        std::vector<Date> dates;
+        for (boost::uint64_t i = 0; i < n; ++i) {
+            boost::uint64_t size;
+            read(in, &size, 1);
+            read(in, name, size);
+
+            read(in, &size, 1);
+            read(in, serials, size);
+            read(in, values, size);
+            dates.clear();
+            dates.reserve(serials.size());
+            for (boost::int32_t serial : serials)
+                dates.emplace_back(Date::serial_type(serial));
+            histories.emplace_back(
+                string(name.begin(), name.end()),
+                TimeSeries<Real>(dates.begin(), dates.end(), values.begin()));
+        }
+
+        for (const auto& h : histories)
+            setHistory(h.first, h.second);
     }
 
 }
@@ -25,8 +25,10 @@
 #define quantlib_index_manager_hpp
 
 #include <ql/patterns/singleton.hpp>
+#include <ql/patterns/observable.hpp>
 #include <ql/timeseries.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#include <iosfwd>
+#include <map>
 
 
 namespace QuantLib {
@@ -57,9 +59,30 @@ namespace QuantLib {
         //! returns whether a specific historical fixing was stored for the index and date
         bool hasHistoricalFixing(const std::string& name, const Date& fixingDate) const;
 
+        /*! writes all stored fixings to the given stream in a binary
+            format, meant to be read back by loadHistories() on the
+            same platform.  For each index, dates and values are
+            written as two contiguous columns, so that reading them
+            back doesn't require parsing or sorting.
+
+            \warning the stream must be opened in binary mode.
+        */
+        void saveHistories(std::ostream&) const;
+        /*! reads fixings written by saveHistories() from the given
+            stream and stores them, replacing the histories of the
+            same indexes if any; other histories are left untouched.
+
+            \warning the stream must be opened in binary mode.
+        */
+        void loadHistories(std::istream&);
+
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > > history_map;
-        mutable history_map data_;
+        void notifyObservers(const std::string& name) const;
+        typedef std::map<std::string, TimeSeries<Real> > history_map;
+        history_map data_;
+        // kept apart from the histories, so that indexes stay
+        // registered with them when their fixings are cleared
+        mutable std::map<std::string, ext::shared_ptr<Observable> > notifiers_;
     };
 
 }
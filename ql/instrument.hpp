@@ -62,6 +62,8 @@ namespace QuantLib {
 
         //! returns whether the instrument might have value greater than zero.
         virtual bool isExpired() const = 0;
+        //! returns the pricing engine set for the instrument, if any.
+        const ext::shared_ptr<PricingEngine>& pricingEngine() const;
         //@}
         //! \name Modifiers
         //@{
@@ -141,6 +143,11 @@ namespace QuantLib {
         update();
     }
 
+    inline const ext::shared_ptr<PricingEngine>&
+    Instrument::pricingEngine() const {
+        return engine_;
+    }
+
     inline void Instrument::setupArguments(PricingEngine::arguments*) const {
         QL_FAIL("Instrument::setupArguments() not implemented");
     }
@@ -256,4 +256,53 @@ namespace QuantLib {
         return BVN;
     }
 
+    void BivariateCumulativeNormalDistributionWe04DP::operator()(
+                                    const Real* aBegin, const Real* aEnd,
+                                    const Real* bBegin, Real* out) const {
+        const Size n = aEnd - aBegin;
+
+        if (std::fabs(correlation_) >= 0.925) {
+            for (Size i=0; i<n; ++i)
+                out[i] = (*this)(aBegin[i], bBegin[i]);
+            return;
+        }
+
+        for (Size i=0; i<n; ++i)
+            out[i] = 0.0;
+
+        if (std::fabs(correlation_) > 0) {
+            TabulatedGaussLegendre gaussLegendreQuad(20);
+            if (std::fabs(correlation_) < 0.3) {
+                gaussLegendreQuad.order(6);
+            } else if (std::fabs(correlation_) < 0.75) {
+                gaussLegendreQuad.order(12);
+            }
+            const Array nodes = gaussLegendreQuad.x();
+            const Array weights = gaussLegendreQuad.weights();
+
+            // same integrand as eqn3, with the sines computed once
+            const Real asr = std::asin(correlation_);
+            std::vector<Real> hk(n), hs(n);
+            for (Size i=0; i<n; ++i) {
+                hk[i] = aBegin[i] * bBegin[i];
+                hs[i] = (aBegin[i] * aBegin[i] + bBegin[i] * bBegin[i]) / 2;
+            }
+            for (Size j=0; j<nodes.size(); ++j) {
+                const Real sn = std::sin(asr * (-nodes[j] + 1) * 0.5);
+                const Real den = 1.0 - sn * sn;
+                const Real w = weights[j];
+                for (Size i=0; i<n; ++i)
+                    out[i] += w*std::exp((sn * hk[i] - hs[i]) / den);
+            }
+            for (Size i=0; i<n; ++i)
+                out[i] *= asr * (0.25 / M_PI);
+        }
+
+        std::vector<Real> na(n), nb(n);
+        cumnorm_(aBegin, aEnd, na.data());
+        cumnorm_(bBegin, bBegin+n, nb.data());
+        for (Size i=0; i<n; ++i)
+            out[i] += na[i] * nb[i];
+    }
+
 }
@@ -94,6 +94,16 @@ namespace QuantLib {
         BivariateCumulativeNormalDistributionWe04DP(Real rho);
         // function
         Real operator()(Real a, Real b) const;
+        /*! Evaluates the function at the points (a[i], b[i]) for a[i]
+            in [aBegin, aEnd) and writes the results to out, which must
+            not overlap the inputs.  For |rho| < 0.925 the quadrature
+            nodes are mapped once for the whole batch and the
+            integrand is accumulated over all points node by node;
+            otherwise, each point is evaluated by operator().  The
+            results are the same as those of operator().
+        */
+        void operator()(const Real* aBegin, const Real* aEnd,
+                        const Real* bBegin, Real* out) const;
       private:
         Real correlation_;
         CumulativeNormalDistribution cumnorm_;
@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -42,27 +43,52 @@ namespace QuantLib {
         z = (z - average_) / sigma_;
 
         Real result = 0.5 * ( 1.0 + errorFunction_( z*M_SQRT_2 ) );
-        if (result<=1e-8) { //todo: investigate the threshold level
-            // Asymptotic expansion for very negative z following (26.2.12)
-            // on page 408 in M. Abramowitz and A. Stegun,
-            // Pocketbook of Mathematical Functions, ISBN 3-87144818-4.
-            Real sum=1.0, zsqr=z*z, i=1.0, g=1.0, x, y,
-                 a=QL_MAX_REAL, lasta;
-            do {
-                lasta=a;
-                x = (4.0*i-3.0)/zsqr;
-                y = x*((4.0*i-1)/zsqr);
-                a = g*(x-y);
-                sum -= a;
-                g *= y;
-                ++i;
-                a = std::fabs(a);
-            } while (lasta>a && a>=std::fabs(sum*QL_EPSILON));
-            result = -gaussian_(z)/z*sum;
-        }
+        if (result<=1e-8) //todo: investigate the threshold level
+            result = asymptoticValue(z);
         return result;
     }
 
+    void CumulativeNormalDistribution::operator()(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) const {
+        // blocks small enough to keep the intermediate values in cache
+        const Size blockSize = 256;
+        Real z[blockSize], x[blockSize];
+        for (; begin < end; begin += blockSize, out += blockSize) {
+            const Size n = std::min<Size>(end - begin, blockSize);
+            for (Size i=0; i<n; ++i) {
+                z[i] = (begin[i] - average_) / sigma_;
+                x[i] = z[i]*M_SQRT_2;
+            }
+            errorFunction_(x, x+n, out);
+            for (Size i=0; i<n; ++i)
+                out[i] = 0.5 * ( 1.0 + out[i] );
+            for (Size i=0; i<n; ++i) {
+                if (out[i]<=1e-8)
+                    out[i] = asymptoticValue(z[i]);
+            }
+        }
+    }
+
+    Real CumulativeNormalDistribution::asymptoticValue(Real z) const {
+        // Asymptotic expansion for very negative z following (26.2.12)
+        // on page 408 in M. Abramowitz and A. Stegun,
+        // Pocketbook of Mathematical Functions, ISBN 3-87144818-4.
+        Real sum=1.0, zsqr=z*z, i=1.0, g=1.0, x, y,
+             a=QL_MAX_REAL, lasta;
+        do {
+            lasta=a;
+            x = (4.0*i-3.0)/zsqr;
+            y = x*((4.0*i-1)/zsqr);
+            a = g*(x-y);
+            sum -= a;
+            g *= y;
+            ++i;
+            a = std::fabs(a);
+        } while (lasta>a && a>=std::fabs(sum*QL_EPSILON));
+        return -gaussian_(z)/z*sum;
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -126,6 +152,30 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        const Size n = end - begin;
+        for (Size i=0; i<n; ++i) {
+            const Real z = begin[i] - 0.5;
+            const Real r = z*z;
+            out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+        }
+        for (Size i=0; i<n; ++i) {
+            if (begin[i] < x_low_ || x_high_ < begin[i])
+                out[i] = tail_value(begin[i]);
+        }
+
+        #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (Size i=0; i<n; ++i) {
+            const Real z = out[i];
+            const Real r = (f_(z) - begin[i]) * M_SQRT2 * M_SQRTPI * exp(0.5 * z*z);
+            out[i] = z - r/(1+0.5*z*r);
+        }
+        #endif
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -78,7 +78,16 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        /*! Evaluates the function on the range [begin, end) and
+            writes the results to out, which must not overlap the
+            input.  The error function is evaluated in batch (see
+            ErrorFunction) and the asymptotic expansion is only used
+            for the points that need it.  The results are the same
+            as those of operator().
+        */
+        void operator()(const Real* begin, const Real* end, Real* out) const;
       private:
+        Real asymptoticValue(Real z) const;
         Real average_, sigma_;
         NormalDistribution gaussian_;
         ErrorFunction errorFunction_;
@@ -114,6 +123,16 @@ namespace QuantLib {
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        /*! Evaluates the function on the range [begin, end) and
+            writes the results to out, which must not overlap the
+            input.  The results are the same as those of operator().
+        */
+        void operator()(const Real* begin, const Real* end, Real* out) const {
+            standard_values(begin, end, out);
+            const Size n = end - begin;
+            for (Size i=0; i<n; ++i)
+                out[i] = average_ + sigma_*out[i];
+        }
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -143,6 +162,13 @@ namespace QuantLib {
 
             return z;
         }
+        /*! batch version of standard_value.  The central rational
+            approximation is evaluated for all points in a loop
+            without branches; the tails are then computed for the
+            points that need them.
+        */
+        static void standard_values(const Real* begin, const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
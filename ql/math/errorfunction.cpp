@@ -25,6 +25,7 @@
 
 
 #include <ql/math/errorfunction.hpp>
+#include <algorithm>
 #include <cfloat>
 
 namespace QuantLib {
@@ -243,4 +244,68 @@ namespace QuantLib {
 
     }
 
+    void ErrorFunction::operator()(const Real* begin, const Real* end,
+                                   Real* out) const {
+        // blocks small enough to keep the intermediate values in cache
+        const Size blockSize = 256;
+        Size index[blockSize];
+        Real v[blockSize], e[blockSize];
+
+        for (; begin < end; begin += blockSize, out += blockSize) {
+            const Size n = std::min<Size>(end - begin, blockSize);
+
+            for (Size i=0; i<n; ++i) {
+                const Real x = begin[i], ax = std::fabs(x);
+                /* |x|<0.84375 */
+                const Real z = x*x;
+                const Real r = pp0+z*(pp1+z*(pp2+z*(pp3+z*pp4)));
+                const Real s = one+z*(qq1+z*(qq2+z*(qq3+z*(qq4+z*qq5))));
+                const Real inner = x + x*(r/s);
+                /* 0.84375 <= |x| < 1.25 */
+                const Real t = ax-one;
+                const Real P = pa0+t*(pa1+t*(pa2+t*(pa3+t*(pa4+t*(pa5+t*pa6)))));
+                const Real Q = one+t*(qa1+t*(qa2+t*(qa3+t*(qa4+t*(qa5+t*qa6)))));
+                const Real outer = erx + P/Q;
+                out[i] = ax < 0.84375 ? inner : (x >= 0 ? outer : -outer);
+            }
+
+            // the remaining points are packed together...
+            Size m = 0;
+            for (Size i=0; i<n; ++i) {
+                const Real ax = std::fabs(begin[i]);
+                // also true for non-finite values
+                if (!(ax >= 3.7252902984e-09 && ax < 1.25)) {
+                    index[m] = i;
+                    v[m++] = begin[i];
+                }
+            }
+
+            // ...the exponents for 1.25 <= |x| < 6 are computed for
+            // all of them...
+            for (Size k=0; k<m; ++k) {
+                const Real ax = std::fabs(v[k]);
+                const Real s = one/(ax*ax);
+                /* |x| < 1/0.35 */
+                const Real Ra = ra0+s*(ra1+s*(ra2+s*(ra3+s*(ra4+s*(ra5+s*(ra6+s*ra7))))));
+                const Real Sa = one+s*(sa1+s*(sa2+s*(sa3+s*(sa4+s*(sa5+s*(sa6+s*(sa7+s*sa8)))))));
+                /* |x| >= 1/0.35 */
+                const Real Rb = rb0+s*(rb1+s*(rb2+s*(rb3+s*(rb4+s*(rb5+s*rb6)))));
+                const Real Sb = one+s*(sb1+s*(sb2+s*(sb3+s*(sb4+s*(sb5+s*(sb6+s*sb7))))));
+                const Real RS = ax < 2.85714285714285 ? Ra/Sa : Rb/Sb;
+                e[k] = -ax*ax-0.5625 +RS;
+            }
+
+            // ...and the results are completed one by one
+            for (Size k=0; k<m; ++k) {
+                const Real x = v[k], ax = std::fabs(x);
+                if (ax >= 1.25 && ax < 6) {
+                    const Real r = std::exp(e[k]);
+                    out[index[k]] = x >= 0 ? one-r/ax : r/ax-one;
+                } else {
+                    out[index[k]] = (*this)(x);
+                }
+            }
+        }
+    }
+
 }
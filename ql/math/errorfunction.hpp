@@ -41,6 +41,14 @@ namespace QuantLib {
         ErrorFunction() = default;
         // function
         Real operator()(Real x) const;
+        /*! Evaluates the function on the range [begin, end) and
+            writes the results to out, which must not overlap the
+            input.  The rational approximations used for |x| < 1.25
+            are evaluated for all points in a loop without branches;
+            the remaining points are computed by operator().  The
+            results are the same as those of operator().
+        */
+        void operator()(const Real* begin, const Real* end, Real* out) const;
       private:
         static const Real tiny, one, erx, efx, efx8;
         static const Real pp0, pp1,pp2,pp3,pp4;
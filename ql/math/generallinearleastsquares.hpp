@@ -32,6 +32,7 @@
 #include <ql/math/array.hpp>
 #include <ql/math/functional.hpp>
 #include <boost/type_traits.hpp>
+#include <iterator>
 #include <vector>
 
 namespace QuantLib {
@@ -41,6 +42,12 @@ namespace QuantLib {
     "Numerical Recipes in C", 2nd edition,
     Press, Teukolsky, Vetterling, Flannery,
 
+    If more than one thread is requested and the samples are given
+    by random-access iterators, the rows of the design matrix are
+    evaluated in parallel when OpenMP is enabled; the functions must
+    then be safe to call concurrently.  By default, the evaluation is
+    serial.
+
     \test the correctness of the returned values is tested by
     checking their properties.
     */
@@ -48,12 +55,14 @@ namespace QuantLib {
     public:
         template <class xContainer, class yContainer, class vContainer>
         GeneralLinearLeastSquares(const xContainer & x,
-                                  const yContainer & y, const vContainer & v);
+                                  const yContainer & y, const vContainer & v,
+                                  Size threads = 1);
 
         template<class xIterator, class yIterator, class vIterator>
         GeneralLinearLeastSquares(xIterator xBegin, xIterator xEnd,
                                   yIterator yBegin, yIterator yEnd,
-                                  vIterator vBegin, vIterator vEnd);
+                                  vIterator vBegin, vIterator vEnd,
+                                  Size threads = 1);
 
         const Array& coefficients()   const { return a_; }
         const Array& residuals()      const { return residuals_; }
@@ -74,37 +83,50 @@ namespace QuantLib {
         void calculate(
             xIterator xBegin, xIterator xEnd,
             yIterator yBegin, yIterator yEnd,
-            vIterator vBegin);
+            vIterator vBegin, Size threads = 1);
+
+        template <class xIterator, class vIterator>
+        static void fillDesignMatrix(Matrix& A,
+                                     xIterator xBegin, xIterator xEnd,
+                                     vIterator vBegin, Size threads,
+                                     std::input_iterator_tag);
+        template <class xIterator, class vIterator>
+        static void fillDesignMatrix(Matrix& A,
+                                     xIterator xBegin, xIterator xEnd,
+                                     vIterator vBegin, Size threads,
+                                     std::random_access_iterator_tag);
     };
 
     template <class xContainer, class yContainer, class vContainer> inline
     GeneralLinearLeastSquares::GeneralLinearLeastSquares(const xContainer & x,
                                                          const yContainer & y,
-                                                         const vContainer & v)
+                                                         const vContainer & v,
+                                                         Size threads)
     : a_(v.size(), 0.0),
       err_(v.size(), 0.0),
       residuals_(y.size()),
       standardErrors_(v.size()) {
-        calculate(x.begin(), x.end(), y.begin(), y.end(), v.begin());
+        calculate(x.begin(), x.end(), y.begin(), y.end(), v.begin(), threads);
     }
 
     template<class xIterator, class yIterator, class vIterator> inline
     GeneralLinearLeastSquares::GeneralLinearLeastSquares(
                                             xIterator xBegin, xIterator xEnd,
                                             yIterator yBegin, yIterator yEnd,
-                                            vIterator vBegin, vIterator vEnd)
+                                            vIterator vBegin, vIterator vEnd,
+                                            Size threads)
     : a_(std::distance(vBegin, vEnd), 0.0),
       err_(a_.size(), 0.0),
       residuals_(std::distance(yBegin, yEnd)),
       standardErrors_(a_.size()) {
-        calculate(xBegin, xEnd, yBegin, yEnd, vBegin);
+        calculate(xBegin, xEnd, yBegin, yEnd, vBegin, threads);
     }
 
 
     template <class xIterator, class yIterator, class vIterator>
     void GeneralLinearLeastSquares::calculate(xIterator xBegin, xIterator xEnd,
                                               yIterator yBegin, yIterator yEnd,
-                                              vIterator vBegin) {
+                                              vIterator vBegin, Size threads) {
 
         const Size n = residuals_.size();
         const Size m = err_.size();
@@ -116,8 +138,9 @@ namespace QuantLib {
         Size i;
 
         Matrix A(n, m);
-        for (i=0; i<m; ++i)
-            std::transform(xBegin, xEnd, A.column_begin(i), *vBegin++);
+        fillDesignMatrix(A, xBegin, xEnd, vBegin, threads,
+                         typename std::iterator_traits<
+                                      xIterator>::iterator_category());
 
         const SVD svd(A);
         const Matrix& V = svd.V();
@@ -149,6 +172,35 @@ namespace QuantLib {
                        multiply_by<Real>(std::sqrt(chiSq/(n-2))));
     }
 
+    template <class xIterator, class vIterator>
+    void GeneralLinearLeastSquares::fillDesignMatrix(
+                                        Matrix& A,
+                                        xIterator xBegin, xIterator xEnd,
+                                        vIterator vBegin, Size,
+                                        std::input_iterator_tag) {
+        for (Size i=0; i<A.columns(); ++i)
+            std::transform(xBegin, xEnd, A.column_begin(i), *vBegin++);
+    }
+
+    template <class xIterator, class vIterator>
+    void GeneralLinearLeastSquares::fillDesignMatrix(
+                                        Matrix& A,
+                                        xIterator xBegin, xIterator,
+                                        vIterator vBegin, Size threads,
+                                        std::random_access_iterator_tag) {
+        const Size m = A.columns();
+        std::vector<typename std::iterator_traits<vIterator>::value_type> v;
+        for (Size i=0; i<m; ++i)
+            v.push_back(*vBegin++);
+
+        #pragma omp parallel for num_threads(threads) \
+                                 if(threads > 1 && A.rows() > 1024)
+        for (long j=0; j<(long)A.rows(); ++j) {
+            for (Size i=0; i<m; ++i)
+                A[j][i] = v[i](xBegin[j]);
+        }
+    }
+
 }
 
 #endif
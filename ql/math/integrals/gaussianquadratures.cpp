@@ -77,6 +77,32 @@ namespace QuantLib {
         }
     }
 
+    Array TabulatedGaussLegendre::x() const {
+        const Size isOrderOdd = order_ & 1;
+        Array result(order_);
+        Size k = 0;
+        if (isOrderOdd)
+            result[k++] = x_[0];
+        for (Size i=isOrderOdd; i<n_; ++i) {
+            result[k++] =  x_[i];
+            result[k++] = -x_[i];
+        }
+        return result;
+    }
+
+    Array TabulatedGaussLegendre::weights() const {
+        const Size isOrderOdd = order_ & 1;
+        Array result(order_);
+        Size k = 0;
+        if (isOrderOdd)
+            result[k++] = w_[0];
+        for (Size i=isOrderOdd; i<n_; ++i) {
+            result[k++] = w_[i];
+            result[k++] = w_[i];
+        }
+        return result;
+    }
+
 
     // Abscissas and Weights from Abramowitz and Stegun
 
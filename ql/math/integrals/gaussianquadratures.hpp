@@ -240,6 +240,11 @@ namespace QuantLib {
         void order(Size);
         Size order() const { return order_; }
 
+        //! abscissas, in the order in which operator() evaluates f
+        Array x() const;
+        //! weights of the abscissas returned by x()
+        Array weights() const;
+
       private:
         Size order_;
 
@@ -25,6 +25,7 @@
 #ifndef quantlib_inversecumulative_rsg_h
 #define quantlib_inversecumulative_rsg_h
 
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <utility>
 #include <vector>
@@ -44,6 +45,11 @@ namespace QuantLib {
             USG::sample_type USG::nextSequence() const;
             Size USG::dimension() const;
         \endcode
+        If a client of this class wants to use the discard method,
+        class USG must also implement
+        \code
+            void USG::discard(BigNatural n);
+        \endcode
 
         The inverse cumulative distribution is supplied by IC.
 
@@ -53,6 +59,24 @@ namespace QuantLib {
             Real IC::operator() const;
         \endcode
     */
+    namespace detail {
+
+        template <class IC, class U>
+        inline void inverseCumulativeValues(const IC& ic, const U& u,
+                                            std::vector<Real>& x) {
+            for (Size i = 0; i < x.size(); i++)
+                x[i] = ic(u[i]);
+        }
+
+        // the inverse cumulative normal can transform the whole sample
+        inline void inverseCumulativeValues(const InverseCumulativeNormal& ic,
+                                            const std::vector<Real>& u,
+                                            std::vector<Real>& x) {
+            ic(u.data(), u.data() + x.size(), x.data());
+        }
+
+    }
+
     template <class USG, class IC>
     class InverseCumulativeRsg {
       public:
@@ -62,6 +86,8 @@ namespace QuantLib {
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
+        //! skips the next n samples
+        void discard(BigNatural n) { uniformSequenceGenerator_.discard(n); }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -86,9 +112,7 @@ namespace QuantLib {
         typename USG::sample_type sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::inverseCumulativeValues(ICD_, sample.value, x_.value);
         return x_;
     }
 
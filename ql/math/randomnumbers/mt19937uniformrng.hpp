@@ -26,6 +26,7 @@
 #define quantlib_mersennetwister_uniform_rng_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -70,6 +71,20 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! skip the next n random numbers
+        /*! The state is advanced one block of N words at a time
+            without tempering the skipped numbers; the cost is linear
+            in n, but much smaller than drawing the numbers.
+        */
+        void discard(BigNatural n) const {
+            while (n > 0) {
+                if (mti==N)
+                    twist();
+                Size k = std::min<BigNatural>(n, N-mti);
+                mti += k;
+                n -= k;
+            }
+        }
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
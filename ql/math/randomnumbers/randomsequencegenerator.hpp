@@ -25,6 +25,7 @@
 #define quantlib_random_sequence_generator_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/errors.hpp>
 #include <vector>
 
@@ -43,6 +44,9 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        Skipping sequences with discard() draws and throws away the
+        corresponding numbers, except for the Mersenne Twister which
+        can advance its state directly.
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -83,6 +87,11 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skip the next n sequences
+        void discard(BigNatural n) const {
+            for (BigNatural i=0; i<n*dimensionality_; i++)
+                rng_.next();
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
@@ -91,6 +100,14 @@ namespace QuantLib {
         mutable std::vector<BigNatural> int32Sequence_;
     };
 
+
+    // the Mersenne Twister can skip numbers without drawing them
+    template <>
+    inline void RandomSequenceGenerator<MersenneTwisterUniformRng>::discard(
+                                                        BigNatural n) const {
+        rng_.discard(n*dimensionality_);
+    }
+
 }
 
 
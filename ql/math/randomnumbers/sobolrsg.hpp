@@ -120,6 +120,14 @@ namespace QuantLib {
                           DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(boost::uint_least32_t n);
+        /*! skip the next n samples in the low-discrepancy sequence */
+        void discard(boost::uint_least32_t n) {
+            if (n == 0)
+                return;
+            // after the first draw, skipTo(m) leaves the generator
+            // at the (m+1)-th sample of the sequence
+            skipTo(firstDraw_ ? n : sequenceCounter_ + n);
+        }
         const std::vector<boost::uint_least32_t>& nextInt32Sequence() const;
 
         const SobolRsg::sample_type& nextSequence() const {
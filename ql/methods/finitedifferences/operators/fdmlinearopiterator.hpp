@@ -28,14 +28,87 @@
 
 #include <ql/types.hpp>
 #include <ql/utilities/disposable.hpp>
+#include <algorithm>
 #include <numeric>
 #include <utility>
 #include <vector>
 
 namespace QuantLib {
 
+    //! dimensions or coordinates of a point in an fdm layout
+    /*! Up to three dimensions are stored inline, which covers the
+        usual one- to three-dimensional problems without any heap
+        allocation; larger layouts fall back to a std::vector.
+    */
+    class FdmLinearOpCoordinates {
+      public:
+        typedef const Size* const_iterator;
+        typedef Size* iterator;
+        static const Size inlineCapacity = 3;
+
+        FdmLinearOpCoordinates()
+        : size_(0), inline_() {}
+
+        explicit FdmLinearOpCoordinates(Size n, Size value = 0)
+        : size_(n), inline_(),
+          heap_(n > inlineCapacity ? n : 0) {
+            std::fill(begin(), end(), value);
+        }
+
+        explicit FdmLinearOpCoordinates(const std::vector<Size>& v)
+        : size_(v.size()), inline_(),
+          heap_(v.size() > inlineCapacity ? v.size() : 0) {
+            std::copy(v.begin(), v.end(), begin());
+        }
+
+        //! \name inspectors
+        //@{
+        Size size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        Size operator[](Size i) const { return data()[i]; }
+        Size& operator[](Size i) { return data()[i]; }
+        Size back() const { return data()[size_-1]; }
+        //@}
+        //! \name iterators
+        //@{
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + size_; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + size_; }
+        //@}
+        //! \name conversion
+        //@{
+        //! for code expecting a std::vector; allocates
+        operator std::vector<Size>() const {
+            return std::vector<Size>(begin(), end());
+        }
+        //@}
+
+        void swap(FdmLinearOpCoordinates& from) {
+            std::swap(size_, from.size_);
+            std::swap_ranges(inline_, inline_ + inlineCapacity,
+                             from.inline_);
+            heap_.swap(from.heap_);
+        }
+
+      private:
+        const Size* data() const {
+            return size_ > inlineCapacity ? &heap_[0] : inline_;
+        }
+        Size* data() {
+            return size_ > inlineCapacity ? &heap_[0] : inline_;
+        }
+
+        Size size_;
+        Size inline_[inlineCapacity];
+        std::vector<Size> heap_;
+    };
+
+
     class FdmLinearOpIterator {
       public:
+        typedef FdmLinearOpCoordinates coordinates_type;
+
         explicit FdmLinearOpIterator(Size index = 0)
         : index_(index) {}
 
@@ -44,13 +117,28 @@ namespace QuantLib {
           dim_(dim),
           coordinates_(dim.size(), 0) {}
 
-        FdmLinearOpIterator(std::vector<Size> dim, std::vector<Size> coordinates, Size index)
-        : index_(index), dim_(std::move(dim)), coordinates_(std::move(coordinates)) {}
+        explicit FdmLinearOpIterator(const coordinates_type& dim)
+        : index_(0),
+          dim_(dim),
+          coordinates_(dim.size(), 0) {}
+
+        FdmLinearOpIterator(const std::vector<Size>& dim,
+                            const std::vector<Size>& coordinates,
+                            Size index)
+        : index_(index), dim_(dim), coordinates_(coordinates) {}
+
+        FdmLinearOpIterator(coordinates_type dim,
+                            coordinates_type coordinates,
+                            Size index)
+        : index_(index), dim_(std::move(dim)),
+          coordinates_(std::move(coordinates)) {}
 
+        #if defined(QL_USE_DISPOSABLE)
         FdmLinearOpIterator(
             const Disposable<FdmLinearOpIterator> & from) {
             swap(const_cast<Disposable<FdmLinearOpIterator> & >(from));
         }
+        #endif
 
         void operator++() {
             ++index_;
@@ -72,7 +160,7 @@ namespace QuantLib {
             return index_;
         }
 
-        const std::vector<Size> & coordinates() const {
+        const coordinates_type& coordinates() const {
             return coordinates_;
         }
 
@@ -84,8 +172,8 @@ namespace QuantLib {
 
       private:
         Size index_;
-        std::vector<Size> dim_;
-        std::vector<Size> coordinates_;
+        coordinates_type dim_;
+        coordinates_type coordinates_;
     };
 }
 
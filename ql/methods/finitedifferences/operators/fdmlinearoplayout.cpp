@@ -65,11 +65,11 @@ namespace QuantLib {
         return myIndex + coorOffset1*spacing_[i1]+coorOffset2*spacing_[i2];
     }
 
-    // smart but sometimes too slow
     Disposable<FdmLinearOpIterator> FdmLinearOpLayout::iter_neighbourhood(
         const FdmLinearOpIterator& iterator, Size i, Integer offset) const {
 
-        std::vector<Size> coordinates = iterator.coordinates();
+        FdmLinearOpIterator::coordinates_type coordinates
+            = iterator.coordinates();
 
         Integer coorOffset = Integer(coordinates[i])+offset;
         if (coorOffset < 0) {
@@ -80,7 +80,7 @@ namespace QuantLib {
         }
         coordinates[i] = Size(coorOffset);
 
-        FdmLinearOpIterator retVal(dim_, coordinates,
+        FdmLinearOpIterator retVal(iterDim_, coordinates,
                                    index(coordinates));
 
         return retVal;
@@ -34,7 +34,7 @@ namespace QuantLib {
     class FdmLinearOpLayout {
       public:
         explicit FdmLinearOpLayout(const std::vector<Size>& dim)
-        : dim_(dim), spacing_(dim.size()) {
+        : dim_(dim), spacing_(dim.size()), iterDim_(dim) {
             spacing_[0] = 1;
             std::partial_sum(dim.begin(), dim.end()-1,
                 spacing_.begin()+1, std::multiplies<Size>());
@@ -43,7 +43,7 @@ namespace QuantLib {
         }
 
         FdmLinearOpIterator begin() const {
-            return FdmLinearOpIterator(dim_);
+            return FdmLinearOpIterator(iterDim_);
         }
 
         FdmLinearOpIterator end() const {
@@ -68,6 +68,13 @@ namespace QuantLib {
                                       spacing_.begin(), Size(0));
         }
 
+        Size index(const FdmLinearOpIterator::coordinates_type& coordinates)
+        const {
+            return std::inner_product(coordinates.begin(),
+                                      coordinates.end(),
+                                      spacing_.begin(), Size(0));
+        }
+
         Size neighbourhood(const FdmLinearOpIterator& iterator,
                            Size i, Integer offset) const;
 
@@ -75,13 +82,15 @@ namespace QuantLib {
                            Size i1, Integer offset1,
                            Size i2, Integer offset2) const;
 
-        // smart but sometimes too slow
+        // copies the coordinates, which are stored inline
+        // for up to three dimensions
         Disposable<FdmLinearOpIterator> iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
       private:
         Size size_;
         std::vector<Size> dim_, spacing_;
+        FdmLinearOpIterator::coordinates_type iterDim_;
     };
 }
 
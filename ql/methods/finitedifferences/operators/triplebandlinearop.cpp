@@ -27,6 +27,17 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // stores x in y; returns whether y changed
+        inline bool update(Real& y, Real x) {
+            const bool changed = (y != x);
+            y = x;
+            return changed;
+        }
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
@@ -34,9 +45,9 @@ namespace QuantLib {
       i0_       (new Size[mesher->layout()->size()]),
       i2_       (new Size[mesher->layout()->size()]),
       reverseIndex_ (new Size[mesher->layout()->size()]),
-      lower_    (new Real[mesher->layout()->size()]),
-      diag_     (new Real[mesher->layout()->size()]),
-      upper_    (new Real[mesher->layout()->size()]),
+      lower_    (new Real[mesher->layout()->size()]()),
+      diag_     (new Real[mesher->layout()->size()]()),
+      upper_    (new Real[mesher->layout()->size()]()),
       mesher_(mesher) {
 
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
@@ -53,7 +64,8 @@ namespace QuantLib {
             i0_[i] = layout->neighbourhood(iter, direction, -1);
             i2_[i] = layout->neighbourhood(iter, direction,  1);
 
-            const std::vector<Size>& coordinates = iter.coordinates();
+            const FdmLinearOpIterator::coordinates_type& coordinates
+                = iter.coordinates();
             const Size newIndex =
                   std::inner_product(coordinates.begin(), coordinates.end(),
                                      newSpacing.begin(), Size(0));
@@ -101,6 +113,13 @@ namespace QuantLib {
         i0_.swap(m.i0_); i2_.swap(m.i2_);
         reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+
+        std::swap(factorized_, m.factorized_);
+        std::swap(factorizations_, m.factorizations_);
+        std::swap(factorizedA_, m.factorizedA_);
+        std::swap(factorizedB_, m.factorizedB_);
+        pivots_.swap(m.pivots_);
+        upperFactors_.swap(m.upperFactors_);
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
@@ -117,13 +136,17 @@ namespace QuantLib {
         const Real *y_lower(y.lower_.get());
         const Real *y_upper(y.upper_.get());
 
+        // as in TridiagonalOperator, the factorization is only
+        // invalidated if the bands actually change
+        bool changed = false;
+
         if (a.empty()) {
             if (b.empty()) {
                 //#pragma omp parallel for
                 for (Size i=0; i < size; ++i) {
-                    diag[i]  = y_diag[i];
-                    lower[i] = y_lower[i];
-                    upper[i] = y_upper[i];
+                    changed |= update(diag[i], y_diag[i]);
+                    changed |= update(lower[i], y_lower[i]);
+                    changed |= update(upper[i], y_upper[i]);
                 }
             }
             else {
@@ -131,9 +154,9 @@ namespace QuantLib {
                 const Size binc = (b.size() > 1) ? 1 : 0;
                 //#pragma omp parallel for
                 for (Size i=0; i < size; ++i) {
-                    diag[i]  = y_diag[i] + bptr[i*binc];
-                    lower[i] = y_lower[i];
-                    upper[i] = y_upper[i];
+                    changed |= update(diag[i], y_diag[i] + bptr[i*binc]);
+                    changed |= update(lower[i], y_lower[i]);
+                    changed |= update(upper[i], y_upper[i]);
                 }
             }
         }
@@ -148,9 +171,9 @@ namespace QuantLib {
             //#pragma omp parallel for
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
-                diag[i]  = y_diag[i]  + s*x_diag[i];
-                lower[i] = y_lower[i] + s*x_lower[i];
-                upper[i] = y_upper[i] + s*x_upper[i];
+                changed |= update(diag[i], y_diag[i]  + s*x_diag[i]);
+                changed |= update(lower[i], y_lower[i] + s*x_lower[i]);
+                changed |= update(upper[i], y_upper[i] + s*x_upper[i]);
             }
         }
         else {
@@ -167,11 +190,15 @@ namespace QuantLib {
             //#pragma omp parallel for
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
-                diag[i]  = y_diag[i]  + s*x_diag[i] + bptr[i*binc];
-                lower[i] = y_lower[i] + s*x_lower[i];
-                upper[i] = y_upper[i] + s*x_upper[i];
+                changed |= update(diag[i],
+                                  y_diag[i] + s*x_diag[i] + bptr[i*binc]);
+                changed |= update(lower[i], y_lower[i] + s*x_lower[i]);
+                changed |= update(upper[i], y_upper[i] + s*x_upper[i]);
             }
         }
+
+        if (changed)
+            factorized_ = false;
     }
 
     Disposable<TripleBandLinearOp>
@@ -251,10 +278,37 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
+        const long size = long(index->size());
+        const long n = long(index->dim()[direction_]);
+        const long stride = long(index->spacing()[direction_]);
+
         array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        const Real* rptr = r.begin();
+        Real* yptr = retVal.begin();
+
+        // away from the boundaries of the direction the neighbours
+        // are one stride apart; this loop works on contiguous memory
+        // and can be vectorized.  Points on the boundaries are
+        // overwritten below using the reflected neighbours.
+        #pragma omp parallel for
+        for (long i=stride; i < size-stride; ++i) {
+            yptr[i] = rptr[i-stride]*lptr[i] + rptr[i]*dptr[i]
+                + rptr[i+stride]*uptr[i];
+        }
+
+        const long nBlocks = size/(n*stride);
+        #pragma omp parallel for
+        for (long k=0; k < nBlocks; ++k) {
+            const long lowerBegin = k*n*stride;
+            const long upperBegin = lowerBegin + (n-1)*stride;
+            for (long j=0; j < stride; ++j) {
+                const long i = lowerBegin + j;
+                yptr[i] = rptr[i0ptr[i]]*lptr[i] + rptr[i]*dptr[i]
+                    + rptr[i2ptr[i]]*uptr[i];
+                const long l = upperBegin + j;
+                yptr[l] = rptr[i0ptr[l]]*lptr[l] + rptr[l]*dptr[l]
+                    + rptr[i2ptr[l]]*uptr[l];
+            }
         }
 
         return retVal;
@@ -283,7 +337,8 @@ namespace QuantLib {
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
              iter!=layout->end(); ++iter) {
-            const std::vector<Size>& coordinates = iter.coordinates();
+            const FdmLinearOpIterator::coordinates_type& coordinates
+                = iter.coordinates();
             QL_REQUIRE(   coordinates[direction_] != 0
                        || lower_[iter.index()] == 0,"removing non zero entry!");
             QL_REQUIRE(   coordinates[direction_] != layout->dim()[direction_]-1
@@ -291,36 +346,103 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        if (!factorized_ || a != factorizedA_ || b != factorizedB_)
+            factorize(a, b);
+
+        Array retVal(r.size());
 
         const Real* lptr = lower_.get();
-        const Real* dptr = diag_.get();
-        const Real* uptr = upper_.get();
+        const Size* riptr = reverseIndex_.get();
+        const Real* pptr = pivots_.begin();
+        const Real* fptr = upperFactors_.begin();
+
+        const long n = long(layout->dim()[direction_]);
+        const long nLines = long(layout->size())/n;
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        #pragma omp parallel for
+        for (long line=0; line < nLines; ++line) {
+            const long first = line*n;
+            const long last = first + n;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            Size rim1 = riptr[first];
+            retVal[rim1] = r[rim1]*pptr[first];
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+            for (long j=first+1; j < last; ++j) {
+                const Size ri = riptr[j];
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*pptr[j];
+                rim1 = ri;
+            }
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+            for (long j=last-2; j >= first; --j)
+                retVal[riptr[j]] -= fptr[j+1]*retVal[riptr[j+1]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
 
         return retVal;
     }
+
+    void TripleBandLinearOp::factorize(Real a, Real b) const {
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size size = layout->size();
+
+        if (pivots_.size() != size) {
+            pivots_ = Array(size);
+            upperFactors_ = Array(size);
+        }
+
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+        const Size* riptr = reverseIndex_.get();
+        Real* pptr = pivots_.begin();
+        Real* fptr = upperFactors_.begin();
+
+        // The reverse index enumerates the points line by line along
+        // the direction of the operator. The lines are decoupled, i.e.
+        // the lower band vanishes on the first and the upper band on the
+        // last point of each line, hence they can be factorized
+        // independently.
+        const long n = long(layout->dim()[direction_]);
+        const long nLines = long(size)/n;
+
+        Size failures = 0;
+        #pragma omp parallel for reduction(+:failures)
+        for (long line=0; line < nLines; ++line) {
+            const long first = line*n;
+            const long last = first + n;
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            // Only the reciprocal pivots and the upper factors
+            // are stored here, the rhs is processed by solve_splitting.
+            Size rim1 = riptr[first];
+            Real bet=1.0/(a*dptr[rim1]+b);
+            if (bet == 0.0) {
+                ++failures;
+                continue;
+            }
+            pptr[first] = bet;
+
+            for (long j=first+1; j < last; ++j) {
+                const Size ri = riptr[j];
+                fptr[j] = a*uptr[rim1]*bet;
+
+                bet=b+a*(dptr[ri]-fptr[j]*lptr[ri]);
+                if (bet == 0.0) {
+                    ++failures;
+                    break;
+                }
+                bet=1.0/bet;
+
+                pptr[j] = bet;
+                rim1 = ri;
+            }
+        }
+        QL_ENSURE(failures == 0, "division by zero");
+
+        factorized_ = true;
+        ++factorizations_;
+        factorizedA_ = a;
+        factorizedB_ = b;
+    }
 }
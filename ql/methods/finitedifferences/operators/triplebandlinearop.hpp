@@ -54,8 +54,14 @@ namespace QuantLib {
         #endif
 
         Disposable<Array> apply(const Array& r) const override;
+        /*! The LU factorization of a*this + b is kept between calls
+            and reused as long as a and b are the same and the bands
+            are not modified.
+        */
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
+        //! number of LU factorizations computed by solve_splitting
+        Size factorizations() const { return factorizations_; }
 
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
@@ -87,6 +93,16 @@ namespace QuantLib {
         #endif
 
         ext::shared_ptr<FdmMesher> mesher_;
+
+        // LU factorization of a*this + b, reused by solve_splitting;
+        // derived classes modifying the bands must reset factorized_
+        mutable bool factorized_ = false;
+        mutable Size factorizations_ = 0;
+        mutable Real factorizedA_, factorizedB_;
+        mutable Array pivots_, upperFactors_;
+
+      private:
+        void factorize(Real a, Real b) const;
     };
 
 
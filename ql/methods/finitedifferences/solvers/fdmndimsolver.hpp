@@ -53,7 +53,8 @@ namespace QuantLib {
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
         void static setValue(data_table& f,
-                             const std::vector<Size>& x, Real value);
+                             const FdmLinearOpIterator::coordinates_type& x,
+                             Real value);
 
       private:
         const FdmSolverDesc solverDesc_;
@@ -104,7 +105,8 @@ namespace QuantLib {
             initialValues_[iter.index()] = solverDesc_.calculator
                                 ->avgInnerValue(iter, solverDesc.maturity);
 
-            const std::vector<Size>& c = iter.coordinates();
+            const FdmLinearOpIterator::coordinates_type& c
+                = iter.coordinates();
             for (Size i=0; i < N; ++i) {
                 if ((std::accumulate(c.begin(), c.end(), 0UL) - c[i]) == 0U) {
                     x_[i].push_back(mesher->location(iter, i));
@@ -169,14 +171,16 @@ namespace QuantLib {
     }
 
     template <Size N> inline
-    void FdmNdimSolver<N>::setValue(data_table& f,
-                                    const std::vector<Size>& x, Real value) {
+    void FdmNdimSolver<N>::setValue(
+        data_table& f,
+        const FdmLinearOpIterator::coordinates_type& x, Real value) {
         FdmNdimSolver<N-1>::setValue(f[x[x.size()-N]], x, value);
     }
 
     template <> inline
-    void FdmNdimSolver<1>::setValue(data_table& f,
-                                    const std::vector<Size>& x, Real value) {
+    void FdmNdimSolver<1>::setValue(
+        data_table& f,
+        const FdmLinearOpIterator::coordinates_type& x, Real value) {
         f[x.back()] = value;
     }
 }
@@ -72,7 +72,8 @@ namespace QuantLib {
             for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
                  ++iter) {
 
-                const std::vector<Size>& coor = iter.coordinates();
+                const FdmLinearOpIterator::coordinates_type& coor
+                    = iter.coordinates();
                 const Real x = x_[coor[0]];
                 const Real y = y_[coor[1]];
 
@@ -54,7 +54,8 @@ namespace QuantLib {
             for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
                  ++iter) {
                 
-                const std::vector<Size>& coor = iter.coordinates();
+                const FdmLinearOpIterator::coordinates_type& coor
+                    = iter.coordinates();
                 
                 const Size exercisesUsed = coor[swingDirection_];
                 
@@ -25,9 +25,9 @@ namespace QuantLib {
     TridiagonalOperator::TridiagonalOperator(Size size) {
         if (size>=2) {
             n_ = size;
-            diagonal_      = Array(size);
-            lowerDiagonal_ = Array(size-1);
-            upperDiagonal_ = Array(size-1);
+            diagonal_      = Array(size, 0.0);
+            lowerDiagonal_ = Array(size-1, 0.0);
+            upperDiagonal_ = Array(size-1, 0.0);
             temp_          = Array(size);
         } else if (size==0) {
             n_ = 0;
@@ -92,21 +92,36 @@ namespace QuantLib {
                    "rhs vector of size " << rhs.size() <<
                    " instead of " << n_);
 
+        if (!factorized_)
+            factorize();
+
+        result[0] = rhs[0]*pivots_[0];
+        for (Size j=1; j<=n_-1; ++j)
+            result[j] = (rhs[j] - lowerDiagonal_[j-1]*result[j-1])*pivots_[j];
+        // cannot be j>=0 with Size j
+        for (Size j=n_-2; j>0; --j)
+            result[j] -= temp_[j+1]*result[j+1];
+        result[0] -= temp_[1]*result[1];
+    }
+
+    void TridiagonalOperator::factorize() const {
+        if (pivots_.size() != n_)
+            pivots_ = Array(n_);
+
         Real bet = diagonal_[0];
         QL_REQUIRE(!close(bet, 0.0),
                    "diagonal's first element (" << bet <<
                    ") cannot be close to zero");
-        result[0] = rhs[0]/bet;
+        pivots_[0] = 1.0/bet;
         for (Size j=1; j<=n_-1; ++j) {
-            temp_[j] = upperDiagonal_[j-1]/bet;
+            temp_[j] = upperDiagonal_[j-1]*pivots_[j-1];
             bet = diagonal_[j]-lowerDiagonal_[j-1]*temp_[j];
             QL_ENSURE(!close(bet, 0.0), "division by zero");
-            result[j] = (rhs[j] - lowerDiagonal_[j-1]*result[j-1])/bet;
+            pivots_[j] = 1.0/bet;
         }
-        // cannot be j>=0 with Size j
-        for (Size j=n_-2; j>0; --j)
-            result[j] -= temp_[j+1]*result[j+1];
-        result[0] -= temp_[1]*result[1];
+
+        factorized_ = true;
+        ++factorizations_;
     }
 
     Disposable<Array> TridiagonalOperator::SOR(const Array& rhs,
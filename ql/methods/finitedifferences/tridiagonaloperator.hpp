@@ -83,6 +83,9 @@ namespace QuantLib {
         //! apply operator to a given array
         Disposable<Array> applyTo(const Array& v) const;
         //! solve linear system for a given right-hand side
+        /*! The LU factorization of the operator is kept between
+            calls and reused until the operator is modified.
+        */
         Disposable<Array> solveFor(const Array& rhs) const;
         /*! solve linear system for a given right-hand side
             without result Array allocation. The rhs and result parameters
@@ -90,6 +93,8 @@ namespace QuantLib {
         */
         void solveFor(const Array& rhs,
                       Array& result) const;
+        //! number of LU factorizations computed by solveFor
+        Size factorizations() const { return factorizations_; }
         //! solve linear system with SOR approach
         Disposable<Array> SOR(const Array& rhs,
                               Real tol) const;
@@ -126,8 +131,13 @@ namespace QuantLib {
       protected:
         Size n_;
         Array diagonal_, lowerDiagonal_, upperDiagonal_;
-        mutable Array temp_;
+        mutable Array temp_, pivots_;
+        mutable bool factorized_ = false;
+        mutable Size factorizations_ = 0;
         ext::shared_ptr<TimeSetter> timeSetter_;
+
+      private:
+        void factorize() const;
     };
 
     /* \relates TridiagonalOperator */
@@ -170,8 +180,11 @@ namespace QuantLib {
 
     inline void TridiagonalOperator::setFirstRow(Real valB,
                                                  Real valC) {
-        diagonal_[0]      = valB;
-        upperDiagonal_[0] = valC;
+        if (diagonal_[0] != valB || upperDiagonal_[0] != valC) {
+            diagonal_[0]      = valB;
+            upperDiagonal_[0] = valC;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setMidRow(Size i,
@@ -180,25 +193,36 @@ namespace QuantLib {
                                                Real valC) {
         QL_REQUIRE(i>=1 && i<=n_-2,
                    "out of range in TridiagonalSystem::setMidRow");
-        lowerDiagonal_[i-1] = valA;
-        diagonal_[i]        = valB;
-        upperDiagonal_[i]   = valC;
+        if (lowerDiagonal_[i-1] != valA || diagonal_[i] != valB
+            || upperDiagonal_[i] != valC) {
+            lowerDiagonal_[i-1] = valA;
+            diagonal_[i]        = valB;
+            upperDiagonal_[i]   = valC;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setMidRows(Real valA,
                                                 Real valB,
                                                 Real valC) {
         for (Size i=1; i<=n_-2; i++) {
-            lowerDiagonal_[i-1] = valA;
-            diagonal_[i]        = valB;
-            upperDiagonal_[i]   = valC;
+            if (lowerDiagonal_[i-1] != valA || diagonal_[i] != valB
+                || upperDiagonal_[i] != valC) {
+                lowerDiagonal_[i-1] = valA;
+                diagonal_[i]        = valB;
+                upperDiagonal_[i]   = valC;
+                factorized_ = false;
+            }
         }
     }
 
     inline void TridiagonalOperator::setLastRow(Real valA,
                                                 Real valB) {
-        lowerDiagonal_[n_-2] = valA;
-        diagonal_[n_-1]      = valB;
+        if (lowerDiagonal_[n_-2] != valA || diagonal_[n_-1] != valB) {
+            lowerDiagonal_[n_-2] = valA;
+            diagonal_[n_-1]      = valB;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setTime(Time t) {
@@ -213,6 +237,9 @@ namespace QuantLib {
         lowerDiagonal_.swap(from.lowerDiagonal_);
         upperDiagonal_.swap(from.upperDiagonal_);
         temp_.swap(from.temp_);
+        pivots_.swap(from.pivots_);
+        swap(factorized_, from.factorized_);
+        swap(factorizations_, from.factorizations_);
         swap(timeSetter_, from.timeSetter_);
     }
 
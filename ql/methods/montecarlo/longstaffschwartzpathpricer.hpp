@@ -29,18 +29,53 @@
 #include <ql/functional.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
-#include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/utilities/threads.hpp>
 #if !defined(QL_USE_STD_UNIQUE_PTR)
 #include <boost/scoped_array.hpp>
 #endif
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <utility>
 #include <memory>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // flat storage of the regression states for compact calibration
+        template <class StateType>
+        struct LongstaffSchwartzStateStorage;
+
+        template <>
+        struct LongstaffSchwartzStateStorage<Real> {
+            static Size size(Real) { return 1; }
+            static void store(Real x, Real* p) { *p = x; }
+            static void load(const Real* p, Size, Real& x) { x = *p; }
+        };
+
+        template <>
+        struct LongstaffSchwartzStateStorage<Array> {
+            static Size size(const Array& x) { return x.size(); }
+            static void store(const Array& x, Real* p) {
+                std::copy(x.begin(), x.end(), p);
+            }
+            static void load(const Real* p, Size n, Array& x) {
+                if (x.size() != n)
+                    x = Array(n);
+                std::copy(p, p+n, x.begin());
+            }
+        };
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
     /*! References:
 
@@ -50,6 +85,31 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
+        If compact calibration is enabled, the calibration paths are
+        not stored; only the regression state and the exercise value
+        at each step are, in one contiguous array per step.  The
+        regression is then performed by updating the triangular
+        factor of a QR decomposition with the in-the-money paths.
+        The basis functions are evaluated once per step on the
+        in-the-money paths and used for both the regression and the
+        exercise decision.  The memory used is proportional to the
+        number of paths times the number of steps times the state
+        dimension plus one, plus the number of paths times the number
+        of basis functions for the step being calibrated.  The
+        results agree with the default calibration up to round-off.
+
+        Paths can be priced concurrently once the pricer is
+        calibrated.  During calibration, they can be stored from
+        several threads by index by means of resizeCalibrationPaths
+        and storeCalibrationPath, after storing the first one through
+        operator(); the regression is the same as if the paths were
+        stored in order.  If more than one thread is set through
+        setThreads, the exercise values and states of the calibration
+        paths and the regression design matrix are evaluated in
+        parallel when OpenMP is enabled; the early-exercise path
+        pricer and its basis functions must then be safe to call
+        concurrently.  By default, the calibration is serial.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -60,11 +120,24 @@ namespace QuantLib {
 
         LongstaffSchwartzPathPricer(const TimeGrid& times,
                                     ext::shared_ptr<EarlyExercisePathPricer<PathType> >,
-                                    const ext::shared_ptr<YieldTermStructure>& termStructure);
+                                    const ext::shared_ptr<YieldTermStructure>& termStructure,
+                                    bool compactCalibration = false);
 
         Real operator()(const PathType& path) const override;
         virtual void calibrate();
 
+        //! \name Concurrent calibration
+        //@{
+        //! resizes the storage for calibration paths
+        /*! At least one path must have been stored already. */
+        void resizeCalibrationPaths(Size n) const;
+        //! stores the i-th calibration path
+        /*! Paths with different indices can be stored concurrently. */
+        void storeCalibrationPath(Size i, const PathType& path) const;
+        //! number of threads used by the calibration and the pricing
+        void setThreads(Size threads);
+        //@}
+
         Real exerciseProbability() const;
 
       protected:
@@ -72,11 +145,21 @@ namespace QuantLib {
                                      const std::vector<StateType> &state,
                                      const std::vector<Real> &price,
                                      const std::vector<Real> &exercise) {}
+        void calibrateFromStates();
+        Array regressionCoefficients(const Matrix& R,
+                                     const Array& qty,
+                                     Size samples) const;
+
         bool  calibrationPhase_;
+        const bool compactCalibration_;
         const ext::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
 
-        mutable QuantLib::IncrementalStatistics exerciseProbability_;
+        // exercised and priced paths, counted separately by each
+        // pricing thread in its own cache line and summed afterwards
+        static const Size countStride_ = 8;
+        mutable std::vector<Size> exerciseCounts_;
+        Size threads_;
 
         #if defined(QL_USE_STD_UNIQUE_PTR)
         std::unique_ptr<Array[]> coeff_;
@@ -87,6 +170,10 @@ namespace QuantLib {
         #endif
 
         mutable std::vector<PathType> paths_;
+        // compact calibration: values at step i are stored in [i-1]
+        mutable std::vector<std::vector<Real> > exerciseValues_;
+        mutable std::vector<std::vector<Real> > states_;
+        mutable Size stateSize_;
         const   std::vector<ext::function<Real(StateType)> > v_;
 
         const Size len_;
@@ -96,10 +183,13 @@ namespace QuantLib {
     inline LongstaffSchwartzPathPricer<PathType>::LongstaffSchwartzPathPricer(
         const TimeGrid& times,
         ext::shared_ptr<EarlyExercisePathPricer<PathType> > pathPricer,
-        const ext::shared_ptr<YieldTermStructure>& termStructure)
-    : calibrationPhase_(true), pathPricer_(std::move(pathPricer)),
+        const ext::shared_ptr<YieldTermStructure>& termStructure,
+        bool compactCalibration)
+    : calibrationPhase_(true), compactCalibration_(compactCalibration),
+      pathPricer_(std::move(pathPricer)),
+      exerciseCounts_(2*countStride_, 0), threads_(1),
       coeff_(new Array[times.size() - 2]), dF_(new DiscountFactor[times.size() - 1]),
-      v_(pathPricer_->basisSystem()), len_(times.size()) {
+      stateSize_(0), v_(pathPricer_->basisSystem()), len_(times.size()) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -111,8 +201,23 @@ namespace QuantLib {
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.push_back(path);
+            if (compactCalibration_) {
+                // store states and exercise values for the calibration;
+                // the first path determines the state dimension
+                if (exerciseValues_.empty()) {
+                    stateSize_ =
+                        detail::LongstaffSchwartzStateStorage<StateType>::size(
+                                               pathPricer_->state(path, 1));
+                    exerciseValues_.resize(len_-1);
+                    states_.resize(len_-1);
+                }
+                const Size n = exerciseValues_[0].size();
+                resizeCalibrationPaths(n+1);
+                storeCalibrationPath(n, path);
+            } else {
+                // store paths for the calibration
+                paths_.push_back(path);
+            }
             // result doesn't matter
             return 0.0;
         }
@@ -143,13 +248,83 @@ namespace QuantLib {
             }
         }
 
-        exerciseProbability_.add(exercised ? 1.0 : 0.0);
+        // paths might be priced concurrently; the threads of the
+        // engine have their own counters, others share a locked one
+        #ifdef _OPENMP
+        const Size thread = omp_get_thread_num();
+        #else
+        const Size thread = 0;
+        #endif
+        if (thread < threads_) {
+            Size* counts = &exerciseCounts_[thread*countStride_];
+            ++counts[0];
+            if (exercised)
+                ++counts[1];
+        } else {
+            #pragma omp critical
+            {
+                Size* counts = &exerciseCounts_[threads_*countStride_];
+                ++counts[0];
+                if (exercised)
+                    ++counts[1];
+            }
+        }
 
         return price*dF_[0];
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::resizeCalibrationPaths(
+                                                              Size n) const {
+        if (compactCalibration_) {
+            QL_REQUIRE(!exerciseValues_.empty(),
+                       "no calibration path stored");
+            for (Size i=0; i<len_-1; ++i) {
+                exerciseValues_[i].resize(n);
+                states_[i].resize(n*stateSize_);
+            }
+        } else {
+            QL_REQUIRE(!paths_.empty(), "no calibration path stored");
+            paths_.resize(n, paths_.front());
+        }
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::storeCalibrationPath(
+                                   Size j, const PathType& path) const {
+        if (compactCalibration_) {
+            typedef detail::LongstaffSchwartzStateStorage<StateType> storage;
+            QL_REQUIRE(!exerciseValues_.empty() &&
+                       j < exerciseValues_[0].size(),
+                       "calibration path index (" << j << ") out of range");
+            for (Size i=1; i<len_; ++i) {
+                const StateType state = pathPricer_->state(path, i);
+                QL_REQUIRE(storage::size(state) == stateSize_,
+                           "inconsistent state dimension");
+                storage::store(state, &states_[i-1][j*stateSize_]);
+                exerciseValues_[i-1][j] = (*pathPricer_)(path, i);
+            }
+        } else {
+            QL_REQUIRE(j < paths_.size(),
+                       "calibration path index (" << j << ") out of range");
+            paths_[j] = path;
+        }
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::setThreads(Size threads) {
+        detail::checkThreads(threads);
+        threads_ = threads;
+        exerciseCounts_.assign((threads+1)*countStride_, 0);
+    }
+
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
+        if (compactCalibration_) {
+            calibrateFromStates();
+            return;
+        }
+
         const Size n = paths_.size();
         Array prices(n), exercise(n);
         std::vector<StateType> p_state(n);
@@ -165,21 +340,29 @@ namespace QuantLib {
 
         std::vector<Real>      y;
         std::vector<StateType> x;
+        std::vector<Size>      itm;
         for (Size i=len_-2; i>0; --i) {
             y.clear();
             x.clear();
+            itm.clear();
 
             //roll back step
-            for (Size j=0; j<n; ++j) {
+            #pragma omp parallel for num_threads(threads_) if(threads_ > 1)
+            for (long j=0; j<(long)n; ++j) {
                 exercise[j]=(*pathPricer_)(paths_[j], i);
+                p_state[j] = pathPricer_->state(paths_[j], i);
+            }
+            for (Size j=0; j<n; ++j) {
                 if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
+                    x.push_back(p_state[j]);
                     y.push_back(dF_[i]*prices[j]);
+                    itm.push_back(j);
                 }
             }
 
             if (v_.size() <=  x.size()) {
-                coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+                coeff_[i-1] =
+                    GeneralLinearLeastSquares(x, y, v_, threads_).coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
@@ -187,19 +370,23 @@ namespace QuantLib {
                 coeff_[i-1] = Array(v_.size(), 0.0);
             }
 
-            for (Size j=0, k=0; j<n; ++j) {
+            for (Size j=0; j<n; ++j)
                 prices[j]*=dF_[i];
-                if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i-1][l] * v_[l](x[k]);
-                    }
-                    if (continuationValue < exercise[j]) {
-                        prices[j] = exercise[j];
-                    }
-                    ++k;
+
+            const Array& coeff = coeff_[i-1];
+            #pragma omp parallel for num_threads(threads_) if(threads_ > 1)
+            for (long k=0; k<(long)itm.size(); ++k) {
+                Real continuationValue = 0.0;
+                for (Size l=0; l<v_.size(); ++l) {
+                    continuationValue += coeff[l] * v_[l](x[k]);
                 }
-                p_state[j] = pathPricer_->state(paths_[j],i);
+                const Size j = itm[k];
+                if (continuationValue < exercise[j]) {
+                    prices[j] = exercise[j];
+                }
+            }
+
+            for (Size j=0; j<n; ++j) {
                 p_price[j] = prices[j];
                 p_exercise[j] = exercise[j];
             }
@@ -214,9 +401,159 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::calibrateFromStates() {
+        typedef detail::LongstaffSchwartzStateStorage<StateType> storage;
+        exerciseValues_.resize(len_-1);
+        states_.resize(len_-1);
+        const Size n = exerciseValues_[0].size();
+        const Size m = v_.size();
+        const Size d = stateSize_;
+        const Size blockSize = 256;
+
+        Array prices(n);
+        std::vector<StateType> p_state(n);
+        std::vector<Real> p_price(n), p_exercise(n);
+
+        const std::vector<Real>& lastExercise = exerciseValues_[len_-2];
+        const std::vector<Real>& lastStates = states_[len_-2];
+        for (Size j=0; j<n; ++j) {
+            storage::load(&lastStates[j*d], d, p_state[j]);
+            prices[j] = p_price[j] = p_exercise[j] = lastExercise[j];
+        }
+
+        post_processing(len_ - 1, p_state, p_price, p_exercise);
+
+        // basis function l at the k-th in-the-money path is in
+        // basis[l*itm.size()+k]; it's evaluated once per step and used
+        // for both the regression and the exercise decision
+        std::vector<StateType> x(blockSize);
+        std::vector<Real> basis;
+        std::vector<Size> itm;
+        itm.reserve(n);
+
+        for (Size i=len_-2; i>0; --i) {
+            const std::vector<Real>& exercise = exerciseValues_[i-1];
+            const Real* states = states_[i-1].data();
+
+            itm.clear();
+            for (Size j=0; j<n; ++j) {
+                if (exercise[j] > 0.0)
+                    itm.push_back(j);
+            }
+            const Size nItm = itm.size();
+
+            basis.resize(m*nItm);
+            for (Size begin=0; begin<nItm; begin+=blockSize) {
+                const Size size = std::min(blockSize, nItm-begin);
+                for (Size k=0; k<size; ++k)
+                    storage::load(states + itm[begin+k]*d, d, x[k]);
+                for (Size l=0; l<m; ++l) {
+                    Real* b = &basis[l*nItm+begin];
+                    for (Size k=0; k<size; ++k)
+                        b[k] = v_[l](x[k]);
+                }
+            }
+
+            if (m <= nItm) {
+                // rows are added to the R factor by Givens rotations;
+                // Q^T y is updated along with it
+                Matrix R(m, m, 0.0);
+                Array qty(m, 0.0), row(m);
+                for (Size k=0; k<nItm; ++k) {
+                    for (Size l=0; l<m; ++l)
+                        row[l] = basis[l*nItm+k];
+                    Real y = dF_[i]*prices[itm[k]];
+                    for (Size l=0; l<m; ++l) {
+                        if (row[l] == 0.0)
+                            continue;
+                        const Real h = std::hypot(R[l][l], row[l]);
+                        const Real c = R[l][l]/h, s = row[l]/h;
+                        R[l][l] = h;
+                        for (Size q=l+1; q<m; ++q) {
+                            const Real t = R[l][q];
+                            R[l][q] = c*t + s*row[q];
+                            row[q] = c*row[q] - s*t;
+                        }
+                        const Real t = qty[l];
+                        qty[l] = c*t + s*y;
+                        y = c*y - s*t;
+                    }
+                }
+
+                coeff_[i-1] = regressionCoefficients(R, qty, nItm);
+            }
+            else {
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if exerciseValue > 0
+                coeff_[i-1] = Array(m, 0.0);
+            }
+
+            for (Size j=0; j<n; ++j)
+                prices[j]*=dF_[i];
+
+            const Array& coeff = coeff_[i-1];
+            for (Size k=0; k<nItm; ++k) {
+                Real continuationValue = 0.0;
+                for (Size l=0; l<m; ++l)
+                    continuationValue += coeff[l] * basis[l*nItm+k];
+                const Size j = itm[k];
+                if (continuationValue < exercise[j])
+                    prices[j] = exercise[j];
+            }
+
+            for (Size j=0; j<n; ++j) {
+                storage::load(states + j*d, d, p_state[j]);
+                p_price[j] = prices[j];
+                p_exercise[j] = exercise[j];
+            }
+
+            post_processing(i, p_state, p_price, p_exercise);
+        }
+
+        // remove calibration data and release memory
+        std::vector<std::vector<Real> > empty1, empty2;
+        exerciseValues_.swap(empty1);
+        states_.swap(empty2);
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType> inline
+    Array LongstaffSchwartzPathPricer<PathType>::regressionCoefficients(
+                                                  const Matrix& R,
+                                                  const Array& qty,
+                                                  Size samples) const {
+        // R has the same singular values as the design matrix; as in
+        // GeneralLinearLeastSquares, the smallest ones are discarded
+        const SVD svd(R);
+        const Matrix& V = svd.V();
+        const Matrix& U = svd.U();
+        const Array& w = svd.singularValues();
+        const Real threshold = samples * QL_EPSILON * w[0];
+
+        Array a(qty.size(), 0.0);
+        for (Size i=0; i<qty.size(); ++i) {
+            if (w[i] > threshold) {
+                const Real u = std::inner_product(U.column_begin(i),
+                                                  U.column_end(i),
+                                                  qty.begin(), 0.0)/w[i];
+                for (Size j=0; j<qty.size(); ++j)
+                    a[j] += u*V[j][i];
+            }
+        }
+        return a;
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
-        return exerciseProbability_.mean();
+        Size paths = 0, exercised = 0;
+        for (Size i=0; i<exerciseCounts_.size(); i+=countStride_) {
+            paths += exerciseCounts_[i];
+            exercised += exerciseCounts_[i+1];
+        }
+        QL_REQUIRE(paths > 0, "no paths priced");
+        return Real(exercised)/paths;
     }
 
 
@@ -28,7 +28,10 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/utilities/threads.hpp>
+#include <exception>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -75,8 +78,23 @@ namespace QuantLib {
             isControlVariate_ = static_cast<bool>(cvPathPricer_);
         }
         void addSamples(Size samples);
+        //! adds samples simulating them on the given number of threads
+        /*! Each thread works on a copy of the path generator(s)
+            moved ahead to its first sample, and the results are
+            added to the accumulator in the same order as in the
+            serial case; therefore, the statistics don't depend on
+            the number of threads.  The path pricers and the
+            underlying processes must be safe to use concurrently.
+
+            Threads are only used when OpenMP is enabled; otherwise,
+            the work is done sequentially with the same results.
+        */
+        void addSamples(Size samples, Size threads);
         const stats_type& sampleAccumulator() const;
       private:
+        result_type simulatePath(const path_generator_type& generator,
+                                 const path_generator_type* cvGenerator,
+                                 Real& weight) const;
         ext::shared_ptr<path_generator_type> pathGenerator_;
         ext::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -89,38 +107,123 @@ namespace QuantLib {
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
-    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::simulatePath(
+                                const path_generator_type& generator,
+                                const path_generator_type* cvGenerator,
+                                Real& weight) const {
+
+        const sample_type& path = generator.next();
+        result_type price = (*pathPricer_)(path.value);
+
+        if (isControlVariate_) {
+            if (cvGenerator == nullptr) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                const sample_type& cvPath = cvGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
 
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        weight = path.weight;
 
+        if (isAntitheticVariate_) {
+            const sample_type& atPath = generator.antithetic();
+            result_type price2 = (*pathPricer_)(atPath.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (cvGenerator == nullptr)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    const sample_type& cvPath = cvGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
 
-            if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
-                    else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            return result_type((price+price2)/2.0);
+        } else {
+            return price;
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price =
+                simulatePath(*pathGenerator_, cvPathGenerator_.get(), weight);
+            sampleAccumulator_.add(price, weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples,
+                                                      Size threads) {
+        detail::checkThreads(threads);
+
+        if (threads == 1 || samples < threads) {
+            addSamples(samples);
+            return;
+        }
+
+        // the first path is simulated serially so that lazy objects
+        // and other caches in processes and pricers are initialized
+        // before being accessed concurrently
+        if (sampleAccumulator_.samples() == 0) {
+            addSamples(1);
+            --samples;
+        }
+
+        // results are collected in rounds to keep memory bounded
+        const Size maxRoundSize = threads*16384;
+        std::vector<result_type> prices(std::min(samples, maxRoundSize));
+        std::vector<Real> weights(prices.size());
+        std::vector<ext::shared_ptr<path_generator_type> >
+            generators(threads), cvGenerators(threads);
+        std::vector<std::exception_ptr> errors(threads);
+
+        while (samples > 0) {
+            const Size roundSize = std::min(samples, maxRoundSize);
+
+            #pragma omp parallel for num_threads(threads) schedule(static)
+            for (long i=0; i<(long)threads; ++i) {
+                try {
+                    const Size begin = roundSize*i/threads,
+                               end = roundSize*(i+1)/threads;
+
+                    generators[i] = ext::make_shared<path_generator_type>(
+                                                           *pathGenerator_);
+                    generators[i]->discard(begin);
+                    if (cvPathGenerator_) {
+                        cvGenerators[i] =
+                            ext::make_shared<path_generator_type>(
+                                                         *cvPathGenerator_);
+                        cvGenerators[i]->discard(begin);
                     }
+
+                    for (Size j=begin; j<end; ++j)
+                        prices[j] = simulatePath(*generators[i],
+                                                 cvGenerators[i].get(),
+                                                 weights[j]);
+                } catch (...) {
+                    errors[i] = std::current_exception();
                 }
+            }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+            for (Size i=0; i<threads; ++i) {
+                if (errors[i])
+                    std::rethrow_exception(errors[i]);
             }
+
+            for (Size j=0; j<roundSize; ++j)
+                sampleAccumulator_.add(prices[j], weights[j]);
+
+            // the last generators are now where the serial ones would be
+            pathGenerator_ = generators[threads-1];
+            if (cvPathGenerator_)
+                cvPathGenerator_ = cvGenerators[threads-1];
+
+            samples -= roundSize;
         }
     }
 
@@ -30,6 +30,8 @@
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 namespace QuantLib {
@@ -57,12 +59,29 @@ namespace QuantLib {
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! skips the next n paths without generating them
+        void discard(BigNatural n) { generator_.discard(n); }
+        /*! generates the next n multi-paths at once and returns,
+            for each asset, a (time points x paths) matrix whose
+            columns are the paths; the results are the same that n
+            calls to next() would return.  The process is evolved
+            over the whole batch at each step.
+        */
+        const std::vector<Matrix>& nextBatch(Size n) const;
+        //! returns the antithetic paths of the last batch
+        const std::vector<Matrix>& antitheticBatch() const;
+        //! returns the weights of the paths in the last batch
+        const Array& batchWeights() const { return batchWeights_; }
       private:
         const sample_type& next(bool antithetic) const;
+        const std::vector<Matrix>& evolveBatch(bool antithetic) const;
         bool brownianBridge_;
         ext::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        mutable std::vector<Matrix> batch_;
+        mutable Matrix batchIncrements_;
+        mutable Array batchWeights_;
     };
 
 
@@ -150,6 +169,82 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    const std::vector<Matrix>&
+    MultiPathGenerator<GSG>::nextBatch(Size n) const {
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+
+        if (batchIncrements_.rows() != generator_.dimension() ||
+            batchIncrements_.columns() != n)
+            batchIncrements_ = Matrix(generator_.dimension(), n);
+        if (batchWeights_.size() != n)
+            batchWeights_ = Array(n);
+
+        typedef typename GSG::sample_type sequence_type;
+        for (Size j=0; j<n; ++j) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            std::copy(sequence_.value.begin(), sequence_.value.end(),
+                      batchIncrements_.column_begin(j));
+            batchWeights_[j] = sequence_.weight;
+        }
+
+        return evolveBatch(false);
+    }
+
+    template <class GSG>
+    const std::vector<Matrix>&
+    MultiPathGenerator<GSG>::antitheticBatch() const {
+        return evolveBatch(true);
+    }
+
+    template <class GSG>
+    const std::vector<Matrix>&
+    MultiPathGenerator<GSG>::evolveBatch(bool antithetic) const {
+        const Size m = process_->size();
+        const Size nFactors = process_->factors();
+        const Size n = batchIncrements_.columns();
+        const TimeGrid& timeGrid = next_.value[0].timeGrid();
+
+        batch_.resize(m);
+        for (Size k=0; k<m; k++) {
+            if (batch_[k].rows() != timeGrid.size()
+                || batch_[k].columns() != n)
+                batch_[k] = Matrix(timeGrid.size(), n);
+        }
+
+        const Array asset = process_->initialValues();
+        Matrix x(m, n), y(m, n), dw(nFactors, n);
+        for (Size k=0; k<m; k++) {
+            std::fill(x.row_begin(k), x.row_end(k), asset[k]);
+            std::fill(batch_[k].row_begin(0), batch_[k].row_end(0),
+                      asset[k]);
+        }
+
+        for (Size i = 1; i < timeGrid.size(); i++) {
+            Size offset = (i-1)*nFactors;
+            Time t = timeGrid[i-1];
+            Time dt = timeGrid.dt(i-1);
+            for (Size k=0; k<nFactors; k++) {
+                if (antithetic)
+                    std::transform(batchIncrements_.row_begin(offset+k),
+                                   batchIncrements_.row_end(offset+k),
+                                   dw.row_begin(k), std::negate<Real>());
+                else
+                    std::copy(batchIncrements_.row_begin(offset+k),
+                              batchIncrements_.row_end(offset+k),
+                              dw.row_begin(k));
+            }
+
+            process_->evolveBatch(t, x, dt, dw, y);
+            for (Size k=0; k<m; k++)
+                std::copy(y.row_begin(k), y.row_end(k),
+                          batch_[k].row_begin(i));
+            x.swap(y);
+        }
+
+        return batch_;
+    }
+
 }
 
 #endif
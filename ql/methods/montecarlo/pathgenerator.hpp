@@ -28,6 +28,8 @@
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
 #include <ql/stochasticprocess.hpp>
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 namespace QuantLib {
@@ -62,8 +64,28 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! \name modifiers
+        //@{
+        //! skips the next n paths without generating them
+        void discard(BigNatural n) { generator_.discard(n); }
+        //@}
+        //! \name batch generation
+        //@{
+        /*! generates the next n paths at once and returns them as
+            the columns of a (time points x paths) matrix, so that
+            the values at each time are stored contiguously; the
+            paths are the same that n calls to next() would return.
+            The process is evolved over the whole batch at each step.
+        */
+        const Matrix& nextBatch(Size n) const;
+        //! returns the antithetic paths of the last batch
+        const Matrix& antitheticBatch() const;
+        //! returns the weights of the paths in the last batch
+        const Array& batchWeights() const { return batchWeights_; }
+        //@}
       private:
         const sample_type& next(bool antithetic) const;
+        const Matrix& evolveBatch(bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -72,6 +94,8 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable Matrix batch_, batchIncrements_;
+        mutable Array batchWeights_;
     };
 
 
@@ -153,6 +177,67 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    const Matrix& PathGenerator<GSG>::nextBatch(Size n) const {
+        if (batchIncrements_.rows() != dimension_ ||
+            batchIncrements_.columns() != n)
+            batchIncrements_ = Matrix(dimension_, n);
+        if (batchWeights_.size() != n)
+            batchWeights_ = Array(n);
+
+        typedef typename GSG::sample_type sequence_type;
+        for (Size j=0; j<n; ++j) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+            std::copy(temp_.begin(), temp_.end(),
+                      batchIncrements_.column_begin(j));
+            batchWeights_[j] = sequence_.weight;
+        }
+
+        return evolveBatch(false);
+    }
+
+    template <class GSG>
+    const Matrix& PathGenerator<GSG>::antitheticBatch() const {
+        return evolveBatch(true);
+    }
+
+    template <class GSG>
+    const Matrix& PathGenerator<GSG>::evolveBatch(bool antithetic) const {
+        const Size n = batchIncrements_.columns();
+        if (batch_.rows() != timeGrid_.size() || batch_.columns() != n)
+            batch_ = Matrix(timeGrid_.size(), n);
+
+        Array x(n, process_->x0()), y(n), dw(n);
+        std::copy(x.begin(), x.end(), batch_.row_begin(0));
+
+        for (Size i=1; i<batch_.rows(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            if (antithetic)
+                std::transform(batchIncrements_.row_begin(i-1),
+                               batchIncrements_.row_end(i-1),
+                               dw.begin(), std::negate<Real>());
+            else
+                std::copy(batchIncrements_.row_begin(i-1),
+                          batchIncrements_.row_end(i-1),
+                          dw.begin());
+            process_->evolveBatch(t, x, dt, dw, y);
+            std::copy(y.begin(), y.end(), batch_.row_begin(i));
+            x.swap(y);
+        }
+
+        return batch_;
+    }
+
 }
 
 
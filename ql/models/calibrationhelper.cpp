@@ -20,6 +20,7 @@
 
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -84,4 +85,52 @@ namespace QuantLib {
         
         return error;
     }
+
+    Array BlackCalibrationHelper::calibrationErrorGradient() {
+        Array gradient = modelValueGradient();
+        if (gradient.empty())
+            return gradient;
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            {
+              const Real difference = marketValue() - modelValue();
+              // the derivative of the absolute value is taken as null
+              // where the latter is not differentiable
+              const Real sign = difference > 0.0 ? 1.0
+                                : (difference < 0.0 ? -1.0 : 0.0);
+              gradient *= -sign/marketValue();
+            }
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              const Real lowerPrice = blackPrice(minVol);
+              const Real upperPrice = blackPrice(maxVol);
+              const Real modelPrice = modelValue();
+
+              if (modelPrice <= lowerPrice || modelPrice >= upperPrice) {
+                  // the implied volatility is capped
+                  gradient *= 0.0;
+              } else {
+                  const Volatility implied = this->impliedVolatility(
+                                          modelPrice, 1e-12, 5000, minVol, maxVol);
+                  const Volatility h = std::min(1e-4*implied,
+                                                0.5*(implied - minVol));
+                  const Real vega =
+                      (blackPrice(implied + h) - blackPrice(implied - h))/(2.0*h);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
 }
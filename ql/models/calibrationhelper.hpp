@@ -25,6 +25,7 @@
 #ifndef quantlib_interest_rate_modelling_calibration_helper_h
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
@@ -42,6 +43,12 @@ namespace QuantLib {
         virtual ~CalibrationHelper() = default;
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        //! gradient of the error with respect to the model parameters
+        /*! The parameters are taken in the order returned by
+            CalibratedModel::params().  An empty array, as returned
+            by default, means that the gradient is not available.
+        */
+        virtual Array calibrationErrorGradient() { return Array(); }
     };
 
     QL_DEPRECATED_DISABLE_WARNING
@@ -79,6 +86,15 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         Real calibrationError() override;
 
+        //! gradient of the calibration error, from modelValueGradient()
+        Array calibrationErrorGradient() override;
+
+        //! gradient of the model price with respect to the model parameters
+        /*! An empty array, as returned by default, means that the
+            gradient is not available.
+        */
+        virtual Array modelValueGradient() const { return Array(); }
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -95,6 +111,11 @@ namespace QuantLib {
             engine_ = engine;
         }
 
+        //! returns the engine used to price the instrument
+        const ext::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
+
       protected:
         mutable Real marketValue_;
         Handle<Quote> volatility_;
@@ -56,6 +56,10 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const override {}
         void performCalculations() const override;
         Real modelValue() const override;
+        /*! Available when the pricing engine is an
+            AnalyticHestonEngine, including the Bates engines.
+        */
+        Array modelValueGradient() const override;
         Real blackPrice(Real volatility) const override;
         Time maturity() const  { calculate(); return tau_; }
       private:
@@ -23,6 +23,9 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/models/model.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/utilities/threads.hpp>
+#include <exception>
+#include <map>
 #include <utility>
 
 using std::vector;
@@ -32,24 +35,30 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None), calibrationThreads_(1) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
         CalibrationFunction(CalibratedModel* model,
                             const vector<ext::shared_ptr<CalibrationHelper> >& h,
                             vector<Real> weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            Size threads = 1)
         : model_(model, null_deleter()), instruments_(h), weights_(std::move(weights)),
-          projection_(projection) {}
+          projection_(projection), threads_(threads), evaluated_(false),
+          analyticJacobian_(true) {
+            if (threads_ > 1)
+                groupInstruments();
+        }
 
         ~CalibrationFunction() override = default;
 
         Real value(const Array& params) const override {
             model_->setParams(projection_.include(params));
+            const Array errors = calibrationErrors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
@@ -57,21 +66,140 @@ namespace QuantLib {
 
         Disposable<Array> values(const Array& params) const override {
             model_->setParams(projection_.include(params));
+            const Array errors = calibrationErrors();
             Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] = errors[i]*std::sqrt(weights_[i]);
             }
             return values;
         }
 
+        void gradient(Array& grad, const Array& params) const override {
+            Matrix jac(instruments_.size(), params.size());
+            if (!analyticJacobian(jac, params)) {
+                CostFunction::gradient(grad, params);
+                return;
+            }
+            // the model parameters are still set to params
+            const Array errors = calibrationErrors();
+            Real value = 0.0;
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
+            value = std::sqrt(value);
+            for (Size j=0; j<params.size(); ++j) {
+                grad[j] = 0.0;
+                if (value > 0.0) {
+                    for (Size i=0; i<instruments_.size(); ++i)
+                        grad[j] += errors[i]*std::sqrt(weights_[i])*jac[i][j];
+                    grad[j] /= value;
+                }
+            }
+        }
+
+        void jacobian(Matrix& jac, const Array& params) const override {
+            if (!analyticJacobian(jac, params))
+                CostFunction::jacobian(jac, params);
+        }
+
         Real finiteDifferenceEpsilon() const override { return 1e-6; }
 
       private:
+        // helpers sharing a pricing engine are put in the same group,
+        // since engines store their arguments and results and can't
+        // be used by several threads at once
+        void groupInstruments() {
+            std::map<const PricingEngine*, Size> groupOfEngine;
+            for (Size i=0; i<instruments_.size(); ++i) {
+                auto helper = ext::dynamic_pointer_cast<BlackCalibrationHelper>(
+                                                              instruments_[i]);
+                const PricingEngine* engine =
+                    helper != nullptr ? helper->pricingEngine().get() : nullptr;
+                if (engine != nullptr) {
+                    auto g = groupOfEngine.find(engine);
+                    if (g != groupOfEngine.end()) {
+                        groups_[g->second].push_back(i);
+                        continue;
+                    }
+                    groupOfEngine[engine] = groups_.size();
+                }
+                groups_.emplace_back(1, i);
+            }
+        }
+
+        // calls f(i) for each helper; if required, groups of helpers
+        // run on several threads, and each group is evaluated serially
+        template <class F>
+        void forEachInstrument(const F& f) const {
+            const Size n = instruments_.size();
+            #if !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            if (threads_ > 1 && groups_.size() > 1 && evaluated_) {
+                std::vector<std::exception_ptr> errors(n);
+                #pragma omp parallel for num_threads(threads_) schedule(dynamic)
+                for (long g=0; g<(long)groups_.size(); ++g) {
+                    for (Size i : groups_[g]) {
+                        try {
+                            f(i);
+                        } catch (...) {
+                            errors[i] = std::current_exception();
+                        }
+                    }
+                }
+                for (Size i=0; i<n; ++i) {
+                    if (errors[i])
+                        std::rethrow_exception(errors[i]);
+                }
+                return;
+            }
+            #endif
+            for (Size i=0; i<n; ++i)
+                f(i);
+            evaluated_ = true;
+        }
+
+        Array calibrationErrors() const {
+            Array errors(instruments_.size());
+            forEachInstrument([&](Size i) {
+                errors[i] = instruments_[i]->calibrationError();
+            });
+            return errors;
+        }
+
+        // Jacobian of values() from the helpers' gradients; false if
+        // any helper doesn't provide its gradient
+        bool analyticJacobian(Matrix& jac, const Array& params) const {
+            if (!analyticJacobian_)
+                return false;
+
+            const Array allParams = projection_.include(params);
+            model_->setParams(allParams);
+            vector<Array> gradients(instruments_.size());
+            forEachInstrument([&](Size i) {
+                gradients[i] = instruments_[i]->calibrationErrorGradient();
+            });
+
+            for (const auto& g : gradients) {
+                if (g.size() != allParams.size()) {
+                    analyticJacobian_ = false;
+                    return false;
+                }
+            }
+
+            for (Size i=0; i<instruments_.size(); ++i) {
+                const Array g = projection_.project(gradients[i]);
+                for (Size j=0; j<g.size(); ++j)
+                    jac[i][j] = g[j]*std::sqrt(weights_[i]);
+            }
+            return true;
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        const Size threads_;
+        vector<vector<Size> > groups_;
+        mutable bool evaluated_;
+        mutable bool analyticJacobian_;
     };
 
     void CalibratedModel::calibrate(
@@ -104,7 +232,7 @@ namespace QuantLib {
                    fixParameters.size() << ")");
         vector<bool> all(prms.size(), false);
         Projection proj(prms, !fixParameters.empty() ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        CalibrationFunction f(this,instruments,w,proj,calibrationThreads_);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -150,6 +278,11 @@ namespace QuantLib {
         notifyObservers();
     }
 
+    void CalibratedModel::setCalibrationThreads(Size threads) {
+        detail::checkThreads(threads);
+        calibrationThreads_ = threads;
+    }
+
     ShortRateModel::ShortRateModel(Size nArguments)
     : CalibratedModel(nArguments) {}
 
@@ -95,6 +95,14 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If all the helpers can return the gradient of their
+            calibration error (see
+            CalibrationHelper::calibrationErrorGradient) the cost
+            function uses it for its Jacobian and gradient; otherwise,
+            they are computed by finite differences.  Note that the
+            Levenberg-Marquardt method only asks the cost function for
+            its Jacobian if built with useCostFunctionsJacobian = true.
         */
         virtual void calibrate(
                 const std::vector<ext::shared_ptr<CalibrationHelper> >&,
@@ -121,6 +129,23 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! number of threads used to evaluate the calibration helpers
+        /*! The helpers are evaluated concurrently during calibration.
+            Black helpers sharing a pricing engine are evaluated one
+            after the other on the same thread; other helpers, and
+            engines, must be safe to use concurrently with each other.
+            The first evaluation is serial, so that lazy objects shared
+            by the helpers (e.g., term structures) are calculated before
+            threads are used.  The results don't depend on the number
+            of threads.
+
+            Threads are only used when OpenMP is enabled, and not with
+            thread-local sessions, in which other threads would see
+            their own settings.
+        */
+        void setCalibrationThreads(Size threads);
+        Size calibrationThreads() const { return calibrationThreads_; }
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -130,6 +155,7 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        Size calibrationThreads_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
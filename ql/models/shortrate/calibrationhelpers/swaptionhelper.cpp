@@ -24,6 +24,8 @@
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/blackswaptionengine.hpp>
 #include <ql/pricingengines/swaption/discretizedswaption.hpp>
+#include <ql/pricingengines/swaption/g2swaptionengine.hpp>
+#include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/schedule.hpp>
 #include <utility>
@@ -116,6 +118,19 @@ namespace QuantLib {
         return swaption_->NPV();
     }
 
+    Array SwaptionHelper::modelValueGradient() const {
+        calculate();
+        Swaption::arguments arguments;
+        swaption_->setupArguments(&arguments);
+        if (const ext::shared_ptr<JamshidianSwaptionEngine> engine =
+                ext::dynamic_pointer_cast<JamshidianSwaptionEngine>(engine_))
+            return engine->priceGradient(arguments);
+        if (const ext::shared_ptr<G2SwaptionEngine> engine =
+                ext::dynamic_pointer_cast<G2SwaptionEngine>(engine_))
+            return engine->priceGradient(arguments);
+        return Array();
+    }
+
     Real SwaptionHelper::blackPrice(Volatility sigma) const {
         calculate();
         Handle<Quote> vol(ext::shared_ptr<Quote>(new SimpleQuote(sigma)));
@@ -82,6 +82,11 @@ namespace QuantLib {
 
         void addTimesTo(std::list<Time>& times) const override;
         Real modelValue() const override;
+        /*! Available when the pricing engine is a
+            JamshidianSwaptionEngine with a HullWhite model, or a
+            G2SwaptionEngine.
+        */
+        Array modelValueGradient() const override;
         Real blackPrice(Volatility volatility) const override;
 
         ext::shared_ptr<VanillaSwap> underlyingSwap() const { calculate(); return swap_; }
@@ -99,6 +99,35 @@ namespace QuantLib {
         return valuex + valuey + value;
     }
 
+    Array G2::VGradient(Time t) const {
+        Real expat = std::exp(-a()*t);
+        Real expbt = std::exp(-b()*t);
+        Real expabt = expat*expbt;
+        Real cx = sigma()/a();
+        Real cy = eta()/b();
+        Real vx = t + (2.0*expat-0.5*expat*expat-1.5)/a();
+        Real vy = t + (2.0*expbt-0.5*expbt*expbt-1.5)/b();
+        Real dvxda = t*(expat*expat-2.0*expat)/a()
+            - (2.0*expat-0.5*expat*expat-1.5)/(a()*a());
+        Real dvydb = t*(expbt*expbt-2.0*expbt)/b()
+            - (2.0*expbt-0.5*expbt*expbt-1.5)/(b()*b());
+        Real w = t + (expat - 1.0)/a() + (expbt - 1.0)/b()
+            - (expabt-1.0)/(a()+b());
+        Real dwdab = t*expabt/(a()+b()) + (expabt-1.0)/((a()+b())*(a()+b()));
+        Real dwda = -t*expat/a() - (expat-1.0)/(a()*a()) + dwdab;
+        Real dwdb = -t*expbt/b() - (expbt-1.0)/(b()*b()) + dwdab;
+
+        Array gradient(5);
+        gradient[0] = -2.0*cx*cx*vx/a() + cx*cx*dvxda
+            + 2.0*rho()*cy*(-cx/a()*w + cx*dwda);
+        gradient[1] = 2.0*cx*vx/a() + 2.0*rho()*cy*w/a();
+        gradient[2] = -2.0*cy*cy*vy/b() + cy*cy*dvydb
+            + 2.0*rho()*cx*(-cy/b()*w + cy*dwdb);
+        gradient[3] = 2.0*cy*vy/b() + 2.0*rho()*cx*w/b();
+        gradient[4] = 2.0*cx*cy*w;
+        return gradient;
+    }
+
     Real G2::A(Time t, Time T) const {
         return termStructure()->discount(T)/termStructure()->discount(t)*
             std::exp(0.5*(V(T-t) - V(T) + V(t)));
@@ -151,6 +180,8 @@ namespace QuantLib {
 
         Real mux() const { return mux_; }
         Real sigmax() const { return sigmax_; }
+        const Array& muxGradient() const { return dmux_; }
+        const Array& sigmaxGradient() const { return dsigmax_; }
         Real operator()(Real x) const {
             CumulativeNormalDistribution phi;
             Real temp = (x - mux_)/sigmax_;
@@ -188,6 +219,137 @@ namespace QuantLib {
                 (sigmax_*std::sqrt(2.0*M_PI));
         }
 
+        // derivatives of the parameters of the integrand with respect
+        // to a, sigma, b, eta, rho
+        void initializeGradient(const G2& model) {
+            const Real ea = std::exp(-a_*T_), eb = std::exp(-b_*T_);
+            const Real eab = ea*eb, ab = a_+b_;
+
+            const Real qa = 0.5*(1.0-ea*ea)/a_, qb = 0.5*(1.0-eb*eb)/b_;
+            dsigmax_ = Array(5, 0.0);
+            dsigmax_[0] = 0.5*sigma_/std::sqrt(qa)*(T_*ea*ea - qa)/a_;
+            dsigmax_[1] = std::sqrt(qa);
+            dsigmay_ = Array(5, 0.0);
+            dsigmay_[2] = 0.5*eta_/std::sqrt(qb)*(T_*eb*eb - qb)/b_;
+            dsigmay_[3] = std::sqrt(qb);
+
+            const Real R = (1.0 - eab)/ab, dR = (T_*eab - R)/ab;
+            drhoxy_ = Array(5);
+            drhoxy_[0] = rhoxy_*(dR/R - dsigmax_[0]/sigmax_);
+            drhoxy_[1] = rhoxy_*(1.0/sigma_ - dsigmax_[1]/sigmax_);
+            drhoxy_[2] = rhoxy_*(dR/R - dsigmay_[2]/sigmay_);
+            drhoxy_[3] = rhoxy_*(1.0/eta_ - dsigmay_[3]/sigmay_);
+            drhoxy_[4] = eta_*sigma_*R/(sigmax_*sigmay_);
+
+            Real g[5];
+            dmux_ = Array(5);
+            muGradient(a_, sigma_, b_, eta_, g);
+            dmux_[0] = g[0]; dmux_[1] = g[1]; dmux_[2] = g[2];
+            dmux_[3] = g[3]; dmux_[4] = g[4];
+            dmuy_ = Array(5);
+            muGradient(b_, eta_, a_, sigma_, g);
+            dmuy_[2] = g[0]; dmuy_[3] = g[1]; dmuy_[0] = g[2];
+            dmuy_[1] = g[3]; dmuy_[4] = g[4];
+
+            const Array dVT = model.VGradient(T_);
+            dlogA_.resize(size_);
+            dBa_ = Array(size_);
+            dBb_ = Array(size_);
+            for (Size i=0; i<size_; i++) {
+                const Time tau = t_[i]-T_;
+                dlogA_[i] = 0.5*(model.VGradient(tau)
+                                 - model.VGradient(t_[i]) + dVT);
+                dBa_[i] = (tau*std::exp(-a_*tau) - Ba_[i])/a_;
+                dBb_[i] = (tau*std::exp(-b_*tau) - Bb_[i])/b_;
+            }
+        }
+
+        // derivatives of the integrand with respect to a, sigma, b,
+        // eta, rho; initializeGradient() must have been called
+        Array gradient(Real x) const {
+            CumulativeNormalDistribution phi;
+            NormalDistribution density;
+            const Real u = (x - mux_)/sigmax_;
+            const Real txy = std::sqrt(1.0 - rhoxy_*rhoxy_);
+
+            Array lambda(size_);
+            std::vector<Array> dlambda(size_);
+            for (Size i=0; i<size_; i++) {
+                Real tau = (i==0 ? t_[0] - T_ : t_[i] - t_[i-1]);
+                Real c = (i==size_-1 ? (1.0+rate_*tau) : rate_*tau);
+                lambda[i] = c*A_[i]*std::exp(-Ba_[i]*x);
+                dlambda[i] = lambda[i]*dlogA_[i];
+                dlambda[i][0] -= lambda[i]*dBa_[i]*x;
+            }
+
+            SolvingFunction function(lambda, Bb_) ;
+            Brent s1d;
+            s1d.setMaxEvaluations(1000);
+            Real searchBound = std::max(10.0*sigmay_, 1.0);
+            Real yb = s1d.solve(function, 1e-6, 0.00, -searchBound, searchBound);
+
+            // the critical y moves with the parameters so that
+            // sum_i lambda_i exp(-Bb_i y) stays equal to 1
+            Real dSdy = 0.0;
+            Array dyb(5, 0.0);
+            for (Size i=0; i<size_; i++) {
+                const Real e = std::exp(-Bb_[i]*yb);
+                dSdy += lambda[i]*Bb_[i]*e;
+                dyb += dlambda[i]*e;
+                dyb[2] -= lambda[i]*dBb_[i]*yb*e;
+            }
+            dyb /= dSdy;
+
+            const Real sx = sigmax_*txy, sy = sigmay_*txy;
+            const Real h1 = (yb - muy_)/sy - rhoxy_*u/txy;
+            Real value = phi(-w_*h1);
+
+            Array du(5), dtxy(5), dsx(5), dsy(5), dh1(5);
+            for (Size j=0; j<5; j++) {
+                du[j] = -(dmux_[j] + u*dsigmax_[j])/sigmax_;
+                dtxy[j] = -rhoxy_*drhoxy_[j]/txy;
+                dsx[j] = dsigmax_[j]*txy + sigmax_*dtxy[j];
+                dsy[j] = dsigmay_[j]*txy + sigmay_*dtxy[j];
+                dh1[j] = (dyb[j] - dmuy_[j])/sy
+                    - (yb - muy_)*dsy[j]/(sy*sy)
+                    - drhoxy_[j]*(x - mux_)/sx
+                    + rhoxy_*dmux_[j]/sx
+                    + rhoxy_*(x - mux_)*dsx[j]/(sx*sx);
+            }
+            Array dvalue = -w_*density(h1)*dh1;
+
+            for (Size i=0; i<size_; i++) {
+                const Real h2 = h1 + Bb_[i]*sy;
+                const Real m = muy_ - 0.5*txy*txy*sigmay_*sigmay_*Bb_[i] +
+                    rhoxy_*sigmay_*u;
+                const Real kappa = - Bb_[i]*m;
+                const Real e = std::exp(kappa);
+                const Real n = phi(-w_*h2);
+                value -= lambda[i]*e*n;
+
+                for (Size j=0; j<5; j++) {
+                    const Real dBb = (j == 2 ? dBb_[i] : 0.0);
+                    const Real dh2 = dh1[j] + dBb*sy + Bb_[i]*dsy[j];
+                    const Real dm = dmuy_[j]
+                        - 0.5*(-2.0*rhoxy_*drhoxy_[j]*sigmay_*sigmay_*Bb_[i]
+                               + txy*txy*2.0*sigmay_*dsigmay_[j]*Bb_[i]
+                               + txy*txy*sigmay_*sigmay_*dBb)
+                        + drhoxy_[j]*sigmay_*u + rhoxy_*dsigmay_[j]*u
+                        + rhoxy_*sigmay_*du[j];
+                    const Real dkappa = -dBb*m - Bb_[i]*dm;
+                    dvalue[j] -= (dlambda[i][j] + lambda[i]*dkappa)*e*n
+                        - w_*lambda[i]*e*density(h2)*dh2;
+                }
+            }
+
+            const Real weight = std::exp(-0.5*u*u)/(sigmax_*std::sqrt(2.0*M_PI));
+            Array result(5);
+            for (Size j=0; j<5; j++)
+                result[j] = weight*(dvalue[j]
+                                    - value*(u*du[j] + dsigmax_[j]/sigmax_));
+            return result;
+        }
+
 
       private:
         class SolvingFunction {
@@ -206,6 +368,31 @@ namespace QuantLib {
             const Array& Bb_;
         };
 
+        // derivatives of mu_x with respect to k1, s1, k2, s2, rho
+        // for (k1, s1, k2, s2) = (a, sigma, b, eta); mu_y is obtained
+        // by swapping the factors
+        void muGradient(Real k1, Real s1, Real k2, Real s2,
+                        Real g[5]) const {
+            const Real e1 = std::exp(-k1*T_), e3 = std::exp(-(k1+k2)*T_);
+            const Real E1 = 1.0 - e1, E2 = 1.0 - e1*e1, E3 = 1.0 - e3;
+            const Real k12 = k1+k2;
+            const Real c = rho_*s1*s2;
+            g[0] = -((-2.0*s1*s1/(k1*k1*k1) - c/(k1*k1*k2))*E1
+                     + (s1*s1/(k1*k1) + c/(k1*k2))*T_*e1
+                     + s1*s1/(k1*k1*k1)*E2
+                     - s1*s1/(k1*k1)*T_*e1*e1
+                     + c/(k2*k12*k12)*E3
+                     - c/(k2*k12)*T_*e3);
+            g[1] = -((2.0*s1/(k1*k1) + rho_*s2/(k1*k2))*E1
+                     - s1/(k1*k1)*E2
+                     - rho_*s2/(k2*k12)*E3);
+            g[2] = -(-c/(k1*k2*k2)*E1
+                     + c*(k1+2.0*k2)/(k2*k2*k12*k12)*E3
+                     - c/(k2*k12)*T_*e3);
+            g[3] = -(rho_*s1/(k1*k2)*E1 - rho_*s1/(k2*k12)*E3);
+            g[4] = -(s1*s2/(k1*k2)*E1 - s1*s2/(k2*k12)*E3);
+        }
+
         Real a_, sigma_, b_, eta_, rho_, w_;
         Time T_;
         std::vector<Time> t_;
@@ -213,6 +400,9 @@ namespace QuantLib {
         Size size_;
         Array A_, Ba_, Bb_;
         Real mux_, muy_, sigmax_, sigmay_, rhoxy_;
+        Array dmux_, dmuy_, dsigmax_, dsigmay_, drhoxy_;
+        std::vector<Array> dlogA_;
+        Array dBa_, dBb_;
     };
 
     Real G2::swaption(const Swaption::arguments& arguments,
@@ -242,4 +432,48 @@ namespace QuantLib {
             integrator(function, lower, upper);
     }
 
+    Array G2::swaptionGradient(const Swaption::arguments& arguments,
+                               Rate fixedRate, Real range,
+                               Size intervals) const {
+
+        Date settlement = termStructure()->referenceDate();
+        DayCounter dayCounter = termStructure()->dayCounter();
+        Time start = dayCounter.yearFraction(settlement,
+                                             arguments.floatingResetDates[0]);
+        Real w = (arguments.type==Swap::Payer ? 1 : -1 );
+
+        std::vector<Time> fixedPayTimes(arguments.fixedPayDates.size());
+        for (Size i=0; i<fixedPayTimes.size(); ++i)
+            fixedPayTimes[i] =
+                dayCounter.yearFraction(settlement,
+                                        arguments.fixedPayDates[i]);
+
+        SwaptionPricingFunction function(a(), sigma(), b(), eta(), rho(),
+                                         w, start,
+                                         fixedPayTimes,
+                                         fixedRate, (*this));
+        function.initializeGradient(*this);
+
+        Real upper = function.mux() + range*function.sigmax();
+        Real lower = function.mux() - range*function.sigmax();
+
+        // same trapezoidal rule as SegmentIntegral, plus the
+        // contribution of the integration bounds
+        Array integral(5, 0.0);
+        if (!close_enough(lower, upper)) {
+            Real dx = (upper-lower)/intervals;
+            integral = 0.5*(function.gradient(lower)
+                            + function.gradient(upper));
+            Real end = upper - 0.5*dx;
+            for (Real x = lower+dx; x < end; x += dx)
+                integral += function.gradient(x);
+            integral *= dx;
+            integral += function(upper)*(function.muxGradient()
+                                         + range*function.sigmaxGradient());
+            integral -= function(lower)*(function.muxGradient()
+                                         - range*function.sigmaxGradient());
+        }
+        return arguments.nominal*w*termStructure()->discount(start)*integral;
+    }
+
 }
@@ -82,6 +82,16 @@ namespace QuantLib {
                       Real range,
                       Size intervals) const;
 
+        /*! Derivatives of the result of swaption() with respect to
+            the model parameters, in the order of params().  The
+            integrand is differentiated analytically and integrated
+            on the same grid.
+        */
+        Array swaptionGradient(const Swaption::arguments& arguments,
+                               Rate fixedRate,
+                               Real range,
+                               Size intervals) const;
+
         DiscountFactor discount(Time t) const override { return termStructure()->discount(t); }
 
         Real a() const { return a_(0.0); }
@@ -111,6 +121,8 @@ namespace QuantLib {
         Parameter phi_;
 
         Real V(Time t) const;
+        // derivatives of V with respect to a, sigma, b, eta, rho
+        Array VGradient(Time t) const;
 
         class SwaptionPricingFunction;
         friend class SwaptionPricingFunction;
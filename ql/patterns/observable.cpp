@@ -23,6 +23,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
+#include <algorithm>
+#include <vector>
+
 namespace QuantLib {
 
     void ObservableSettings::enableUpdates() {
@@ -53,11 +56,88 @@ namespace QuantLib {
     }
 
 
+    void ObservableSettings::endBatch() {
+        QL_REQUIRE(batchDepth_ > 0, "no notification batch started");
+        if (--batchDepth_ == 0)
+            flushBatch();
+    }
+
+    void ObservableSettings::flushBatch() {
+        if (flushingBatch_ || batchedObservers_.empty())
+            return;
+
+        // topological order of the observers reachable from the
+        // recorded ones (reversed post-order of a depth-first visit)
+        std::vector<Observer*> order;
+        set_type visited;
+        std::vector<std::pair<Observer*, bool> > stack;
+        for (auto* start : batchedObservers_) {
+            if (visited.count(start) != 0U)
+                continue;
+            stack.emplace_back(start, false);
+            while (!stack.empty()) {
+                Observer* observer = stack.back().first;
+                bool expanded = stack.back().second;
+                stack.pop_back();
+                if (expanded) {
+                    order.push_back(observer);
+                    continue;
+                }
+                if (!visited.insert(observer).second)
+                    continue;
+                stack.emplace_back(observer, true);
+                auto* observable = dynamic_cast<Observable*>(observer);
+                if (observable != nullptr) {
+                    for (auto* child : observable->observers_) {
+                        if (visited.count(child) == 0U)
+                            stack.emplace_back(child, false);
+                    }
+                }
+            }
+        }
+        std::reverse(order.begin(), order.end());
+
+        // notifications sent by the updated observers are recorded
+        // as well and served when their turn comes
+        flushingBatch_ = true;
+        bool successful = true;
+        std::string errMsg;
+        auto updateObserver = [&](Observer* observer) {
+            ++batchedUpdates_;
+            try {
+                observer->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        };
+        for (auto* observer : order) {
+            if (batchedObservers_.erase(observer) != 0U)
+                updateObserver(observer);
+        }
+        // observers that registered during the flush, or in a cycle
+        while (!batchedObservers_.empty()) {
+            Observer* observer = *batchedObservers_.begin();
+            batchedObservers_.erase(batchedObservers_.begin());
+            updateObserver(observer);
+        }
+        flushingBatch_ = false;
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+
     void Observable::notifyObservers() {
         if (!settings_.updatesEnabled()) {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
             settings_.registerDeferredObservers(observers_);
+        } else if (settings_.updatesBatched()) {
+            // collected and sent at the end of the batch
+            settings_.registerBatchedObservers(observers_);
         } else if (!observers_.empty()) {
             bool successful = true;
             std::string errMsg;
@@ -87,76 +167,87 @@ namespace QuantLib {
 
 #else
 
-#include <boost/signals2/signal_type.hpp>
-
 namespace QuantLib {
 
-    namespace detail {
-
-        class Signal {
-          public:
-            typedef boost::signals2::signal_type<
-                void(),
-                boost::signals2::keywords::mutex_type<boost::recursive_mutex> >
-                ::type signal_type;
-
-            void connect(const signal_type::slot_type& slot) {
-                sig_.connect(slot);
-            }
-
-            template <class T>
-            void disconnect(const T& slot) {
-                sig_.disconnect(slot);
-            }
+    // batches only collect the notifications sent by the thread
+    // that started them, so their state is kept per thread
+    struct ObservableSettings::BatchState {
+        Size depth = 0;
+        bool flushing = false;
+        set_type observers;
+    };
+
+    ObservableSettings::BatchState& ObservableSettings::batchState() {
+        static thread_local BatchState state;
+        return state;
+    }
 
-            void operator()() const {
-                sig_();
-            }
-          private:
-            signal_type sig_;
-        };
+    bool ObservableSettings::updatesBatched() const {
+        const BatchState& batch = batchState();
+        return batch.depth > 0 && !batch.flushing;
+    }
 
-        template <class T>
-        class ProxyUpdater {
-            T* proxy_;
-          public:
-            explicit ProxyUpdater(const ext::shared_ptr<T>& observerProxy)
-            : proxy_(observerProxy.get()) {}
+    void ObservableSettings::startBatch() {
+        ++batchState().depth;
+    }
 
-            void operator()() const {
-                proxy_->update();
-            }
+    void ObservableSettings::endBatch() {
+        BatchState& batch = batchState();
+        QL_REQUIRE(batch.depth > 0, "no notification batch started");
+        if (--batch.depth == 0)
+            flushBatch();
+    }
 
-            bool operator==(const ProxyUpdater<T>& other) const {
-                return proxy_ == other.proxy_;
-            }
+    void ObservableSettings::registerBatchedObservers(
+        const std::vector<ext::shared_ptr<Observer::Proxy> >& observers) {
+        batchedNotifications_ += observers.size();
+        batchState().observers.insert(observers.begin(), observers.end());
+    }
 
-            bool operator!=(const ProxyUpdater<T>& other) const {
-                return proxy_ != other.proxy_;
+    void ObservableSettings::flushBatch() {
+        BatchState& batch = batchState();
+        if (batch.observers.empty())
+            return;
+
+        set_type observers;
+        observers.swap(batch.observers);
+        batchedUpdates_ += observers.size();
+
+        // notifications sent by the updated observers are forwarded
+        batch.flushing = true;
+        bool successful = true;
+        std::string errMsg;
+        for (const auto& observer : observers) {
+            try {
+                const ext::shared_ptr<Observer::Proxy> proxy = observer.lock();
+                if (proxy)
+                    proxy->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
             }
-        };
+        }
+        batch.flushing = false;
 
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
     }
 
-    void Observable::registerObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy) {
-        {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.insert(observerProxy);
-        }
-
-        detail::Signal::signal_type::slot_type slot {detail::ProxyUpdater<Observer::Proxy>(observerProxy)};
-        #if defined(QL_USE_STD_SHARED_PTR)
-        sig_->connect(slot.track_foreign(observerProxy));
-        #else
-        sig_->connect(slot.track(observerProxy));
-        #endif
+    void Observable::registerObserver(
+                   const ext::shared_ptr<Observer::Proxy>& observerProxy) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        if (observers_.insert(observerProxy).second)
+            atomic_store(&snapshot_, ext::shared_ptr<const list_type>());
     }
 
-    void Observable::unregisterObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy,
-                                        bool disconnect) {
+    void Observable::unregisterObserver(
+                   const ext::shared_ptr<Observer::Proxy>& observerProxy) {
         {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.erase(observerProxy);
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            if (observers_.erase(observerProxy) != 0U)
+                atomic_store(&snapshot_, ext::shared_ptr<const list_type>());
         }
 
         if (settings_.updatesDeferred()) {
@@ -165,23 +256,62 @@ namespace QuantLib {
                 settings_.unregisterDeferredObserver(observerProxy);
             }
         }
+    }
 
-        if (disconnect) {
-            sig_->disconnect(detail::ProxyUpdater<Observer::Proxy>(observerProxy));
+    ext::shared_ptr<const Observable::list_type>
+    Observable::observerList() const {
+        ext::shared_ptr<const list_type> observers = atomic_load(&snapshot_);
+        if (!observers) {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            // another thread might have rebuilt it in the meantime
+            observers = atomic_load(&snapshot_);
+            if (!observers) {
+                observers = ext::shared_ptr<const list_type>(
+                    new list_type(observers_.begin(), observers_.end()));
+                atomic_store(&snapshot_, observers);
+            }
         }
+        return observers;
+    }
+
+    void Observable::sendNotifications() const {
+        const ext::shared_ptr<const list_type> observers = observerList();
+        if (observers->empty())
+            return;
+
+        bool successful = true;
+        std::string errMsg;
+        for (const auto& proxy : *observers) {
+            try {
+                proxy->update();
+            } catch (std::exception& e) {
+                // as in the single-threaded implementation, try and
+                // notify all observers before raising an exception
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
     }
 
     void Observable::notifyObservers() {
         if (settings_.updatesEnabled()) {
-            return (*sig_)();
+            if (settings_.updatesBatched())
+                return settings_.registerBatchedObservers(*observerList());
+            return sendNotifications();
         }
 
         boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
         if (settings_.updatesEnabled()) {
-            return (*sig_)();
+            if (settings_.updatesBatched())
+                return settings_.registerBatchedObservers(*observerList());
+            return sendNotifications();
         }
         else if (settings_.updatesDeferred()) {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+            boost::lock_guard<boost::mutex> lock(mutex_);
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
             settings_.registerDeferredObservers(observers_);
@@ -189,12 +319,10 @@ namespace QuantLib {
     }
 
     Observable::Observable()
-    : sig_(new detail::Signal()),
-      settings_(ObservableSettings::instance()) { }
+    : settings_(ObservableSettings::instance()) { }
 
     Observable::Observable(const Observable&)
-    : sig_(new detail::Signal()),
-      settings_(ObservableSettings::instance()) {
+    : settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
@@ -58,7 +58,22 @@ namespace QuantLib {
         bool updatesEnabled() const { return updatesEnabled_; }
         bool updatesDeferred() const { return updatesDeferred_; }
 
+        //! \name Batched notifications (see NotificationBatch)
+        //@{
+        bool updatesBatched() const {
+            return batchDepth_ > 0 || flushingBatch_;
+        }
+        //! notifications to observers requested while batching
+        Size batchedNotifications() const { return batchedNotifications_; }
+        //! updates actually sent to observers when flushing batches
+        Size batchedUpdates() const { return batchedUpdates_; }
+        void resetBatchStatistics() {
+            batchedNotifications_ = batchedUpdates_ = 0;
+        }
+        //@}
+
       private:
+        friend class NotificationBatch;
         ObservableSettings()
 
             = default;
@@ -67,17 +82,30 @@ namespace QuantLib {
             const boost::unordered_set<Observer*>& observers);
         void unregisterDeferredObserver(Observer*);
 
+        void startBatch() { ++batchDepth_; }
+        void endBatch();
+        void flushBatch();
+        void registerBatchedObservers(
+            const boost::unordered_set<Observer*>& observers);
+        void unregisterBatchedObserver(Observer*);
+
         typedef boost::unordered_set<Observer*> set_type;
         typedef set_type::iterator iterator;
         set_type deferredObservers_;
 
         bool updatesEnabled_ = true, updatesDeferred_ = false;
+
+        set_type batchedObservers_;
+        Size batchDepth_ = 0;
+        bool flushingBatch_ = false;
+        Size batchedNotifications_ = 0, batchedUpdates_ = 0;
     };
 
     //! Object that notifies its changes to a set of observers
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
       public:
         // constructors, assignment, destructor
         Observable() : settings_(ObservableSettings::instance()) {}
@@ -151,6 +179,16 @@ namespace QuantLib {
         deferredObservers_.erase(o);
     }
 
+    inline void ObservableSettings::registerBatchedObservers(
+        const boost::unordered_set<Observer*>& observers) {
+        batchedNotifications_ += observers.size();
+        batchedObservers_.insert(observers.begin(), observers.end());
+    }
+
+    inline void ObservableSettings::unregisterBatchedObserver(Observer* o) {
+        batchedObservers_.erase(o);
+    }
+
     inline Observable::Observable(const Observable&)
     : settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
@@ -181,6 +219,8 @@ namespace QuantLib {
     inline Size Observable::unregisterObserver(Observer* o) {
         if (settings_.updatesDeferred())
             settings_.unregisterDeferredObserver(o);
+        if (settings_.updatesBatched())
+            settings_.unregisterBatchedObserver(o);
 
         return observers_.erase(o);
     }
@@ -252,6 +292,7 @@ namespace QuantLib {
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/smart_ptr/owner_less.hpp>
 #include <set>
+#include <vector>
 
 
 
@@ -343,12 +384,18 @@ namespace QuantLib {
         set_type observables_;
     };
 
-	namespace detail {
-		class Signal;
-	}
-
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! Notifications are sent to a snapshot of the registered
+        observers, which is shared among notifying threads and rebuilt
+        only after the set of observers changes. Therefore,
+        notifying doesn't lock the observable unless an observer
+        registered or unregistered since the last notification, and
+        registering or unregistering doesn't wait for notifications
+        in progress; observers that unregistered after a
+        notification started might still be updated by it.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
       public:
@@ -366,14 +413,16 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        void registerObserver(const ext::shared_ptr<Observer::Proxy>&);
-        void unregisterObserver(
-            const ext::shared_ptr<Observer::Proxy>& proxy, bool disconnect);
+        typedef std::vector<ext::shared_ptr<Observer::Proxy> > list_type;
 
-        ext::shared_ptr<detail::Signal> sig_;
+        void registerObserver(const ext::shared_ptr<Observer::Proxy>&);
+        void unregisterObserver(const ext::shared_ptr<Observer::Proxy>&);
+        ext::shared_ptr<const list_type> observerList() const;
+        void sendNotifications() const;
 
         set_type observers_;
-        mutable boost::recursive_mutex mutex_;
+        mutable ext::shared_ptr<const list_type> snapshot_;
+        mutable boost::mutex mutex_;
 
         ObservableSettings& settings_;
     };
@@ -392,8 +441,32 @@ namespace QuantLib {
 
         bool updatesEnabled()  {return (updatesType_ & UpdatesEnabled) != 0; }
         bool updatesDeferred() {return (updatesType_ & UpdatesDeferred) != 0; }
+
+        /*! \name Batched notifications (see NotificationBatch)
+            In this configuration, batches are local to the thread
+            that started them: they collect the notifications sent
+            from that thread, and the updates are sent without
+            ordering them.  Notifications sent by other threads are
+            not affected.
+        */
+        //@{
+        //! whether the calling thread is batching notifications
+        bool updatesBatched() const;
+        Size batchedNotifications() const { return batchedNotifications_; }
+        Size batchedUpdates() const { return batchedUpdates_; }
+        void resetBatchStatistics() {
+            batchedNotifications_ = batchedUpdates_ = 0;
+        }
+        //@}
       private:
-        ObservableSettings() : updatesType_(UpdatesEnabled) {}
+        friend class NotificationBatch;
+        ObservableSettings()
+        : updatesType_(UpdatesEnabled),
+          batchedNotifications_(0), batchedUpdates_(0) {}
+
+        void startBatch();
+        void endBatch();
+        void flushBatch();
 
         typedef std::set<ext::weak_ptr<Observer::Proxy>,
                          boost::owner_less<ext::weak_ptr<Observer::Proxy> > >
@@ -403,12 +476,19 @@ namespace QuantLib {
         void registerDeferredObservers(const Observable::set_type& observers);
         void unregisterDeferredObserver(
             const ext::shared_ptr<Observer::Proxy>& proxy);
+        void registerBatchedObservers(
+            const std::vector<ext::shared_ptr<Observer::Proxy> >& observers);
+
+        struct BatchState;
+        static BatchState& batchState();
 
         set_type deferredObservers_;
         mutable boost::mutex mutex_;
 
         enum UpdateType { UpdatesEnabled = 1, UpdatesDeferred = 2} ;
         boost::atomic<int> updatesType_;
+
+        boost::atomic<Size> batchedNotifications_, batchedUpdates_;
     };
 
 
@@ -492,7 +572,7 @@ namespace QuantLib {
 
         iterator i;
         for (i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(proxy_, true);
+            (*i)->unregisterObserver(proxy_);
 
         {
             boost::lock_guard<boost::recursive_mutex> lock(o.mutex_);
@@ -510,7 +590,7 @@ namespace QuantLib {
             proxy_->deactivate();
 
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(proxy_, false);
+            (*i)->unregisterObserver(proxy_);
     }
 
     inline std::pair<Observer::iterator, bool>
@@ -543,7 +623,7 @@ namespace QuantLib {
         boost::lock_guard<boost::recursive_mutex> lock(mutex_);
 
         if (h && proxy_)  {
-            h->unregisterObserver(proxy_, true);
+            h->unregisterObserver(proxy_);
         }
 
         return observables_.erase(h);
@@ -553,7 +633,7 @@ namespace QuantLib {
         boost::lock_guard<boost::recursive_mutex> lock(mutex_);
 
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(proxy_, true);
+            (*i)->unregisterObserver(proxy_);
 
         observables_.clear();
     }
@@ -563,4 +643,61 @@ namespace QuantLib {
     }
 }
 #endif
+
+namespace QuantLib {
+
+    //! Scope batching the notifications of observables
+    /*! While an instance is alive, the notifications sent by
+        observables are collected instead of being forwarded, and
+        each observer is recorded once no matter how many of its
+        observables changed.  When the scope exits, the recorded
+        observers are updated in topological order, i.e., each of them
+        after the observers it depends on; the notifications they send
+        in turn are collected and forwarded in the same order, so that
+        every affected observer is updated once.
+
+        Scopes can be nested; notifications are sent when the
+        outermost one exits.  Explicitly disabling updates through
+        ObservableSettings takes precedence over batching.
+
+        \warning Exceptions thrown by observers while updating them
+                 at the end of the scope are discarded; call flush()
+                 before the scope exits in order to receive them.
+
+        \ingroup patterns
+    */
+    class NotificationBatch {
+      public:
+        NotificationBatch();
+        ~NotificationBatch();
+        NotificationBatch(const NotificationBatch&) = delete;
+        NotificationBatch& operator=(const NotificationBatch&) = delete;
+        //! sends the notifications collected so far
+        void flush();
+      private:
+        ObservableSettings& settings_;
+    };
+
+
+    // inline definitions
+
+    inline NotificationBatch::NotificationBatch()
+    : settings_(ObservableSettings::instance()) {
+        settings_.startBatch();
+    }
+
+    inline NotificationBatch::~NotificationBatch() {
+        try {
+            settings_.endBatch();
+        } catch (...) {
+            // nothing we can do in a destructor
+        }
+    }
+
+    inline void NotificationBatch::flush() {
+        settings_.flushBatch();
+    }
+
+}
+
 #endif
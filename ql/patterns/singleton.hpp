@@ -26,10 +26,14 @@
 
 #include <ql/qldefines.hpp>
 
+#if defined(QL_ENABLE_SESSIONS) && defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#    error QL_ENABLE_SESSIONS and QL_ENABLE_THREAD_LOCAL_SESSIONS are mutually exclusive
+#endif
+
 #ifdef QL_ENABLE_SESSIONS
 #    include <boost/thread/locks.hpp>
 #    include <boost/thread/shared_mutex.hpp>
-#else
+#elif !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
 #    ifdef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
 #        include <boost/atomic.hpp>
 #        include <boost/thread/mutex.hpp>
@@ -87,7 +91,10 @@ namespace QuantLib {
 
         Global can be used to distinguish Singletons that are local to a session
         (Global = false) or that are global across all sessions (B = true).
-        This is only relevant if QL_ENABLE_SESSIONS is enabled.
+        This is only relevant if QL_ENABLE_SESSIONS or
+        QL_ENABLE_THREAD_LOCAL_SESSIONS is enabled; in the latter case,
+        each thread is a session and the instance it sees is destroyed
+        when the thread exits.
 
         \ingroup patterns
     */
@@ -117,6 +124,16 @@ namespace QuantLib {
             static boost::shared_mutex mutex;
             return mutex;
         }
+#elif defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        static ext::shared_ptr<T>& m_instance() {
+            static thread_local ext::shared_ptr<T> instance;
+            return instance;
+        }
+        static T& m_globalInstance() {
+            // initialization of local statics is thread-safe in C++11
+            static const ext::shared_ptr<T> instance(new T);
+            return *instance;
+        }
 #else
 #    ifdef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
         static boost::atomic<T*>& m_instance() {
@@ -158,6 +175,13 @@ namespace QuantLib {
             m_instances()[id] = tmp;
             return *tmp;
         }
+#elif defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        if (Global())
+            return m_globalInstance();
+        ext::shared_ptr<T>& instance = m_instance();
+        if (!instance)
+            instance = ext::shared_ptr<T>(new T);
+        return *instance;
 #else
 #    ifdef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
         // thread safe double checked locking pattern with atomic memory calls
@@ -20,6 +20,8 @@
 
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <algorithm>
+#include <functional>
 
 namespace QuantLib {
 
@@ -51,4 +53,33 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    Array ArithmeticAPOPathPricer::operator()(const Matrix& paths,
+                                              const TimeGrid& grid) const {
+        Size n = paths.rows();
+        QL_REQUIRE(n>1, "the paths cannot be empty");
+        QL_REQUIRE(grid.size() == n, "mismatch between paths and time grid");
+
+        // the sums are accumulated over rows, i.e., over all paths at
+        // each fixing, in the same order as in the single-path case
+        Array sums(paths.columns(), runningSum_);
+        Size first, fixings;
+        if (grid.mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+        for (Size i=first; i<n; ++i)
+            std::transform(sums.begin(), sums.end(), paths.row_begin(i),
+                           sums.begin(), std::plus<Real>());
+
+        for (Size j=0; j<sums.size(); ++j) {
+            Real averagePrice = sums[j]/fixings;
+            sums[j] = discount_ * payoff_(averagePrice);
+        }
+        return sums;
+    }
+
 }
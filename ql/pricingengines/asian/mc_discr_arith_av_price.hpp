@@ -89,6 +89,11 @@ namespace QuantLib {
                                 Real runningSum = 0.0,
                                 Size pastFixings = 0);
         Real operator()(const Path& path) const override;
+        //! prices the paths stored as columns of the given matrix
+        /*! This can be used on batches returned by
+            PathGenerator::nextBatch.
+        */
+        Array operator()(const Matrix& paths, const TimeGrid& grid) const;
 
       private:
         PlainVanillaPayoff payoff_;
@@ -196,6 +201,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -205,6 +211,10 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
+        // set by withThreads(), so that the multi-threaded simulation
+        // is only compiled when requested
+        void (McSimulation<SingleVariate,RNG,S>::*setThreads_)(Size);
     };
 
     template <class RNG, class S>
@@ -212,7 +222,8 @@ namespace QuantLib {
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()), tolerance_(Null<Real>()),
-      brownianBridge_(true), seed_(0) {}
+      brownianBridge_(true), seed_(0), threads_(1),
+      setThreads_(nullptr) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -271,17 +282,28 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        setThreads_ = &McSimulation<SingleVariate,RNG,S>::setThreads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
                                                                       const {
-        return ext::shared_ptr<PricingEngine>(new
+        ext::shared_ptr<MCDiscreteArithmeticAPEngine<RNG,S> > engine(new
             MCDiscreteArithmeticAPEngine<RNG,S>(process_,
                                                 brownianBridge_,
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
                                                 seed_));
+        if (setThreads_ != nullptr)
+            ((*engine).*setThreads_)(threads_);
+        return engine;
     }
 
 
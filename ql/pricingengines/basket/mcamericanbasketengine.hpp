@@ -61,7 +61,8 @@ namespace QuantLib {
                                Size nCalibrationSamples = Null<Size>(),
                                Size polynomOrder = 2,
                                LsmBasisSystem::PolynomType
-                                   polynomType = LsmBasisSystem::Monomial);
+                                   polynomType = LsmBasisSystem::Monomial,
+                               bool compactCalibration = false);
       protected:
         ext::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> > lsmPathPricer() const override;
 
@@ -89,17 +90,22 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withPolynomialOrder(Size polynmOrder);
         MakeMCAmericanBasketEngine&
             withBasisSystem(LsmBasisSystem::PolynomType polynomType);
+        MakeMCAmericanBasketEngine& withCompactCalibration(bool b = true);
+        MakeMCAmericanBasketEngine& withThreads(Size threads);
 
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
         ext::shared_ptr<StochasticProcessArray> process_;
-        bool brownianBridge_, antithetic_;
+        bool brownianBridge_, antithetic_, compactCalibration_;
         Size steps_, stepsPerYear_, samples_,
-            maxSamples_, calibrationSamples_, polynomOrder_;
+            maxSamples_, calibrationSamples_, polynomOrder_, threads_;
         LsmBasisSystem::PolynomType polynomType_;
         Real tolerance_;
         BigNatural seed_;
+        // set by withThreads(), so that the multi-threaded simulation
+        // is only compiled when requested
+        void (MCAmericanBasketEngine<RNG>::*setThreads_)(Size);
     };
 
 
@@ -140,7 +146,8 @@ namespace QuantLib {
                    BigNatural seed,
                    Size nCalibrationSamples,
                    Size polynomOrder,
-                   LsmBasisSystem::PolynomType polynomType)
+                   LsmBasisSystem::PolynomType polynomType,
+                   bool compactCalibration)
         : MCLongstaffSchwartzEngine<BasketOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -152,7 +159,11 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples),
+                                                      nCalibrationSamples,
+                                                      boost::none,
+                                                      boost::none,
+                                                      Null<Size>(),
+                                                      compactCalibration),
           polynomOrder_(polynomOrder), polynomType_(polynomType) {}
 
     template <class RNG>
@@ -187,7 +198,8 @@ namespace QuantLib {
              
                      this->timeGrid(),
                      earlyExercisePathPricer,
-                     *(process->riskFreeRate()));
+                     *(process->riskFreeRate()),
+                     this->compactCalibration_);
     }
 
 
@@ -195,9 +207,11 @@ namespace QuantLib {
     inline MakeMCAmericanBasketEngine<RNG>::MakeMCAmericanBasketEngine(
         ext::shared_ptr<StochasticProcessArray> process)
     : process_(std::move(process)), brownianBridge_(false), antithetic_(false),
+      compactCalibration_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()), samples_(Null<Size>()),
       maxSamples_(Null<Size>()), calibrationSamples_(Null<Size>()), polynomOrder_(2),
-      polynomType_(LsmBasisSystem::Monomial), tolerance_(Null<Real>()), seed_(0) {}
+      threads_(1), polynomType_(LsmBasisSystem::Monomial), tolerance_(Null<Real>()), seed_(0),
+      setThreads_(nullptr) {}
 
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
@@ -284,6 +298,21 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withCompactCalibration(bool b) {
+        compactCalibration_ = b;
+        return *this;
+    }
+
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withThreads(Size threads) {
+        threads_ = threads;
+        setThreads_ = &MCAmericanBasketEngine<RNG>::setThreads;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -292,7 +321,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return ext::shared_ptr<PricingEngine>(new
+        ext::shared_ptr<MCAmericanBasketEngine<RNG> > engine(new
             MCAmericanBasketEngine<RNG>(process_,
                                         steps_,
                                         stepsPerYear_,
@@ -304,7 +333,11 @@ namespace QuantLib {
                                         seed_,
                                         calibrationSamples_,
                                         polynomOrder_,
-                                        polynomType_));
+                                        polynomType_,
+                                        compactCalibration_));
+        if (setThreads_ != nullptr)
+            ((*engine).*setThreads_)(threads_);
+        return engine;
     }
 
 }
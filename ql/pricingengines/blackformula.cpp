@@ -42,6 +42,7 @@
 #endif
 
 #include <boost/math/special_functions/sign.hpp>
+#include <limits>
 
 namespace {
     void checkParameters(QuantLib::Real strike,
@@ -59,6 +60,21 @@ namespace {
                                                      << displacement
                                                      << ") must be positive");
     }
+
+    void checkBatchSizes(QuantLib::Size n,
+                         const QuantLib::Array& strikes,
+                         const QuantLib::Array& forwards,
+                         const QuantLib::Array& values,
+                         const QuantLib::Array& discounts)
+    {
+        QL_REQUIRE(strikes.size() == n && forwards.size() == n &&
+                   values.size() == n && discounts.size() == n,
+                   "mismatch between number of option types (" << n
+                   << "), strikes (" << strikes.size()
+                   << "), forwards (" << forwards.size()
+                   << "), values (" << values.size()
+                   << ") and discounts (" << discounts.size() << ")");
+    }
 }
 
 namespace QuantLib {
@@ -113,6 +129,57 @@ namespace QuantLib {
             payoff->strike(), forward, stdDev, discount, displacement);
     }
 
+    Array blackFormula(const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts,
+                       Real displacement) {
+        const Size n = optionTypes.size();
+        checkBatchSizes(n, strikes, forwards, stdDevs, discounts);
+
+        Array sign(n), d1(n), d2(n), nd1(n), nd2(n);
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+            sign[i] = Integer(optionTypes[i]);
+        }
+
+        // null strikes and standard deviations give non-finite values
+        // here; they are replaced by the limit prices below.
+        for (Size i=0; i<n; ++i) {
+            const Real forward = forwards[i] + displacement;
+            const Real strike = strikes[i] + displacement;
+            const Real d = std::log(forward/strike)/stdDevs[i]
+                + 0.5*stdDevs[i];
+            d1[i] = sign[i] * d;
+            d2[i] = sign[i] * (d - stdDevs[i]);
+        }
+        CumulativeNormalDistribution phi;
+        phi(d1.begin(), d1.end(), nd1.begin());
+        phi(d2.begin(), d2.end(), nd2.begin());
+
+        Array result(n);
+        for (Size i=0; i<n; ++i) {
+            const Real forward = forwards[i] + displacement;
+            const Real strike = strikes[i] + displacement;
+            const Real value =
+                discounts[i] * sign[i] * (forward*nd1[i] - strike*nd2[i]);
+            const Real intrinsic = discounts[i] *
+                std::max((forwards[i]-strikes[i]) * sign[i], Real(0.0));
+            const Real zeroStrike =
+                sign[i] > 0.0 ? forward*discounts[i] : Real(0.0);
+            // numerical inaccuracies can yield a negative answer
+            result[i] = stdDevs[i] == 0.0 ? intrinsic :
+                        (strike == 0.0 ? zeroStrike :
+                                         std::max(value, Real(0.0)));
+        }
+        return result;
+    }
+
     Real blackFormulaForwardDerivative(Option::Type optionType,
                                        Real strike,
                                        Real forward,
@@ -460,6 +527,103 @@ namespace QuantLib {
     }
 
 
+    Array blackFormulaImpliedStdDev(const std::vector<Option::Type>& optionTypes,
+                                    const Array& strikes,
+                                    const Array& forwards,
+                                    const Array& blackPrices,
+                                    const Array& discounts,
+                                    Real displacement,
+                                    Real accuracy,
+                                    Natural maxIterations) {
+        const Size n = optionTypes.size();
+        checkBatchSizes(n, strikes, forwards, blackPrices, discounts);
+
+        // the iteration works on the undiscounted price of the
+        // out-of-the-money option, as the scalar version does
+        Array sign(n), strike(n), forward(n), moneyness(n), price(n);
+        Array stdDev(n), error(n), d1(n), d2(n), nd1(n), nd2(n);
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+            QL_REQUIRE(blackPrices[i]>=0.0,
+                       "option price (" << blackPrices[i]
+                       << ") must be non-negative");
+            Option::Type type = optionTypes[i];
+            Real blackPrice = blackPrices[i];
+            Real otherOptionPrice = blackPrice
+                - Integer(type) * (forwards[i]-strikes[i])*discounts[i];
+            QL_REQUIRE(otherOptionPrice>=0.0,
+                       "negative " << Option::Type(-1*type) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity. No solution exists for " <<
+                       type << " strike " << strikes[i] <<
+                       ", forward " << forwards[i] <<
+                       ", price " << blackPrice <<
+                       ", deflator " << discounts[i]);
+            if ((type==Option::Put && strikes[i]>forwards[i]) ||
+                (type==Option::Call && strikes[i]<forwards[i])) {
+                type = Option::Type(-1*type);
+                blackPrice = otherOptionPrice;
+            }
+            sign[i] = Integer(type);
+            strike[i] = strikes[i] + displacement;
+            forward[i] = forwards[i] + displacement;
+            moneyness[i] = std::log(forward[i]/strike[i]);
+            price[i] = blackPrice/discounts[i];
+            stdDev[i] = (price[i] > 0.0 && strike[i] > 0.0) ?
+                blackFormulaImpliedStdDevApproximationRS(
+                    type, strike[i], forward[i], price[i]) :
+                Real(0.0);
+        }
+
+        CumulativeNormalDistribution phi;
+        NormalDistribution density;
+        // two third-order Householder steps, followed by a pass that
+        // only estimates the remaining error as the Newton step from
+        // the result.  Invalid iterates become NaN and are left to
+        // the scalar solver below.
+        const Size steps = 2;
+        for (Size k=0; k<=steps; ++k) {
+            for (Size i=0; i<n; ++i) {
+                const Real d = moneyness[i]/stdDev[i] + 0.5*stdDev[i];
+                d1[i] = sign[i] * d;
+                d2[i] = sign[i] * (d - stdDev[i]);
+            }
+            phi(d1.begin(), d1.end(), nd1.begin());
+            phi(d2.begin(), d2.end(), nd2.begin());
+            for (Size i=0; i<n; ++i) {
+                const Real s = stdDev[i], x = moneyness[i];
+                const Real value =
+                    sign[i] * (forward[i]*nd1[i] - strike[i]*nd2[i]);
+                const Real vega = forward[i]*density(d1[i]);
+                const Real nu = (price[i] - value)/vega;
+                const Real h2 = x*x/(s*s*s) - 0.25*s;
+                const Real h3 = h2*h2 - 3.0*x*x/(s*s*s*s) - 0.25;
+                const Real next =
+                    s + nu*(1.0 + 0.5*h2*nu)/(1.0 + nu*(h2 + h3*nu/6.0));
+                error[i] = nu;
+                if (k < steps)
+                    stdDev[i] = next > 0.0 ? next
+                                           : std::numeric_limits<Real>::quiet_NaN();
+            }
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (price[i] == 0.0) {
+                stdDev[i] = 0.0;
+            } else if (!(std::fabs(error[i]) <= accuracy)) {
+                Real guess = (stdDev[i] > 0.0 && stdDev[i] < 24.0) ?
+                    stdDev[i] : Null<Real>();
+                stdDev[i] = blackFormulaImpliedStdDev(
+                    optionTypes[i], strikes[i], forwards[i], blackPrices[i],
+                    discounts[i], displacement, guess, accuracy,
+                    maxIterations);
+            }
+        }
+        return stdDev;
+    }
+
     namespace {
         Real Np(Real x, Real v) {
             return CumulativeNormalDistribution()(x/v + 0.5*v);
@@ -742,6 +906,39 @@ namespace QuantLib {
             payoff->strike(), forward, stdDev, discount);
     }
 
+    Array bachelierBlackFormula(const std::vector<Option::Type>& optionTypes,
+                                const Array& strikes,
+                                const Array& forwards,
+                                const Array& stdDevs,
+                                const Array& discounts) {
+        const Size n = optionTypes.size();
+        checkBatchSizes(n, strikes, forwards, stdDevs, discounts);
+
+        Array d(n), h(n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+            d[i] = (forwards[i]-strikes[i]) * Integer(optionTypes[i]);
+        }
+
+        for (Size i=0; i<n; ++i)
+            h[i] = d[i] / stdDevs[i];
+        CumulativeNormalDistribution phi;
+        Array nh(n);
+        phi(h.begin(), h.end(), nh.begin());
+        Array result(n);
+        for (Size i=0; i<n; ++i) {
+            const Real value = discounts[i] *
+                (stdDevs[i]*phi.derivative(h[i]) + d[i]*nh[i]);
+            result[i] = stdDevs[i] == 0.0 ?
+                discounts[i]*std::max(d[i], Real(0.0)) :
+                std::max(value, Real(0.0));
+        }
+        return result;
+    }
+
     Real bachelierBlackFormulaForwardDerivative(
         Option::Type optionType, Real strike, Real forward, Real stdDev, Real discount)
     {
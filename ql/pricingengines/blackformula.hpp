@@ -35,7 +35,9 @@
 #define quantlib_blackformula_hpp
 
 #include <ql/instruments/payoffs.hpp>
+#include <ql/math/array.hpp>
 #include <ql/option.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -60,6 +62,24 @@ namespace QuantLib {
                       Real discount = 1.0,
                       Real displacement = 0.0);
 
+    /*! Black 1976 formula for a batch of options.
+
+        The i-th element of the result equals
+        blackFormula(optionTypes[i], strikes[i], forwards[i],
+        stdDevs[i], discounts[i], displacement).  The formula is
+        evaluated in branch-free loops over contiguous arrays, which
+        makes it suitable for pricing whole option chains at once.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    Array blackFormula(const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts,
+                       Real displacement = 0.0);
+
     /*! Black 1976 model forward derivative
         \warning instead of volatility it uses standard deviation,
                  i.e. volatility*sqrt(timeToMaturity)
@@ -191,6 +211,29 @@ namespace QuantLib {
                                    Real accuracy = 1.0e-6,
                                    Natural maxIterations = 100);
 
+    /*! Black 1976 implied standard deviation for a batch of options,
+        i.e. volatility*sqrt(timeToMaturity)
+
+        The starting point for each option is given by the
+        Radoicic-Stefanica approximation (see
+        blackFormulaImpliedStdDevApproximationRS) and is refined by
+        two third-order Householder steps on the out-of-the-money
+        option price; all options are processed together in
+        branch-free loops.  Options for which a further Newton step
+        would still be larger than the required accuracy are passed,
+        with the refined starting point, to the scalar
+        blackFormulaImpliedStdDev using the given accuracy and
+        maximum number of iterations.
+    */
+    Array blackFormulaImpliedStdDev(const std::vector<Option::Type>& optionTypes,
+                                    const Array& strikes,
+                                    const Array& forwards,
+                                    const Array& blackPrices,
+                                    const Array& discounts,
+                                    Real displacement = 0.0,
+                                    Real accuracy = 1.0e-6,
+                                    Natural maxIterations = 100);
+
     /*! Black 1976 implied standard deviation,
          i.e. volatility*sqrt(timeToMaturity)
 
@@ -337,6 +380,22 @@ namespace QuantLib {
                                Real stdDev,
                                Real discount = 1.0);
 
+    /*! Bachelier formula for a batch of options.
+
+        The i-th element of the result equals
+        bachelierBlackFormula(optionTypes[i], strikes[i], forwards[i],
+        stdDevs[i], discounts[i]).
+
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    Array bachelierBlackFormula(const std::vector<Option::Type>& optionTypes,
+                                const Array& strikes,
+                                const Array& forwards,
+                                const Array& stdDevs,
+                                const Array& discounts);
+
     /*! Bachelier Black model forward derivative.
 
         \warning Bachelier model needs absolute volatility, not
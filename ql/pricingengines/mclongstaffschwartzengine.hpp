@@ -30,6 +30,7 @@
 #include <ql/exercise.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
+#include <exception>
 
 
 namespace QuantLib {
@@ -68,7 +69,10 @@ namespace QuantLib {
           calibration and pricing; note however that this has no effect
           for low discrepancy RNGs usually, it is therefore recommended
           to use pseudo random generators for the calibration phase always
-          (and possibly quasi monte carlo in the subsequent pricing). */
+          (and possibly quasi monte carlo in the subsequent pricing).
+          If compactCalibration is true, the calibration stores the
+          regression states instead of the full paths; see
+          LongstaffSchwartzPathPricer.  */
         MCLongstaffSchwartzEngine(ext::shared_ptr<StochasticProcess> process,
                                   Size timeSteps,
                                   Size timeStepsPerYear,
@@ -82,15 +86,29 @@ namespace QuantLib {
                                   Size nCalibrationSamples = Null<Size>(),
                                   boost::optional<bool> brownianBridgeCalibration = boost::none,
                                   boost::optional<bool> antitheticVariateCalibration = boost::none,
-                                  BigNatural seedCalibration = Null<Size>());
+                                  BigNatural seedCalibration = Null<Size>(),
+                                  bool compactCalibration = false);
 
         void calculate() const override;
 
+        //! number of threads used for the calibration and the pricing
+        /*! The calibration paths are simulated in parallel as well as
+            the pricing ones, and the regression is run on the same
+            number of threads; see LongstaffSchwartzPathPricer for the
+            requirements on the path pricer.  The calibration paths
+            are the same as in the serial case, and so are the
+            results.  As in McSimulation, the multi-threaded code is
+            only compiled for engines on which this method is called.
+        */
+        void setThreads(Size threads);
+
       protected:
         virtual ext::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
                                                    lsmPathPricer() const = 0;
 
         TimeGrid timeGrid() const override;
+        void simulateCalibrationPaths(
+                    const path_generator_type_calibration& generator) const;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override;
 
@@ -106,11 +124,16 @@ namespace QuantLib {
         const bool brownianBridgeCalibration_;
         const bool antitheticVariateCalibration_;
         const BigNatural seedCalibration_;
+        const bool compactCalibration_;
 
         mutable ext::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
         mutable ext::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >
             mcModelCalibration_;
+
+      private:
+        void (MCLongstaffSchwartzEngine::*simulateCalibrationPathsOnThreads_)(
+                            const path_generator_type_calibration&) const;
     };
 
     template <class GenericEngine,
@@ -133,7 +156,8 @@ namespace QuantLib {
                                   Size nCalibrationSamples,
                                   boost::optional<bool> brownianBridgeCalibration,
                                   boost::optional<bool> antitheticVariateCalibration,
-                                  BigNatural seedCalibration)
+                                  BigNatural seedCalibration,
+                                  bool compactCalibration)
     : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate), process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), brownianBridge_(brownianBridge),
       requiredSamples_(requiredSamples), requiredTolerance_(requiredTolerance),
@@ -146,7 +170,9 @@ namespace QuantLib {
           // NOLINTNEXTLINE(readability-implicit-bool-conversion)
           antitheticVariateCalibration ? *antitheticVariateCalibration : antitheticVariate),
       seedCalibration_(seedCalibration != Null<Real>() ? seedCalibration :
-                                                         (seed == 0 ? 0 : seed + 1768237423L)) {
+                                                         (seed == 0 ? 0 : seed + 1768237423L)),
+      compactCalibration_(compactCalibration),
+      simulateCalibrationPathsOnThreads_(nullptr) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -179,6 +205,8 @@ namespace QuantLib {
                                           RNG_Calibration>::calculate() const {
         // calibration
         pathPricer_ = this->lsmPathPricer();
+        if (this->threads_ > 1)
+            pathPricer_->setThreads(this->threads_);
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
         typename RNG_Calibration::rsg_type generator =
@@ -194,7 +222,11 @@ namespace QuantLib {
                     pathGeneratorCalibration, pathPricer_, stats_type(),
                     this->antitheticVariateCalibration_));
 
-        mcModelCalibration_->addSamples(nCalibrationSamples_);
+        if (this->threads_ > 1 && nCalibrationSamples_ > 1)
+            (this->*simulateCalibrationPathsOnThreads_)(
+                                                *pathGeneratorCalibration);
+        else
+            mcModelCalibration_->addSamples(nCalibrationSamples_);
         pathPricer_->calibrate();
         // pricing
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
@@ -209,6 +241,63 @@ namespace QuantLib {
         }
     }
 
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline void
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S, RNG_Calibration>::
+    setThreads(Size threads) {
+        McSimulation<MC,RNG,S>::setThreads(threads);
+        simulateCalibrationPathsOnThreads_ =
+            &MCLongstaffSchwartzEngine::simulateCalibrationPaths;
+    }
+
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline void
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S, RNG_Calibration>::
+    simulateCalibrationPaths(
+                    const path_generator_type_calibration& generator) const {
+        const Size samples = nCalibrationSamples_;
+        const Size pathsPerSample = antitheticVariateCalibration_ ? 2 : 1;
+
+        // the first sample is stored serially; this initializes the
+        // storage layout as well as lazy objects in the processes
+        path_generator_type_calibration serialGenerator(generator);
+        (*pathPricer_)(serialGenerator.next().value);
+        if (antitheticVariateCalibration_)
+            (*pathPricer_)(serialGenerator.antithetic().value);
+        pathPricer_->resizeCalibrationPaths(samples*pathsPerSample);
+
+        // each thread draws its samples from a copy of the generator
+        // moved ahead to its first one, as in MonteCarloModel
+        const Size threads = std::min(this->threads_, samples-1);
+        std::vector<std::exception_ptr> errors(threads);
+
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (long t=0; t<(long)threads; ++t) {
+            try {
+                const Size begin = 1 + (samples-1)*t/threads,
+                           end = 1 + (samples-1)*(t+1)/threads;
+                path_generator_type_calibration g(serialGenerator);
+                g.discard(begin-1);
+                for (Size j=begin; j<end; ++j) {
+                    pathPricer_->storeCalibrationPath(j*pathsPerSample,
+                                                      g.next().value);
+                    if (antitheticVariateCalibration_)
+                        pathPricer_->storeCalibrationPath(
+                                 j*pathsPerSample+1, g.antithetic().value);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        }
+
+        for (Size t=0; t<threads; ++t) {
+            if (errors[t])
+                std::rethrow_exception(errors[t]);
+        }
+    }
+
     template <class GenericEngine, template <class> class MC, class RNG,
               class S, class RNG_Calibration>
     inline TimeGrid
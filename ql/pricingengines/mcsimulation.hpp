@@ -28,6 +28,7 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/utilities/threads.hpp>
 
 namespace QuantLib {
 
@@ -65,11 +66,20 @@ namespace QuantLib {
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
                        Size maxSamples) const;
+        //! number of threads used for simulating samples
+        /*! The results don't depend on the number of threads; see
+            MonteCarloModel::addSamples for details and requirements.
+            The multi-threaded simulation, and the discard() methods
+            of the path generator it requires, are only compiled for
+            engines on which this method is called.
+        */
+        void setThreads(Size threads);
       protected:
         McSimulation(bool antitheticVariate,
                      bool controlVariate)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), threads_(1),
+          addSamplesOnThreads_(nullptr) {}
         virtual ext::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual ext::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +107,10 @@ namespace QuantLib {
         
         mutable ext::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_;
+      private:
+        void addSamples(Size samples) const;
+        void (MonteCarloModel<MC,RNG,S>::*addSamplesOnThreads_)(Size, Size);
     };
 
 
@@ -109,7 +123,7 @@ namespace QuantLib {
         Size sampleNumber =
             mcModel_->sampleAccumulator().samples();
         if (sampleNumber<minSamples) {
-            mcModel_->addSamples(minSamples-sampleNumber);
+            addSamples(minSamples-sampleNumber);
             sampleNumber = mcModel_->sampleAccumulator().samples();
         }
 
@@ -131,7 +145,7 @@ namespace QuantLib {
             // do not exceed maxSamples
             nextBatch = std::min(nextBatch, maxSamples-sampleNumber);
             sampleNumber += nextBatch;
-            mcModel_->addSamples(nextBatch);
+            addSamples(nextBatch);
             error = result_type(mcModel_->sampleAccumulator().errorEstimate());
         }
 
@@ -149,7 +163,7 @@ namespace QuantLib {
                    "number of already simulated samples (" << sampleNumber
                    << ") greater than requested samples (" << samples << ")");
 
-        mcModel_->addSamples(samples-sampleNumber);
+        addSamples(samples-sampleNumber);
 
         return result_type(mcModel_->sampleAccumulator().mean());
     }
@@ -206,6 +220,21 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::setThreads(Size threads) {
+        detail::checkThreads(threads);
+        threads_ = threads;
+        addSamplesOnThreads_ = &MonteCarloModel<MC,RNG,S>::addSamples;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::addSamples(Size samples) const {
+        if (threads_ == 1)
+            mcModel_->addSamples(samples);
+        else
+            ((*mcModel_).*addSamplesOnThreads_)(samples, threads_);
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
@@ -51,21 +51,37 @@ namespace QuantLib {
             QL_REQUIRE(arguments_.settlementType == Settlement::Physical,
                        "cash-settled swaptions not priced with G2 engine");
 
+            results_.value =  model_->swaption(arguments_,
+                                               fixedRate(arguments_),
+                                               range_, intervals_);
+        }
+
+        /*! Derivatives of the price of the given swaption with
+            respect to the model parameters, in the order of
+            G2::params().
+        */
+        Array priceGradient(const Swaption::arguments& arguments) const {
+            QL_REQUIRE(arguments.settlementType == Settlement::Physical,
+                       "cash-settled swaptions not priced with G2 engine");
+
+            return model_->swaptionGradient(arguments,
+                                            fixedRate(arguments),
+                                            range_, intervals_);
+        }
+
+      private:
+        Rate fixedRate(const Swaption::arguments& arguments) const {
             // adjust the fixed rate of the swap for the spread on the
             // floating leg (which is not taken into account by the
             // model)
-            VanillaSwap swap = *arguments_.swap;
+            VanillaSwap swap = *arguments.swap;
             swap.setPricingEngine(ext::shared_ptr<PricingEngine>(
                   new DiscountingSwapEngine(model_->termStructure(), false)));
             Spread correction = swap.spread() *
                 std::fabs(swap.floatingLegBPS() / swap.fixedLegBPS());
-            Rate fixedRate = swap.fixedRate() - correction;
-
-            results_.value =  model_->swaption(arguments_, fixedRate,
-                                               range_, intervals_);
+            return swap.fixedRate() - correction;
         }
 
-      private:
         Real range_;
         Size intervals_;
     };
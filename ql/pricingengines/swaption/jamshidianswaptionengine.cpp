@@ -19,6 +19,8 @@
 */
 
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <utility>
 
@@ -54,17 +56,27 @@ namespace QuantLib {
         const ext::shared_ptr<OneFactorAffineModel>& model_;
     };
 
-    void JamshidianSwaptionEngine::calculate() const {
+    struct JamshidianSwaptionEngine::Decomposition {
+        Time maturity, valueTime;
+        std::vector<Time> fixedPayTimes;
+        std::vector<Real> amounts;
+        Rate rStar;
+        Option::Type type;
+    };
+
+    JamshidianSwaptionEngine::Decomposition
+    JamshidianSwaptionEngine::decompose(
+                                const Swaption::arguments& arguments) const {
 
-        QL_REQUIRE(arguments_.settlementMethod != Settlement::ParYieldCurve,
+        QL_REQUIRE(arguments.settlementMethod != Settlement::ParYieldCurve,
                    "cash settled (ParYieldCurve) swaptions not priced with "
                    "JamshidianSwaptionEngine");
 
-        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+        QL_REQUIRE(arguments.exercise->type() == Exercise::European,
                    "cannot use the Jamshidian decomposition "
                    "on exotic swaptions");
 
-        QL_REQUIRE(arguments_.swap->spread() == 0.0, "non zero spread (" << arguments_.swap->spread() << ") not allowed"); // PC
+        QL_REQUIRE(arguments.swap->spread() == 0.0, "non zero spread (" << arguments.swap->spread() << ") not allowed"); // PC
 
         Date referenceDate;
         DayCounter dayCounter;
@@ -79,48 +91,143 @@ namespace QuantLib {
             dayCounter = termStructure_->dayCounter();
         }
 
-        std::vector<Real> amounts(arguments_.fixedCoupons);
-        amounts.back() += arguments_.nominal;
+        Decomposition d;
+        d.amounts = arguments.fixedCoupons;
+        d.amounts.back() += arguments.nominal;
 
-        Real maturity = dayCounter.yearFraction(referenceDate,
-                                                arguments_.exercise->date(0));
+        d.maturity = dayCounter.yearFraction(referenceDate,
+                                             arguments.exercise->date(0));
 
-        std::vector<Time> fixedPayTimes(arguments_.fixedPayDates.size());
-        Time valueTime = dayCounter.yearFraction(referenceDate,arguments_.fixedResetDates[0]);
-        for (Size i=0; i<fixedPayTimes.size(); i++)
-            fixedPayTimes[i] = dayCounter.yearFraction(referenceDate,
-                                                       arguments_.fixedPayDates[i]);
+        d.fixedPayTimes.resize(arguments.fixedPayDates.size());
+        d.valueTime = dayCounter.yearFraction(referenceDate,
+                                              arguments.fixedResetDates[0]);
+        for (Size i=0; i<d.fixedPayTimes.size(); i++)
+            d.fixedPayTimes[i] = dayCounter.yearFraction(referenceDate,
+                                                    arguments.fixedPayDates[i]);
 
-        rStarFinder finder(*model_, arguments_.nominal, maturity, valueTime,
-                           fixedPayTimes, amounts);
+        rStarFinder finder(*model_, arguments.nominal, d.maturity, d.valueTime,
+                           d.fixedPayTimes, d.amounts);
         Brent s1d;
         Rate minStrike = -10.0;
         Rate maxStrike = 10.0;
         s1d.setMaxEvaluations(10000);
         s1d.setLowerBound(minStrike);
         s1d.setUpperBound(maxStrike);
-        Rate rStar = s1d.solve(finder, 1e-8, 0.05, minStrike, maxStrike);
+        d.rStar = s1d.solve(finder, 1e-8, 0.05, minStrike, maxStrike);
+
+        d.type = arguments.type==Swap::Payer ? Option::Put : Option::Call;
+        return d;
+    }
 
-        Option::Type w = arguments_.type==Swap::Payer ? Option::Put : Option::Call;
+    void JamshidianSwaptionEngine::calculate() const {
+
+        const Decomposition d = decompose(arguments_);
         Size size = arguments_.fixedCoupons.size();
 
         Real value = 0.0;
-        Real B = model_->discountBond(maturity, valueTime, rStar);
+        Real B = model_->discountBond(d.maturity, d.valueTime, d.rStar);
         for (Size i=0; i<size; i++) {
-            Real fixedPayTime =
-                dayCounter.yearFraction(referenceDate,
-                                        arguments_.fixedPayDates[i]);
-            Real strike = model_->discountBond(maturity,
-                                               fixedPayTime,
-                                               rStar) / B;
+            Real strike = model_->discountBond(d.maturity,
+                                               d.fixedPayTimes[i],
+                                               d.rStar) / B;
             // Looks like the swaption decomposed into individual options adjusted for maturity. Each individual option is valued by Hull-White (or other one-factor model).
             Real dboValue = model_->discountBondOption(
-                                               w, strike, maturity, valueTime,
-                                               fixedPayTime);
-            value += amounts[i]*dboValue;
+                                               d.type, strike, d.maturity,
+                                               d.valueTime,
+                                               d.fixedPayTimes[i]);
+            value += d.amounts[i]*dboValue;
         }
         results_.value = value;
     }
 
+    namespace {
+
+        // B(t,t+tau) in the Hull-White model and its derivative
+        // with respect to the mean reversion
+        Real hwB(Real a, Time tau) {
+            return (1.0 - std::exp(-a*tau))/a;
+        }
+
+        Real hwBPrime(Real a, Time tau) {
+            return (tau*std::exp(-a*tau) - hwB(a, tau))/a;
+        }
+
+    }
+
+    Array JamshidianSwaptionEngine::priceGradient(
+                                const Swaption::arguments& arguments) const {
+
+        const ext::shared_ptr<HullWhite> hw =
+            ext::dynamic_pointer_cast<HullWhite>(*model_);
+        if (hw == nullptr || hw->a() < std::sqrt(QL_EPSILON))
+            return Array();
+
+        const Decomposition d = decompose(arguments);
+        const Real a = hw->a(), sigma = hw->sigma();
+        const Handle<YieldTermStructure>& ts = hw->termStructure();
+        const Time T0 = d.maturity, s = d.valueTime;
+        const Size size = d.fixedPayTimes.size();
+
+        // log A(T0,T) = log P(T)/P(T0) + B f - sigma^2 B^2 C / 4
+        // with B = B(T0,T) and C = B(0,2 T0)
+        const Rate f = ts->forwardRate(T0, T0, Continuous, NoFrequency);
+        const Real C = hwB(a, 2.0*T0), dC = hwBPrime(a, 2.0*T0);
+        const Real Bs = hwB(a, s-T0), dBs = hwBPrime(a, s-T0);
+        const Real dLogAsda = dBs*f - 0.25*sigma*sigma*(2.0*Bs*dBs*C + Bs*Bs*dC);
+        const Real dLogAsds = -0.5*sigma*Bs*Bs*C;
+
+        // the strikes are K_i = A_i/A_s exp(-(B_i-B_s) r*); r* moves
+        // with the parameters so that sum_i c_i K_i stays constant
+        std::vector<Real> strikes(size), dB(size);
+        std::vector<Real> dLogKda(size), dLogKds(size);
+        Real sumB = 0.0, sumA = 0.0, sumS = 0.0;
+        const Real discountS = hw->discountBond(T0, s, d.rStar);
+        for (Size i=0; i<size; ++i) {
+            const Time T = d.fixedPayTimes[i];
+            const Real Bi = hwB(a, T-T0), dBi = hwBPrime(a, T-T0);
+            strikes[i] = hw->discountBond(T0, T, d.rStar)/discountS;
+            dB[i] = Bi - Bs;
+            dLogKda[i] = dBi*f - 0.25*sigma*sigma*(2.0*Bi*dBi*C + Bi*Bi*dC)
+                - dLogAsda - (dBi - dBs)*d.rStar;
+            dLogKds[i] = -0.5*sigma*Bi*Bi*C - dLogAsds;
+            const Real weight = d.amounts[i]*strikes[i];
+            sumB += weight*dB[i];
+            sumA += weight*dLogKda[i];
+            sumS += weight*dLogKds[i];
+        }
+        const Real dRStarda = sumA/sumB, dRStards = sumS/sumB;
+
+        const Real omega = d.type == Option::Call ? 1.0 : -1.0;
+        const DiscountFactor discountStart = ts->discount(s);
+        Array gradient(2, 0.0);
+        for (Size i=0; i<size; ++i) {
+            const Time T = d.fixedPayTimes[i];
+            const Real e = std::exp(-2.0*a*(s-T0)) - std::exp(-2.0*a*s)
+                - 2.0*(std::exp(-a*(s+T-2.0*T0)) - std::exp(-a*(s+T)))
+                + std::exp(-2.0*a*(T-T0)) - std::exp(-2.0*a*T);
+            const Real de = -2.0*(s-T0)*std::exp(-2.0*a*(s-T0))
+                + 2.0*s*std::exp(-2.0*a*s)
+                + 2.0*(s+T-2.0*T0)*std::exp(-a*(s+T-2.0*T0))
+                - 2.0*(s+T)*std::exp(-a*(s+T))
+                - 2.0*(T-T0)*std::exp(-2.0*a*(T-T0))
+                + 2.0*T*std::exp(-2.0*a*T);
+            const Real v = sigma/(a*std::sqrt(2.0*a))*std::sqrt(std::max(e, 0.0));
+            const Real dvda = e > 0.0 ? v*(0.5*de/e - 1.5/a) : 0.0;
+            const Real dvds = v/sigma;
+
+            const Real k = discountStart*strikes[i];
+            const Real forward = ts->discount(T);
+            const Real dPdk = -omega*blackFormulaCashItmProbability(
+                                                   d.type, k, forward, v);
+            const Real dPdv = blackFormulaStdDevDerivative(k, forward, v);
+
+            const Real dkda = k*(dLogKda[i] - dB[i]*dRStarda);
+            const Real dkds = k*(dLogKds[i] - dB[i]*dRStards);
+            gradient[0] += d.amounts[i]*(dPdk*dkda + dPdv*dvda);
+            gradient[1] += d.amounts[i]*(dPdk*dkds + dPdv*dvds);
+        }
+        return gradient;
+    }
+
 }
 
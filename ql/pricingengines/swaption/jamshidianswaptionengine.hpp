@@ -58,7 +58,20 @@ namespace QuantLib {
         }
         void calculate() const override;
 
+        /*! Derivatives of the price of the given swaption with
+            respect to the model parameters, in the order of
+            HullWhite::params().  They are obtained by differentiating
+            the decomposition, including the dependence of the
+            critical rate on the parameters.
+
+            An empty array is returned unless the model is a
+            HullWhite model with a mean reversion not close to zero.
+        */
+        Array priceGradient(const Swaption::arguments& arguments) const;
+
       private:
+        struct Decomposition;
+        Decomposition decompose(const Swaption::arguments& arguments) const;
         Handle<YieldTermStructure> termStructure_;
         class rStarFinder;
         friend class rStarFinder;
@@ -159,6 +159,18 @@ namespace QuantLib {
 
       Real operator()(Real phi) const;
 
+      // the part of the exponent not depending on the strike, and
+      // the add-on term of the engine; they are shared by all strikes
+      // with the same maturity.  Must be called at increasing nodes
+      // when using the branch correction.
+      void exponent(Real phi,
+                    std::complex<Real>& e,
+                    std::complex<Real>& addOnTerm) const;
+      // the integrand at phi != 0 given the results of exponent()
+      Real integrand(Real phi,
+                     const std::complex<Real>& e,
+                     const std::complex<Real>& addOnTerm) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -248,6 +260,46 @@ namespace QuantLib {
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
     {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        std::complex<Real> e, addOnTerm;
+        exponent(phi, e, addOnTerm);
+        return integrand(phi, e, addOnTerm);
+    }
+
+    Real AnalyticHestonEngine::Fj_Helper::integrand(
+        Real phi,
+        const std::complex<Real>& e,
+        const std::complex<Real>& addOnTerm) const {
+        return std::exp(e + std::complex<Real>(0.0, phi*(dd_-sx_))
+                        + addOnTerm).imag()/phi;
+    }
+
+    void AnalyticHestonEngine::Fj_Helper::exponent(
+        Real phi,
+        std::complex<Real>& e,
+        std::complex<Real>& addOnTerm) const {
         const Real rpsig(rsigma_*phi);
 
         const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
@@ -255,58 +307,26 @@ namespace QuantLib {
             std::sqrt(t1*t1 - sigma2_*phi
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
-        const std::complex<Real> addOnTerm =
+        addOnTerm =
             engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                e = v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                    + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g);
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                e = v0_*td*(1.0-ex)/(1.0-p*ex)
+                    + (kappa_*theta_)*(td*term_-2.0*g/sigma2_);
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -316,10 +336,10 @@ namespace QuantLib {
             std::complex<Real> g;
 
             // the exp of the following expression is needed.
-            const std::complex<Real> e = std::log(p)+d*term_;
+            const std::complex<Real> e0 = std::log(p)+d*term_;
 
             // does it fit to the machine precision?
-            if (std::exp(-e.real()) > QL_EPSILON) {
+            if (std::exp(-e0.real()) > QL_EPSILON) {
                 g = std::log((1.0 - p/ex)/(1.0 - p));
             } else {
                 // use a "big phi" approximation
@@ -352,11 +372,8 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            e = v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g);
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -414,6 +431,11 @@ namespace QuantLib {
                         == std::complex<Real>(0.0),
                    "only Heston model is supported");
 
+        return (*this)(u, enginePtr_->chF(std::complex<Real>(u, -0.5), term_));
+    }
+
+    Real AnalyticHestonEngine::AP_Helper::operator()(
+        Real u, const std::complex<Real>& chF) const {
         const std::complex<Real> z(u, -0.5);
 
         std::complex<Real> phiBS;
@@ -432,7 +454,7 @@ namespace QuantLib {
         }
 
         return (std::exp(std::complex<Real>(0.0, u*freq_))
-            * (phiBS - enginePtr_->chF(z, term_)) / (u*u + 0.25)).real();
+            * (phiBS - chF) / (u*u + 0.25)).real();
     }
 
     Real AnalyticHestonEngine::AP_Helper::controlVariateValue() const {
@@ -506,6 +528,156 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::chFGradient(const std::complex<Real>& z,
+                                           Time t,
+                                           std::complex<Real> gradient[5]) const {
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real sigma2 = sigma*sigma;
+        const std::complex<Real> mz(z.imag(), -z.real()); // -i*z
+        const std::complex<Real> zz = z*z + std::complex<Real>(-z.imag(), z.real());
+
+        // same as in chF
+        const std::complex<Real> g = kappa + rho*sigma*mz;
+        const std::complex<Real> D = std::sqrt(g*g + zz*sigma2);
+        const std::complex<Real> G = (g-D)/(g+D);
+        const std::complex<Real> e = std::exp(-D*t);
+        const std::complex<Real> h = g - D;
+        const std::complex<Real> q = (1.0-e)/(1.0-G*e);
+        const std::complex<Real> L = std::log((1.0-G*e)/(1.0-G));
+
+        const std::complex<Real> lnChF =
+            v0/sigma2*q*h + kappa*theta/sigma2*(h*t - 2.0*L);
+        const std::complex<Real> chF = std::exp(lnChF);
+
+        // theta and v0 only appear as factors
+        gradient[0] = chF*kappa/sigma2*(h*t - 2.0*L);
+        gradient[4] = chF*q*h/sigma2;
+
+        // kappa, sigma and rho enter through g, D and the factors
+        // 1/sigma^2 and kappa/sigma^2
+        const std::complex<Real> dgs[3] = { 1.0, rho*mz, sigma*mz };
+        const Real dsigma2s[3] = { 0.0, 2.0*sigma, 0.0 };
+        for (Size k=0; k<3; ++k) {
+            const std::complex<Real> dg = dgs[k];
+            const Real dsigma2 = dsigma2s[k];
+
+            const std::complex<Real> dD = (g*dg + 0.5*dsigma2*zz)/D;
+            const std::complex<Real> de = -t*e*dD;
+            const std::complex<Real> dG = 2.0*(D*dg - g*dD)/((g+D)*(g+D));
+            const std::complex<Real> dh = dg - dD;
+            const std::complex<Real> dGe = dG*e + G*de;
+            const std::complex<Real> dq =
+                (-de*(1.0-G*e) + (1.0-e)*dGe)/((1.0-G*e)*(1.0-G*e));
+            const std::complex<Real> dL = -dGe/(1.0-G*e) + dG/(1.0-G);
+
+            const Real dkappa = (k == 0) ? 1.0 : 0.0;
+            const Real dInvSigma2 = -dsigma2/(sigma2*sigma2);
+
+            const std::complex<Real> dLnChF =
+                v0*dInvSigma2*q*h + v0/sigma2*(dq*h + q*dh)
+                + (dkappa*theta/sigma2 + kappa*theta*dInvSigma2)*(h*t - 2.0*L)
+                + kappa*theta/sigma2*(dh*t - 2.0*dL);
+
+            gradient[k+1] = chF*dLnChF;
+        }
+    }
+
+    Array AnalyticHestonEngine::priceGradient(Real strike,
+                                              const Date& maturity) const {
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Time term = process->time(maturity);
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        if (sigma <= 1e-4)
+            return Array();
+
+        std::complex<Real> addOn;
+        std::vector<std::complex<Real> > dAddOn;
+        if (!addOnTermGradient(std::complex<Real>(0.0, -0.5), term,
+                               addOn, dAddOn))
+            return Array();
+        const Size n = 5 + dAddOn.size();
+
+        // Lewis' formula: the price of a call is
+        // D*(F - sqrt(K*F)/pi*int_0^inf Re(exp(i*u*log(F/K))
+        //                                  *chF(u - i/2)) / (u^2 + 1/4) du)
+        // and only chF depends on the model parameters.
+        const Real fwdPrice = spotPrice*dividendDiscount/riskFreeDiscount;
+        const Real freq = std::log(fwdPrice/strike);
+        const Real c_inf =
+            std::sqrt(1.0-rho*rho)*(v0 + kappa*theta*term)/sigma;
+
+        // with a Gaussian quadrature, the nodes are the same for each
+        // parameter and the gradient is only computed once per node
+        const bool shared = integration_->isGaussianQuadrature();
+        std::vector<Real> nodeValues;
+
+        Array gradient(n);
+        std::vector<Real> values(n);
+        for (Size j=0; j<n; ++j) {
+            Size k = 0;
+            gradient[j] = integration_->calculate(c_inf,
+                [&](Real u) -> Real {
+                    if (shared && j > 0)
+                        return nodeValues[n*(k++) + j];
+
+                    // chF times exp(addOn): the Heston derivatives
+                    // are scaled, the add-on ones multiply the product
+                    const std::complex<Real> z(u, -0.5);
+                    std::complex<Real> dChF[5];
+                    chFGradient(z, term, dChF);
+                    addOnTermGradient(z, term, addOn, dAddOn);
+                    const std::complex<Real> f =
+                        std::exp(std::complex<Real>(0.0, u*freq) + addOn)
+                        /(u*u + 0.25);
+
+                    for (Size l=0; l<5; ++l)
+                        values[l] = (f*dChF[l]).real();
+                    if (n > 5) {
+                        const std::complex<Real> fChF = f*chF(z, term);
+                        for (Size l=5; l<n; ++l)
+                            values[l] = (fChF*dAddOn[l-5]).real();
+                    }
+                    if (shared)
+                        nodeValues.insert(nodeValues.end(),
+                                          values.begin(), values.end());
+                    return values[j];
+                }) * (-riskFreeDiscount*std::sqrt(strike*fwdPrice)/M_PI);
+        }
+
+        return gradient;
+    }
+
+    bool AnalyticHestonEngine::addOnTermGradient(
+                        const std::complex<Real>&,
+                        Time t,
+                        std::complex<Real>& addOn,
+                        std::vector<std::complex<Real> >& gradient) const {
+        addOn = 0.0;
+        gradient.clear();
+        return addOnTerm(1.0, t, 1) == std::complex<Real>(0.0)
+            && addOnTerm(1.0, t, 2) == std::complex<Real>(0.0);
+    }
+
     std::complex<Real> AnalyticHestonEngine::lnChF(
         const std::complex<Real>& z, Time T) const {
         return std::log(chF(z, T));
@@ -692,22 +864,234 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
-        doCalculation(riskFreeDiscount,
-                      dividendDiscount,
-                      spotPrice,
-                      strikePrice,
-                      term,
-                      model_->kappa(),
-                      model_->theta(),
-                      model_->sigma(),
-                      model_->v0(),
-                      model_->rho(),
-                      *payoff,
-                      *integration_,
-                      cpxLog_,
-                      this,
-                      results_.value,
-                      evaluations_);
+        results_.value = priceVanillaPayoff(payoff->optionType(),
+                                            strikePrice,
+                                            term,
+                                            riskFreeDiscount,
+                                            dividendDiscount,
+                                            spotPrice,
+                                            evaluations_);
+    }
+
+    Array AnalyticHestonEngine::priceVanillaPayoffs(
+                              const std::vector<Option::Type>& optionTypes,
+                              const Array& strikes,
+                              const Date& maturity) const {
+        QL_REQUIRE(optionTypes.size() == strikes.size(),
+                   "wrong number of option types (" << optionTypes.size()
+                   << ") for " << strikes.size() << " strikes");
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        Array prices(strikes.size());
+        evaluations_ = 0;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Size evaluations;
+            prices[i] = priceVanillaPayoff(optionTypes[i],
+                                           strikes[i],
+                                           term,
+                                           riskFreeDiscount,
+                                           dividendDiscount,
+                                           spotPrice,
+                                           evaluations);
+            evaluations_ += evaluations;
+        }
+        return prices;
+    }
+
+    void AnalyticHestonEngine::update() {
+        for (auto& nodeValues : nodeValues_)
+            nodeValues.term = Null<Time>();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    Real AnalyticHestonEngine::priceVanillaPayoff(Option::Type type,
+                                                  Real strikePrice,
+                                                  Time term,
+                                                  Real riskFreeDiscount,
+                                                  Real dividendDiscount,
+                                                  Real spotPrice,
+                                                  Size& evaluations) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        Real value;
+
+        if (!integration_->isGaussianQuadrature()) {
+            // the nodes depend on the integrand; nothing to share
+            doCalculation(riskFreeDiscount, dividendDiscount, spotPrice,
+                          strikePrice, term, kappa, theta, sigma, v0, rho,
+                          PlainVanillaPayoff(type, strikePrice),
+                          *integration_, cpxLog_, this, value, evaluations);
+            return value;
+        }
+
+        // the stored node values are only valid for the current
+        // parameters; these might have changed without notification
+        // if updates were disabled.
+        const Array parameters = model_->params();
+        if (parameters != nodeValuesParameters_) {
+            for (auto& nodeValues : nodeValues_)
+                nodeValues.term = Null<Time>();
+            nodeValuesParameters_ = parameters;
+        }
+
+        // same as doCalculation, but for the integrals
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+
+        evaluations = 0;
+
+        switch(cpxLog_) {
+          case Gatheral:
+          case BranchCorrection: {
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+            const Real p1 = integrate(c_inf,
+                Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, this,
+                          cpxLog_, term, strikePrice, ratio, 1), term, 1)/M_PI;
+            evaluations += integration_->numberOfEvaluations();
+
+            const Real p2 = integrate(c_inf,
+                Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, this,
+                          cpxLog_, term, strikePrice, ratio, 2), term, 2)/M_PI;
+            evaluations += integration_->numberOfEvaluations();
+
+            switch (type)
+            {
+              case Option::Call:
+                value = spotPrice*dividendDiscount*(p1+0.5)
+                               - strikePrice*riskFreeDiscount*(p2+0.5);
+                break;
+              case Option::Put:
+                value = spotPrice*dividendDiscount*(p1-0.5)
+                               - strikePrice*riskFreeDiscount*(p2-0.5);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+          }
+          break;
+          case AndersenPiterbarg:
+          case AndersenPiterbargOptCV:
+          case AsymptoticChF:
+          case OptimalCV: {
+            const Real c_inf =
+                std::sqrt(1.0-rho*rho)*(v0 + kappa*theta*term)/sigma;
+
+            const Real fwdPrice = spotPrice / ratio;
+
+            // no integration limit is needed by Gaussian quadratures
+            AP_Helper cvHelper(term, fwdPrice, strikePrice,
+                (cpxLog_ == OptimalCV)
+                    ? optimalControlVariate(term, v0, kappa, theta, sigma, rho)
+                    : cpxLog_,
+                this
+            );
+
+            const Real cvValue = cvHelper.controlVariateValue();
+
+            const Real h_cv = integrate(c_inf, cvHelper, term)
+                * std::sqrt(strikePrice * fwdPrice)/M_PI;
+            evaluations += integration_->numberOfEvaluations();
+
+            switch (type)
+            {
+              case Option::Call:
+                value = (cvValue + h_cv)*riskFreeDiscount;
+                break;
+              case Option::Put:
+                value = (cvValue + h_cv - (fwdPrice - strikePrice))*riskFreeDiscount;
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+          }
+          break;
+
+          default:
+            QL_FAIL("unknown complex log formula");
+        }
+
+        return value;
+    }
+
+    Real AnalyticHestonEngine::integrate(Real c_inf,
+                                         const Fj_Helper& f,
+                                         Time term,
+                                         Size j) const {
+        // the nodes are visited in the same order for all strikes, so
+        // that the k-th evaluation uses the k-th stored values.  At
+        // phi = 0 the integrand has no exponent to share.
+        NodeValues& nodeValues = nodeValues_[j];
+        std::vector<std::complex<Real> >& values = nodeValues.values;
+        if (nodeValues.term != term) {
+            // invalid until the integration succeeds
+            nodeValues.term = Null<Time>();
+            values.clear();
+            const Real result = integration_->calculate(c_inf,
+                [&](Real phi) -> Real {
+                    if (phi == 0.0)
+                        return f(phi);
+                    std::complex<Real> e, addOnTerm;
+                    f.exponent(phi, e, addOnTerm);
+                    values.push_back(e);
+                    values.push_back(addOnTerm);
+                    return f.integrand(phi, e, addOnTerm);
+                });
+            nodeValues.term = term;
+            return result;
+        }
+
+        Size k = 0;
+        return integration_->calculate(c_inf,
+            [&](Real phi) -> Real {
+                if (phi == 0.0)
+                    return f(phi);
+                const Real result = f.integrand(phi, values[k], values[k+1]);
+                k += 2;
+                return result;
+            });
+    }
+
+    Real AnalyticHestonEngine::integrate(Real c_inf,
+                                         const AP_Helper& f,
+                                         Time term) const {
+        NodeValues& nodeValues = nodeValues_[0];
+        std::vector<std::complex<Real> >& values = nodeValues.values;
+        if (nodeValues.term != term) {
+            nodeValues.term = Null<Time>();
+            values.clear();
+            const Real result = integration_->calculate(c_inf,
+                [&](Real u) -> Real {
+                    QL_REQUIRE(   addOnTerm(u, term, 1) == std::complex<Real>(0.0)
+                               && addOnTerm(u, term, 2) == std::complex<Real>(0.0),
+                               "only Heston model is supported");
+                    values.push_back(chF(std::complex<Real>(u, -0.5), term));
+                    return f(u, values.back());
+                });
+            nodeValues.term = term;
+            return result;
+        }
+
+        Size k = 0;
+        return integration_->calculate(c_inf,
+            [&](Real u) -> Real { return f(u, values[k++]); });
     }
 
 
@@ -811,6 +1195,10 @@ namespace QuantLib {
         }
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return gaussianQuadrature_ != nullptr;
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
             || intAlgo_ == GaussKronrod
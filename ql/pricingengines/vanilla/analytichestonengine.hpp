@@ -33,6 +33,7 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <vector>
 
 namespace QuantLib {
 
@@ -129,9 +130,44 @@ namespace QuantLib {
         std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
+        void update() override;
         void calculate() const override;
         Size numberOfEvaluations() const;
 
+        /*! Prices European plain-vanilla options with the given types
+            and strikes, all expiring on the given date.
+
+            With a non-adaptive Gaussian quadrature, the nodes of the
+            integration don't depend on the strike; the part of the
+            integrand that doesn't depend on it either, i.e., the
+            characteristic function, is then evaluated once per node
+            and shared by all strikes.  The values for the last
+            maturity are also reused by calculate() when pricing
+            several options with the same maturity in a row, as when
+            calibrating to a surface ordered by expiry; they are
+            discarded when the engine is notified.  The results equal
+            those returned by calculate().
+        */
+        Array priceVanillaPayoffs(const std::vector<Option::Type>& optionTypes,
+                                  const Array& strikes,
+                                  const Date& maturity) const;
+
+        /*! Derivatives of the price of a European plain-vanilla
+            option with respect to the model parameters, in the order
+            of HestonModel::params(); they are the same for calls and
+            puts.  They are obtained by differentiating the
+            characteristic function in Lewis' formula and integrating
+            with the engine's integration method.
+
+            Engines adding a term to the characteristic function
+            (see addOnTermGradient) append the derivatives with
+            respect to their further parameters, as the Bates engines
+            do.  An empty array is returned if the add-on term can't
+            be differentiated or if the volatility of variance is
+            close to zero.
+        */
+        Array priceGradient(Real strike, const Date& maturity) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -161,6 +197,8 @@ namespace QuantLib {
                       const AnalyticHestonEngine* enginePtr);
 
             Real operator()(Real u) const;
+            //! integrand given the value of chF at (u, -0.5)
+            Real operator()(Real u, const std::complex<Real>& chF) const;
             Real controlVariateValue() const;
 
           private:
@@ -179,13 +217,49 @@ namespace QuantLib {
                                              Time t,
                                              Size j) const;
 
+        /*! Add-on term of the logarithm of chF at z and its
+            derivatives with respect to the model parameters following
+            the Heston ones, in the order of params().  The default
+            implementation returns false, meaning that they are not
+            available, if addOnTerm() is not null.
+        */
+        virtual bool addOnTermGradient(
+                         const std::complex<Real>& z,
+                         Time t,
+                         std::complex<Real>& addOn,
+                         std::vector<std::complex<Real> >& gradient) const;
+
       private:
         class Fj_Helper;
 
+        Real priceVanillaPayoff(Option::Type type,
+                                Real strikePrice,
+                                Time term,
+                                Real riskFreeDiscount,
+                                Real dividendDiscount,
+                                Real spotPrice,
+                                Size& evaluations) const;
+        Real integrate(Real c_inf, const Fj_Helper& f, Time term, Size j) const;
+        Real integrate(Real c_inf, const AP_Helper& f, Time term) const;
+        // gradient of chF with respect to theta, kappa, sigma, rho, v0
+        void chFGradient(const std::complex<Real>& z,
+                         Time t,
+                         std::complex<Real> gradient[5]) const;
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const ext::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_;
+
+        // strike-independent integrand values at the integration
+        // nodes for the last maturity (see priceVanillaPayoffs)
+        struct NodeValues {
+            Time term = Null<Time>();
+            std::vector<std::complex<Real> > values;
+        };
+        // by integrand; the storage is reused for the next maturity
+        mutable NodeValues nodeValues_[3];
+        mutable Array nodeValuesParameters_;
     };
 
 
@@ -227,6 +301,7 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
 
       private:
         enum Algorithm
@@ -49,23 +49,20 @@ namespace QuantLib {
     void AnalyticHestonHullWhiteEngine::update() {
         a_ = hullWhiteModel_->params()[0];
         sigma_ = hullWhiteModel_->params()[1];
+        t_ = Null<Time>();
 
         AnalyticHestonEngine::update();
     }
 
-    void AnalyticHestonHullWhiteEngine::calculate() const {
-
-        const Real t = model_->process()->time(arguments_.exercise->lastDate());
+    Real AnalyticHestonHullWhiteEngine::m(Time t) const {
         if (a_*t > std::pow(QL_EPSILON, 0.25)) {
-            m_ = sigma_*sigma_/(2*a_*a_)
+            return sigma_*sigma_/(2*a_*a_)
                 *(t+2/a_*std::exp(-a_*t)-1/(2*a_)*std::exp(-2*a_*t)-3/(2*a_));
         }
         else {
             // low-a algebraic limit
-            m_ = 0.5*sigma_*sigma_*t*t*t*(1/3.0-0.25*a_*t+7/60.0*a_*a_*t*t);
+            return 0.5*sigma_*sigma_*t*t*t*(1/3.0-0.25*a_*t+7/60.0*a_*a_*t*t);
         }
-
-        AnalyticHestonEngine::calculate();
     }
 
 }
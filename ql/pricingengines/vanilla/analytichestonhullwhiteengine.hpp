@@ -76,7 +76,6 @@ namespace QuantLib {
 
 
         void update() override;
-        void calculate() const override;
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
@@ -84,14 +83,22 @@ namespace QuantLib {
         const ext::shared_ptr<HullWhite> hullWhiteModel_;
 
       private:
+        Real m(Time t) const;
+
+        // m(t) for the last maturity asked
+        mutable Time t_;
         mutable Real m_;
         mutable Real a_, sigma_;
     };
 
     inline
     std::complex<Real> AnalyticHestonHullWhiteEngine::addOnTerm(Real u,
-                                                                Time,
+                                                                Time t,
                                                                 Size j) const {
+        if (t != t_) {
+            m_ = m(t);
+            t_ = t;
+        }
         return std::complex<Real>(-m_*u*u, u*(m_-2*m_*(j-1)));
     }
 
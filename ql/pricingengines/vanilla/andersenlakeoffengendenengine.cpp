@@ -0,0 +1,332 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/functional.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/pricingengines/vanilla/andersenlakeoffengendenengine.hpp>
+#include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Chebyshev extrema on [-1, 1], mapped to times to maturity
+        // as tau = T*((1+x)/2)^2; the last node is tau = 0.
+        Time collocationTime(Size i, Size n, Time maturity) {
+            if (i == n-1)
+                return 0.0;
+            const Real x = std::cos(i*M_PI/(n-1));
+            return maturity*0.25*(1.0+x)*(1.0+x);
+        }
+
+        std::pair<Real, Real> dpm(Time t, Real x, Rate r, Rate q,
+                                  Volatility vol) {
+            const Real v = vol*std::sqrt(t);
+            const Real d = (std::log(x) + (r-q)*t)/v;
+            return std::make_pair(d + 0.5*v, d - 0.5*v);
+        }
+
+    }
+
+    /* The boundary is stored as H = log(B/X)^2, with X the limit of
+       the boundary at expiry, as a Chebyshev interpolation in
+       sqrt(tau); H is smooth and vanishes at tau = 0. */
+    class AndersenLakeOffengendenEngine::Boundary {
+      public:
+        Boundary(Real xmax, Time maturity, const std::vector<Real>& h)
+        : xmax_(xmax), maturity_(maturity), c_(h.size()) {
+            const Size n = h.size();
+            for (Size k=0; k<n; ++k) {
+                Real s = 0.5*(h[0] + ((k % 2 == 0) ? h[n-1] : -h[n-1]));
+                for (Size i=1; i<n-1; ++i)
+                    s += h[i]*std::cos(k*i*M_PI/(n-1));
+                c_[k] = 2.0*s/(n-1);
+            }
+            c_[0] *= 0.5;
+            c_[n-1] *= 0.5;
+        }
+
+        Real operator()(Time tau) const {
+            const Real x = 2.0*std::sqrt(tau/maturity_) - 1.0;
+
+            // Clenshaw's recurrence
+            Real b1 = 0.0, b2 = 0.0;
+            for (Size k=c_.size()-1; k>0; --k) {
+                const Real b = c_[k] + 2.0*x*b1 - b2;
+                b2 = b1;
+                b1 = b;
+            }
+            const Real h = c_[0] + x*b1 - b2;
+
+            return xmax_*std::exp(-std::sqrt(std::max(h, 0.0)));
+        }
+
+      private:
+        Real xmax_;
+        Time maturity_;
+        std::vector<Real> c_;
+    };
+
+
+    AndersenLakeOffengendenEngine::AndersenLakeOffengendenEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        Accuracy accuracy,
+        FixedPointEquation fpEquation)
+    : AndersenLakeOffengendenEngine(
+          std::move(process),
+          accuracy == Fast ? 7 : accuracy == Accurate ? 25 : 51,
+          accuracy == Fast ? 2 : accuracy == Accurate ? 5 : 8,
+          accuracy == Fast ? 7 : accuracy == Accurate ? 13 : 33,
+          accuracy == Fast ? 27 : accuracy == Accurate ? 55 : 201,
+          fpEquation) {}
+
+    AndersenLakeOffengendenEngine::AndersenLakeOffengendenEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        Size l, Size m, Size n, Size p,
+        FixedPointEquation fpEquation)
+    : process_(std::move(process)), l_(l), m_(m), n_(n), p_(p),
+      fpEquation_(fpEquation) {
+        QL_REQUIRE(l_ > 0 && p_ > 0, "positive number of nodes required");
+        QL_REQUIRE(n_ > 1, "at least two collocation nodes required");
+
+        GaussLegendreIntegration fpIntegration(l_);
+        fpNodes_ = fpIntegration.x();
+        fpWeights_ = fpIntegration.weights();
+
+        GaussLegendreIntegration pricingIntegration(p_);
+        pricingNodes_ = pricingIntegration.x();
+        pricingWeights_ = pricingIntegration.weights();
+
+        registerWith(process_);
+    }
+
+    AndersenLakeOffengendenEngine::Boundary
+    AndersenLakeOffengendenEngine::solveBoundary(
+        Real strike, Rate r, Rate q, Volatility vol, Time maturity) const {
+
+        const Real xmax = (q > 0.0) ? strike*std::min(1.0, r/q) : strike;
+
+        // initial guess from the Barone-Adesi-Whaley critical prices
+        const ext::shared_ptr<StrikedTypePayoff> payoff =
+            ext::make_shared<PlainVanillaPayoff>(Option::Put, strike);
+        std::vector<Real> h(n_, 0.0);
+        for (Size i=0; i<n_-1; ++i) {
+            const Time tau = collocationTime(i, n_, maturity);
+            const Real b = std::min(xmax,
+                BaroneAdesiWhaleyApproximationEngine::criticalPrice(
+                    payoff, std::exp(-r*tau), std::exp(-q*tau),
+                    vol*vol*tau));
+            h[i] = square<Real>()(std::log(b/xmax));
+        }
+
+        const bool fpA = (fpEquation_ == FP_A)
+            || (fpEquation_ == Auto && q > r);
+
+        CumulativeNormalDistribution Phi;
+        NormalDistribution phi;
+
+        for (Size k=0; k<m_; ++k) {
+            const Boundary boundary(xmax, maturity, h);
+
+            for (Size i=0; i<n_-1; ++i) {
+                const Time tau = collocationTime(i, n_, maturity);
+                const Real sqrtTau = std::sqrt(tau);
+                const Real b = boundary(tau);
+
+                // integrals over u in [0, tau], with u = tau - z^2
+                Real nInt = 0.0, dInt = 0.0;
+                for (Size j=0; j<l_; ++j) {
+                    const Real z = 0.5*sqrtTau*(1.0 + fpNodes_[j]);
+                    const Real w = 0.5*sqrtTau*fpWeights_[j];
+                    const Time v = z*z;
+                    const std::pair<Real, Real> d =
+                        dpm(v, b/boundary(tau - v), r, q, vol);
+
+                    if (fpA) {
+                        nInt += w*2.0*z*std::exp(-r*v)*Phi(d.second);
+                        dInt += w*2.0*z*std::exp(-q*v)*Phi(d.first);
+                    } else {
+                        nInt += w*2.0*std::exp(-r*v)*phi(d.second)/vol;
+                        dInt += w*2.0*std::exp(-q*v)
+                            *(phi(d.first)/vol + z*Phi(d.first));
+                    }
+                }
+
+                const std::pair<Real, Real> d0 = dpm(tau, b/strike, r, q, vol);
+                Real N, D;
+                if (fpA) {
+                    N = std::exp(-r*tau)*Phi(d0.second) + r*nInt;
+                    D = std::exp(-q*tau)*Phi(d0.first) + q*dInt;
+                } else {
+                    N = std::exp(-r*tau)*phi(d0.second)/(vol*sqrtTau)
+                        + r*nInt;
+                    D = std::exp(-q*tau)*(Phi(d0.first)
+                                          + phi(d0.first)/(vol*sqrtTau))
+                        + q*dInt;
+                }
+
+                const Real bNew = std::min(xmax, strike*N/D);
+                QL_REQUIRE(bNew > 0.0,
+                           "non-positive exercise boundary ("
+                           << bNew << ") at t=" << tau);
+                h[i] = square<Real>()(std::log(bNew/xmax));
+            }
+        }
+
+        return Boundary(xmax, maturity, h);
+    }
+
+    Array AndersenLakeOffengendenEngine::putExerciseBoundary(
+        Real strike, Rate r, Rate q, Volatility vol, Time maturity,
+        const Array& tau) const {
+        QL_REQUIRE(r > 0.0 || q < r,
+                   "early exercise is never optimal for r <= 0 and q >= r");
+        QL_REQUIRE(r > 0.0, "double exercise boundary not handled");
+
+        const Boundary boundary = solveBoundary(strike, r, q, vol, maturity);
+
+        Array b(tau.size());
+        for (Size i=0; i<tau.size(); ++i) {
+            QL_REQUIRE(tau[i] >= 0.0 && tau[i] <= maturity,
+                       "time " << tau[i] << " outside [0, "
+                       << maturity << "]");
+            b[i] = boundary(tau[i]);
+        }
+        return b;
+    }
+
+    AndersenLakeOffengendenEngine::Greeks
+    AndersenLakeOffengendenEngine::putValue(
+        Real spot, Real strike, Rate r, Rate q,
+        Volatility vol, Time maturity) const {
+
+        const Real stdDev = vol*std::sqrt(maturity);
+        const BlackCalculator black(Option::Put, strike,
+                                    spot*std::exp((r-q)*maturity), stdDev,
+                                    std::exp(-r*maturity));
+
+        Greeks greeks = { black.value(), black.delta(spot),
+                          black.gamma(spot), 0.0 };
+
+        if (r <= 0.0 && q >= r) {
+            // early exercise is never optimal
+            greeks.theta = black.theta(spot, maturity);
+            return greeks;
+        }
+        QL_REQUIRE(r > 0.0, "double exercise boundary not handled");
+
+        const Boundary boundary = solveBoundary(strike, r, q, vol, maturity);
+
+        if (spot <= boundary(maturity)) {
+            const Greeks exercised = { strike - spot, -1.0, 0.0, 0.0 };
+            return exercised;
+        }
+
+        // early-exercise premium, integrated over t = T - z^2
+        CumulativeNormalDistribution Phi;
+        NormalDistribution phi;
+
+        const Real sqrtT = std::sqrt(maturity);
+        for (Size j=0; j<p_; ++j) {
+            const Real z = 0.5*sqrtT*(1.0 + pricingNodes_[j]);
+            const Real w = 0.5*sqrtT*pricingWeights_[j]*2.0*z;
+            const Time t = maturity - z*z;
+
+            const std::pair<Real, Real> d =
+                dpm(t, spot/boundary(z*z), r, q, vol);
+            const Real vt = vol*std::sqrt(t);
+            const Real rK = r*strike*std::exp(-r*t);
+            const Real qe = q*std::exp(-q*t);
+            const Real nm = phi(d.second), np = phi(d.first);
+
+            greeks.value +=
+                w*(rK*Phi(-d.second) - qe*spot*Phi(-d.first));
+            greeks.delta +=
+                w*(-rK*nm/(spot*vt) - qe*(Phi(-d.first) - np/vt));
+            greeks.gamma +=
+                w*(rK*nm/(spot*spot*vt)*(1.0 + d.second/vt)
+                   - qe*np/(spot*vt)*(d.first/vt - 1.0));
+        }
+
+        // from the Black-Scholes equation
+        greeks.theta = r*greeks.value - (r-q)*spot*greeks.delta
+            - 0.5*vol*vol*spot*spot*greeks.gamma;
+
+        return greeks;
+    }
+
+    void AndersenLakeOffengendenEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::American,
+                   "not an American option");
+
+        const ext::shared_ptr<AmericanExercise> ex =
+            ext::dynamic_pointer_cast<AmericanExercise>(arguments_.exercise);
+        QL_REQUIRE(ex, "non-American exercise given");
+        QL_REQUIRE(!ex->payoffAtExpiry(), "payoff at expiry not handled");
+
+        const ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const Date maturityDate = ex->lastDate();
+        const Time maturity = process_->time(maturityDate);
+        QL_REQUIRE(maturity > 0.0, "expired option");
+
+        const Real spot = process_->x0();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        const Real strike = payoff->strike();
+        const Rate r = -std::log(
+            process_->riskFreeRate()->discount(maturityDate))/maturity;
+        const Rate q = -std::log(
+            process_->dividendYield()->discount(maturityDate))/maturity;
+        const Volatility vol = std::sqrt(
+            process_->blackVolatility()->blackVariance(maturityDate, strike)
+            / maturity);
+
+        switch (payoff->optionType()) {
+          case Option::Put: {
+              const Greeks greeks =
+                  putValue(spot, strike, r, q, vol, maturity);
+              results_.value = greeks.value;
+              results_.delta = greeks.delta;
+              results_.gamma = greeks.gamma;
+              results_.theta = greeks.theta;
+            }
+            break;
+          case Option::Call: {
+              // put-call symmetry: C(S, K, r, q) = P(K, S, q, r), and
+              // the put is homogeneous of degree one in spot and strike
+              const Greeks greeks =
+                  putValue(strike, spot, q, r, vol, maturity);
+              const Real x = strike/spot;
+              results_.value = greeks.value;
+              results_.delta = greeks.value/spot - x*greeks.delta;
+              results_.gamma = x*x*greeks.gamma;
+              results_.theta = greeks.theta;
+            }
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+}
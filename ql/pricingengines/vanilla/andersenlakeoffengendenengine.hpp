@@ -0,0 +1,113 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file andersenlakeoffengendenengine.hpp
+    \brief American engine based on a fixed-point iteration for the exercise boundary
+*/
+
+#ifndef quantlib_andersen_lake_offengenden_engine_hpp
+#define quantlib_andersen_lake_offengenden_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+
+namespace QuantLib {
+
+    //! American engine using spectral collocation of the exercise boundary
+    /*! The early-exercise boundary of the put is the solution of an
+        integral equation, which is solved by fixed-point iteration on
+        a set of Chebyshev nodes in \f$ \sqrt{\tau} \f$; the option
+        value is then given by the European price plus the integral
+        of the early-exercise premium over the boundary.  Calls are
+        priced as puts by put-call symmetry.  The initial guess for
+        the boundary is given by the Barone-Adesi-Whaley critical
+        prices.
+
+        The accuracy is controlled by the number of quadrature nodes
+        used in the fixed-point equation (\f$ l \f$), the number of
+        fixed-point iterations (\f$ m \f$), the number of collocation
+        nodes (\f$ n \f$) and the number of quadrature nodes used in
+        the final pricing integral (\f$ p \f$).
+
+        Rates and volatility are taken as constant, using their
+        equivalent values at the exercise date.  Value, delta, gamma
+        and theta are returned.
+
+        References:
+
+        L. Andersen, M. Lake, D. Offengenden, "High-performance
+        American option pricing", Journal of Computational Finance,
+        20(1), 39-87 (2016).
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with a finite-difference engine and with
+              values available in literature.
+    */
+    class AndersenLakeOffengendenEngine : public VanillaOption::engine {
+      public:
+        //! predefined accuracy levels
+        enum Accuracy { Fast, Accurate, HighPrecision };
+        //! form of the fixed-point equation
+        /*! FP_A uses the value-matching condition only, FP_B combines
+            it with smooth pasting; the latter is more stable when
+            interest rates exceed the dividend yield.  Auto selects
+            FP_A when the dividend yield exceeds the rate and FP_B
+            otherwise.
+        */
+        enum FixedPointEquation { FP_A, FP_B, Auto };
+
+        explicit AndersenLakeOffengendenEngine(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            Accuracy accuracy = Accurate,
+            FixedPointEquation fpEquation = Auto);
+
+        AndersenLakeOffengendenEngine(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            Size l, Size m, Size n, Size p,
+            FixedPointEquation fpEquation = Auto);
+
+        void calculate() const override;
+
+        //! early-exercise boundary of a put with the given data
+        /*! Returns the boundary at the times \f$ \tau \f$ to maturity
+            given, which must be in \f$ [0, T] \f$.
+        */
+        Array putExerciseBoundary(Real strike, Rate r, Rate q,
+                                  Volatility vol, Time maturity,
+                                  const Array& tau) const;
+
+      private:
+        class Boundary;
+        struct Greeks {
+            Real value, delta, gamma, theta;
+        };
+        Boundary solveBoundary(Real strike, Rate r, Rate q,
+                               Volatility vol, Time maturity) const;
+        Greeks putValue(Real spot, Real strike, Rate r, Rate q,
+                        Volatility vol, Time maturity) const;
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size l_, m_, n_, p_;
+        FixedPointEquation fpEquation_;
+        Array fpNodes_, fpWeights_, pricingNodes_, pricingWeights_;
+    };
+
+}
+
+#endif
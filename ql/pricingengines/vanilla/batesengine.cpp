@@ -23,6 +23,33 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // turns the add-on term l of a model with constant jump
+        // intensity lambda, and its gradient, into the ones of the
+        // model with deterministic intensity; the derivatives with
+        // respect to kappaLambda and thetaLambda are appended
+        void detJumpGradient(Real lambda, Size lambdaIndex,
+                             Real kappaLambda, Real thetaLambda, Time t,
+                             std::complex<Real>& l,
+                             std::vector<std::complex<Real> >& gradient) {
+            const Real kt = kappaLambda*t;
+            const Real beta = (1.0 - std::exp(-kt))/kt;
+            const Real dBeta =
+                (kt*std::exp(-kt) - (1.0 - std::exp(-kt)))/(kappaLambda*kt);
+            const Real s = thetaLambda*(1.0 - beta)/lambda + beta;
+            const Real dsdLambda = -thetaLambda*(1.0 - beta)/(lambda*lambda);
+
+            for (auto& g : gradient)
+                g *= s;
+            gradient[lambdaIndex] += l*dsdLambda;
+            gradient.push_back(l*dBeta*(1.0 - thetaLambda/lambda));
+            gradient.push_back(l*(1.0 - beta)/lambda);
+            l *= s;
+        }
+
+    }
+
     BatesEngine::BatesEngine(const ext::shared_ptr<BatesModel> & model,
                              Size integrationOrder)
     : AnalyticHestonEngine(model, integrationOrder) { }
@@ -49,6 +76,31 @@ namespace QuantLib {
     }
 
 
+    bool BatesEngine::addOnTermGradient(
+                        const std::complex<Real>& z,
+                        Time t,
+                        std::complex<Real>& addOn,
+                        std::vector<std::complex<Real> >& gradient) const {
+
+        ext::shared_ptr<BatesModel> batesModel =
+                            ext::dynamic_pointer_cast<BatesModel>(*model_);
+
+        const Real nu     = batesModel->nu();
+        const Real delta  = batesModel->delta();
+        const Real lambda = batesModel->lambda();
+        const std::complex<Real> g(-z.imag(), z.real()); // i*z
+
+        const std::complex<Real> e = std::exp(nu*g + 0.5*delta*delta*g*g);
+        const Real m = std::exp(nu + 0.5*delta*delta);
+
+        addOn = t*lambda*(e - 1.0 - g*(m - 1.0));
+        gradient.resize(3);
+        gradient[0] = t*lambda*g*(e - m);
+        gradient[1] = t*lambda*delta*(g*g*e - g*m);
+        gradient[2] = t*(e - 1.0 - g*(m - 1.0));
+        return true;
+    }
+
     BatesDetJumpEngine::BatesDetJumpEngine(
         const ext::shared_ptr<BatesDetJumpModel>& model,
         Size integrationOrder)
@@ -78,6 +130,24 @@ namespace QuantLib {
     }
 
 
+    bool BatesDetJumpEngine::addOnTermGradient(
+                        const std::complex<Real>& z,
+                        Time t,
+                        std::complex<Real>& addOn,
+                        std::vector<std::complex<Real> >& gradient) const {
+        BatesEngine::addOnTermGradient(z, t, addOn, gradient);
+
+        ext::shared_ptr<BatesDetJumpModel> batesDetJumpModel =
+            ext::dynamic_pointer_cast<BatesDetJumpModel>(*model_);
+
+        detJumpGradient(batesDetJumpModel->lambda(), 2,
+                        batesDetJumpModel->kappaLambda(),
+                        batesDetJumpModel->thetaLambda(), t,
+                        addOn, gradient);
+        return true;
+    }
+
+
     BatesDoubleExpEngine::BatesDoubleExpEngine(
         const ext::shared_ptr<BatesDoubleExpModel> & model,
         Size integrationOrder)
@@ -105,6 +175,36 @@ namespace QuantLib {
                           - g*(p_/(1-nuUp_) + q_/(1+nuDown_)-1));
     }
 
+    bool BatesDoubleExpEngine::addOnTermGradient(
+                        const std::complex<Real>& z,
+                        Time t,
+                        std::complex<Real>& addOn,
+                        std::vector<std::complex<Real> >& gradient) const {
+        ext::shared_ptr<BatesDoubleExpModel> batesDoubleExpModel =
+            ext::dynamic_pointer_cast<BatesDoubleExpModel>(*model_);
+
+        const Real p      = batesDoubleExpModel->p();
+        const Real q      = 1.0-p;
+        const Real nuDown = batesDoubleExpModel->nuDown();
+        const Real nuUp   = batesDoubleExpModel->nuUp();
+        const Real lambda = batesDoubleExpModel->lambda();
+        const std::complex<Real> g(-z.imag(), z.real()); // i*z
+
+        const std::complex<Real> up = 1.0/(1.0-g*nuUp);
+        const std::complex<Real> down = 1.0/(1.0+g*nuDown);
+        const Real up1 = 1.0/(1.0-nuUp), down1 = 1.0/(1.0+nuDown);
+
+        const std::complex<Real> l =
+            p*up + q*down - 1.0 - g*(p*up1 + q*down1 - 1.0);
+        addOn = t*lambda*l;
+        gradient.resize(4);
+        gradient[0] = t*lambda*(up - down - g*(up1 - down1));
+        gradient[1] = t*lambda*q*g*(down1*down1 - down*down);
+        gradient[2] = t*lambda*p*g*(up*up - up1*up1);
+        gradient[3] = t*l;
+        return true;
+    }
+
     BatesDoubleExpDetJumpEngine::BatesDoubleExpDetJumpEngine(
         const ext::shared_ptr<BatesDoubleExpDetJumpModel> & model,
         Size integrationOrder)
@@ -132,4 +232,21 @@ namespace QuantLib {
             + (1.0 - std::exp(-kappaLambda*t))*l/(kappaLambda*t);
     }
 
+    bool BatesDoubleExpDetJumpEngine::addOnTermGradient(
+                        const std::complex<Real>& z,
+                        Time t,
+                        std::complex<Real>& addOn,
+                        std::vector<std::complex<Real> >& gradient) const {
+        BatesDoubleExpEngine::addOnTermGradient(z, t, addOn, gradient);
+
+        ext::shared_ptr<BatesDoubleExpDetJumpModel> doubleExpDetJumpModel
+            = ext::dynamic_pointer_cast<BatesDoubleExpDetJumpModel>(*model_);
+
+        detJumpGradient(doubleExpDetJumpModel->lambda(), 3,
+                        doubleExpDetJumpModel->kappaLambda(),
+                        doubleExpDetJumpModel->thetaLambda(), t,
+                        addOn, gradient);
+        return true;
+    }
+
 }
@@ -112,6 +112,11 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool addOnTermGradient(
+                const std::complex<Real>& z,
+                Time t,
+                std::complex<Real>& addOn,
+                std::vector<std::complex<Real> >& gradient) const override;
     };
 
 
@@ -124,6 +129,11 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool addOnTermGradient(
+                const std::complex<Real>& z,
+                Time t,
+                std::complex<Real>& addOn,
+                std::vector<std::complex<Real> >& gradient) const override;
     };
 
 
@@ -138,6 +148,11 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool addOnTermGradient(
+                const std::complex<Real>& z,
+                Time t,
+                std::complex<Real>& addOn,
+                std::vector<std::complex<Real> >& gradient) const override;
     };
 
 
@@ -152,6 +167,11 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool addOnTermGradient(
+                const std::complex<Real>& z,
+                Time t,
+                std::complex<Real>& addOn,
+                std::vector<std::complex<Real> >& gradient) const override;
     };
 
 }
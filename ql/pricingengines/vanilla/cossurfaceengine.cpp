@@ -0,0 +1,196 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/pricingengines/vanilla/cossurfaceengine.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    COSSurfaceEngine::COSSurfaceEngine(Handle<YieldTermStructure> riskFreeRate,
+                                       Handle<YieldTermStructure> dividendYield,
+                                       Real L,
+                                       Size N)
+    : riskFreeRate_(std::move(riskFreeRate)),
+      dividendYield_(std::move(dividendYield)), L_(L), N_(N) {
+        QL_REQUIRE(L_ > 0.0, "positive truncation range required");
+        QL_REQUIRE(N_ > 1, "at least two terms required");
+        registerWith(riskFreeRate_);
+        registerWith(dividendYield_);
+    }
+
+    void COSSurfaceEngine::update() {
+        coefficients_.clear();
+        VanillaOption::engine::update();
+    }
+
+    void COSSurfaceEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        const ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        results_.value = priceVanillaPayoffs(
+            std::vector<Option::Type>(1, payoff->optionType()),
+            Array(1, payoff->strike()),
+            arguments_.exercise->lastDate())[0];
+    }
+
+    Array COSSurfaceEngine::priceVanillaPayoffs(
+                                  const std::vector<Option::Type>& types,
+                                  const Array& strikes,
+                                  const Date& maturity) const {
+        QL_REQUIRE(types.size() == strikes.size(),
+                   "wrong number of option types (" << types.size()
+                   << ") for " << strikes.size() << " strikes");
+
+        const Real spot = underlying();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        const DiscountFactor df = riskFreeRate_->discount(maturity);
+        const Real forward = spot*dividendYield_->discount(maturity)/df;
+
+        const Coefficients& c =
+            coefficients(riskFreeRate_->timeFromReference(maturity));
+
+        Array prices(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            prices[i] = price(types[i], strikes[i], forward, df, c);
+
+        return prices;
+    }
+
+    const COSSurfaceEngine::Coefficients&
+    COSSurfaceEngine::coefficients(Time t) const {
+        auto iter = coefficients_.find(t);
+        if (iter != coefficients_.end())
+            return iter->second;
+
+        QL_REQUIRE(t > 0.0, "positive maturity required, " << t << " given");
+
+        // mean and variance from the derivatives of log(chF) at zero
+        const Real h = 1e-3;
+        const std::complex<Real> up = std::log(chF(h, t));
+        const std::complex<Real> down = std::log(chF(-h, t));
+        const Real mean = (up - down).imag()/(2*h);
+        const Real variance = -(up + down).real()/(h*h);
+        QL_REQUIRE(variance > 0.0,
+                   "non-positive variance (" << variance
+                   << ") of the log-return at t=" << t);
+
+        Coefficients c;
+        c.a = mean - L_*std::sqrt(variance);
+        c.b = mean + L_*std::sqrt(variance);
+
+        const Real w = M_PI/(c.b - c.a);
+        c.A.resize(N_);
+        for (Size n=0; n<N_; ++n) {
+            const Real r = n*w;
+            c.A[n] = (chF(r, t)*std::exp(std::complex<Real>(0.0, -r*c.a))).real();
+        }
+        c.A[0] *= 0.5;
+
+        return coefficients_[t] = std::move(c);
+    }
+
+    Real COSSurfaceEngine::price(Option::Type type, Real strike, Real forward,
+                                 DiscountFactor df, const Coefficients& c) const {
+        // the put payoff is non-null on [a, d]
+        const Real d = std::min(std::max(std::log(strike/forward), c.a), c.b);
+        const Real ea = std::exp(c.a);
+        const Real ed = std::exp(d);
+        const Real w = M_PI/(c.b - c.a);
+
+        // cos(n*w*(d-a)) and sin(n*w*(d-a)) by successive rotations
+        const std::complex<Real> rotation = std::polar(1.0, w*(d - c.a));
+        std::complex<Real> z(1.0, 0.0);
+
+        Real s = c.A[0]*(strike*(d - c.a) - forward*(ed - ea));
+        for (Size n=1; n<N_; ++n) {
+            z *= rotation;
+            const Real r = n*w;
+            const Real chi = (ed*(z.real() + r*z.imag()) - ea)/(1.0 + r*r);
+            const Real psi = z.imag()/r;
+            s += c.A[n]*(strike*psi - forward*chi);
+        }
+        const Real put = 2.0*df*s/(c.b - c.a);
+
+        switch (type) {
+          case Option::Put:
+            return put;
+          case Option::Call:
+            return put + df*(forward - strike);
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+
+    COSHestonSurfaceEngine::COSHestonSurfaceEngine(
+        const ext::shared_ptr<HestonModel>& model, Real L, Size N)
+    : COSSurfaceEngine(model->process()->riskFreeRate(),
+                       model->process()->dividendYield(), L, N),
+      process_(model->process()), hestonEngine_(model) {
+        registerWith(model);
+    }
+
+    std::complex<Real> COSHestonSurfaceEngine::chF(Real u, Time t) const {
+        return hestonEngine_.chF(std::complex<Real>(u, 0.0), t);
+    }
+
+    Real COSHestonSurfaceEngine::underlying() const {
+        return process_->s0()->value();
+    }
+
+
+    COSBatesSurfaceEngine::COSBatesSurfaceEngine(
+        const ext::shared_ptr<BatesModel>& model, Real L, Size N)
+    : COSHestonSurfaceEngine(model, L, N), model_(model) {}
+
+    std::complex<Real> COSBatesSurfaceEngine::chF(Real u, Time t) const {
+        // compensated log-normal jumps, as in BatesEngine
+        const Real nu = model_->nu();
+        const Real delta2 = 0.5*model_->delta()*model_->delta();
+        const Real lambda = model_->lambda();
+        const std::complex<Real> g(0.0, u);
+
+        return COSHestonSurfaceEngine::chF(u, t)
+            * std::exp(t*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                                 - g*(std::exp(nu+delta2) - 1.0)));
+    }
+
+
+    COSPTDHestonSurfaceEngine::COSPTDHestonSurfaceEngine(
+        const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+        Real L, Size N)
+    : COSSurfaceEngine(model->riskFreeRate(), model->dividendYield(), L, N),
+      model_(model), ptdHestonEngine_(model) {
+        registerWith(model_);
+    }
+
+    std::complex<Real> COSPTDHestonSurfaceEngine::chF(Real u, Time t) const {
+        return ptdHestonEngine_.chF(std::complex<Real>(u, 0.0), t);
+    }
+
+    Real COSPTDHestonSurfaceEngine::underlying() const {
+        return model_->s0();
+    }
+
+}
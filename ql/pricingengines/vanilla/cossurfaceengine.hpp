@@ -0,0 +1,162 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cossurfaceengine.hpp
+    \brief Fourier-cosine engines pricing whole strike grids
+*/
+
+#ifndef quantlib_cos_surface_engine_hpp
+#define quantlib_cos_surface_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/array.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //! base class for Fourier-cosine engines pricing whole strike grids
+    /*! The density of \f$ y = \log(S_T/F_T) \f$ is expanded in a
+        cosine series on an interval depending only on the maturity,
+        centered on the mean of \f$ y \f$ and spanning \f$ L \f$
+        standard deviations on each side.  The series coefficients
+        require \f$ N \f$ evaluations of the characteristic function;
+        they are cached for each maturity, so that any further option
+        with the same maturity only costs the (closed-form) payoff
+        coefficients.  The cache is cleared whenever the engine is
+        notified of a change.
+
+        To price a surface, set the same engine on all the options or
+        call priceVanillaPayoffs once for each maturity.  Puts are
+        priced by the series and calls by put-call parity.
+
+        References:
+
+        F. Fang, C.W. Oosterlee: A Novel Pricing Method for European
+        Options based on Fourier-Cosine Series Expansions,
+        SIAM Journal on Scientific Computing, 31(2), 826-848 (2008).
+
+        \ingroup vanillaengines
+    */
+    class COSSurfaceEngine : public VanillaOption::engine {
+      public:
+        void calculate() const override;
+        void update() override;
+
+        //! prices of European options with the given maturity
+        Array priceVanillaPayoffs(const std::vector<Option::Type>& types,
+                                  const Array& strikes,
+                                  const Date& maturity) const;
+
+        //! characteristic function of \f$ \log(S_t/F_t) \f$
+        virtual std::complex<Real> chF(Real u, Time t) const = 0;
+
+      protected:
+        COSSurfaceEngine(Handle<YieldTermStructure> riskFreeRate,
+                         Handle<YieldTermStructure> dividendYield,
+                         Real L,
+                         Size N);
+
+        virtual Real underlying() const = 0;
+
+      private:
+        struct Coefficients {
+            Real a, b;
+            std::vector<Real> A;
+        };
+        const Coefficients& coefficients(Time t) const;
+        Real price(Option::Type type, Real strike, Real forward,
+                   DiscountFactor df, const Coefficients& c) const;
+
+        Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
+        const Real L_;
+        const Size N_;
+        mutable std::map<Time, Coefficients> coefficients_;
+    };
+
+
+    //! Fourier-cosine surface engine for the Heston model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston engine.
+    */
+    class COSHestonSurfaceEngine : public COSSurfaceEngine {
+      public:
+        explicit COSHestonSurfaceEngine(
+            const ext::shared_ptr<HestonModel>& model,
+            Real L = 16, Size N = 200);
+
+        std::complex<Real> chF(Real u, Time t) const override;
+
+      protected:
+        Real underlying() const override;
+
+      private:
+        const ext::shared_ptr<HestonProcess> process_;
+        const AnalyticHestonEngine hestonEngine_;
+    };
+
+
+    //! Fourier-cosine surface engine for the Bates model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Bates engine.
+    */
+    class COSBatesSurfaceEngine : public COSHestonSurfaceEngine {
+      public:
+        explicit COSBatesSurfaceEngine(
+            const ext::shared_ptr<BatesModel>& model,
+            Real L = 16, Size N = 200);
+
+        std::complex<Real> chF(Real u, Time t) const override;
+
+      private:
+        const ext::shared_ptr<BatesModel> model_;
+    };
+
+
+    //! Fourier-cosine surface engine for the time-dependent Heston model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic time-dependent Heston engine.
+    */
+    class COSPTDHestonSurfaceEngine : public COSSurfaceEngine {
+      public:
+        explicit COSPTDHestonSurfaceEngine(
+            const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+            Real L = 16, Size N = 200);
+
+        std::complex<Real> chF(Real u, Time t) const override;
+
+      protected:
+        Real underlying() const override;
+
+      private:
+        const ext::shared_ptr<PiecewiseTimeDependentHestonModel> model_;
+        const AnalyticPTDHestonEngine ptdHestonEngine_;
+    };
+
+}
+
+#endif
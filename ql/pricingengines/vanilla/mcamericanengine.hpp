@@ -64,7 +64,8 @@ namespace QuantLib {
                          LsmBasisSystem::PolynomType polynomType,
                          Size nCalibrationSamples = Null<Size>(),
                          const boost::optional<bool>& antitheticVariateCalibration = boost::none,
-                         BigNatural seedCalibration = Null<Size>());
+                         BigNatural seedCalibration = Null<Size>(),
+                         bool compactCalibration = false);
 
         void calculate() const override;
 
@@ -120,6 +121,8 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withCompactCalibration(bool b = true);
+        MakeMCAmericanEngine& withThreads(Size threads);
 
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
@@ -134,6 +137,11 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         boost::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        bool compactCalibration_;
+        Size threads_;
+        // set by withThreads(), so that the multi-threaded simulation
+        // is only compiled when requested
+        void (MCAmericanEngine<RNG, S, RNG_Calibration>::*setThreads_)(Size);
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -151,7 +159,8 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType,
         Size nCalibrationSamples,
         const boost::optional<bool>& antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration,
+        bool compactCalibration)
     : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG, S, RNG_Calibration>(
           process,
           timeSteps,
@@ -166,7 +175,8 @@ namespace QuantLib {
           nCalibrationSamples,
           false,
           antitheticVariateCalibration,
-          seedCalibration),
+          seedCalibration,
+          compactCalibration),
       polynomOrder_(polynomOrder), polynomType_(polynomType) {}
 
     template <class RNG, class S, class RNG_Calibration>
@@ -203,7 +213,8 @@ namespace QuantLib {
              
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
-                                      *(process->riskFreeRate()));
+                                      *(process->riskFreeRate()),
+                                      this->compactCalibration_);
     }
 
     template <class RNG, class S, class RNG_Calibration>
@@ -269,7 +280,8 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()), samples_(Null<Size>()),
       maxSamples_(Null<Size>()), calibrationSamples_(2048), tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2), polynomType_(LsmBasisSystem::Monomial), antitheticCalibration_(boost::none),
-      seedCalibration_(Null<Size>()) {}
+      seedCalibration_(Null<Size>()), compactCalibration_(false), threads_(1),
+      setThreads_(nullptr) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
@@ -377,6 +389,22 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withCompactCalibration(
+        bool b) {
+        compactCalibration_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withThreads(Size threads) {
+        threads_ = threads;
+        setThreads_ = &MCAmericanEngine<RNG, S, RNG_Calibration>::setThreads;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator ext::shared_ptr<PricingEngine>() const {
@@ -384,7 +412,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return ext::shared_ptr<PricingEngine>(new
+        ext::shared_ptr<MCAmericanEngine<RNG, S, RNG_Calibration> > engine(new
            MCAmericanEngine<RNG, S, RNG_Calibration>(process_,
                                      steps_,
                                      stepsPerYear_,
@@ -397,7 +425,11 @@ namespace QuantLib {
                                      polynomType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     compactCalibration_));
+        if (setThreads_ != nullptr)
+            ((*engine).*setThreads_)(threads_);
+        return engine;
     }
 
 }
@@ -79,6 +79,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +89,10 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
+        // set by withThreads(), so that the multi-threaded simulation
+        // is only compiled when requested
+        void (McSimulation<SingleVariate,RNG,S>::*setThreads_)(Size);
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -96,6 +101,11 @@ namespace QuantLib {
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const override;
+        //! prices the paths stored as columns of the given matrix
+        /*! This can be used on batches returned by
+            PathGenerator::nextBatch.
+        */
+        Array operator()(const Matrix& paths, const TimeGrid& grid) const;
 
       private:
         PlainVanillaPayoff payoff_;
@@ -158,7 +168,8 @@ namespace QuantLib {
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), antithetic_(false), steps_(Null<Size>()),
       stepsPerYear_(Null<Size>()), samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(1),
+      setThreads_(nullptr) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -223,6 +234,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        setThreads_ = &McSimulation<SingleVariate,RNG,S>::setThreads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -231,7 +250,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return ext::shared_ptr<PricingEngine>(new
+        ext::shared_ptr<MCEuropeanEngine<RNG,S> > engine(new
             MCEuropeanEngine<RNG,S>(process_,
                                     steps_,
                                     stepsPerYear_,
@@ -240,6 +259,9 @@ namespace QuantLib {
                                     samples_, tolerance_,
                                     maxSamples_,
                                     seed_));
+        if (setThreads_ != nullptr)
+            ((*engine).*setThreads_)(threads_);
+        return engine;
     }
 
 
@@ -257,6 +279,16 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline Array EuropeanPathPricer::operator()(const Matrix& paths,
+                                                const TimeGrid&) const {
+        QL_REQUIRE(paths.rows() > 0, "the paths cannot be empty");
+        const Size last = paths.rows()-1;
+        Array values(paths.columns());
+        for (Size j=0; j<values.size(); ++j)
+            values[j] = payoff_(paths[last][j]) * discount_;
+        return values;
+    }
+
 }
 
 
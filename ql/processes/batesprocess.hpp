@@ -60,6 +60,10 @@ namespace QuantLib {
         Size factors() const override;
         Disposable<Array> drift(Time t, const Array& x) const override;
         Disposable<Array> evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        void evolveBatch(Time t0, const Matrix& x0, Time dt, const Matrix& dw, Matrix& x) const override {
+            // jumps are added path by path in evolve()
+            StochasticProcess::evolveBatch(t0, x0, dt, dw, x);
+        }
 
         Real lambda() const;
         Real nu()     const;
@@ -146,6 +146,34 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBatch(Time t0,
+                                                     const Array& x0,
+                                                     Time dt,
+                                                     const Array& dw,
+                                                     Array& x) const {
+        localVolatility(); // trigger update
+        if (isStrikeIndependent_ && !forceDiscretization_ && !x0.empty()) {
+            QL_REQUIRE(dw.size() == x0.size(),
+                       "mismatch between states and Brownian increments");
+            if (x.size() != x0.size())
+                x = Array(x0.size());
+            // the exact values for curves don't depend on the state,
+            // so they are computed once for the whole batch
+            const Real var = variance(t0, x0[0], dt);
+            const Real stdDev = std::sqrt(var);
+            const Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                           NoFrequency, true) -
+                                dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                            NoFrequency, true)) *
+                                   dt -
+                               0.5 * var;
+            for (Size j=0; j<x0.size(); ++j)
+                x[j] = x0[j] * std::exp(stdDev * dw[j] + drift);
+        } else {
+            StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
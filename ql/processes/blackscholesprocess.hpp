@@ -83,6 +83,8 @@ namespace QuantLib {
         Real stdDeviation(Time t0, Real x0, Time dt) const override;
         Real variance(Time t0, Real x0, Time dt) const override;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const override;
+        void evolveBatch(Time t0, const Array& x0,
+                         Time dt, const Array& dw, Array& x) const override;
         //@}
         Time time(const Date&) const override;
         //! \name Observer interface
@@ -555,6 +555,80 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolveBatch(Time t0, const Matrix& x0,
+                                    Time dt, const Matrix& dw,
+                                    Matrix& x) const {
+        if (discretization_ != PartialTruncation
+            && discretization_ != FullTruncation
+            && discretization_ != Reflection) {
+            StochasticProcess::evolveBatch(t0, x0, dt, dw, x);
+            return;
+        }
+
+        QL_REQUIRE(x0.rows() == 2 && dw.rows() == 2,
+                   "wrong batch dimensions");
+        QL_REQUIRE(dw.columns() == x0.columns(),
+                   "mismatch between states and Brownian increments");
+        if (x.rows() != 2 || x.columns() != x0.columns())
+            x = Matrix(2, x0.columns());
+
+        const Size n = x0.columns();
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+        // the rates don't depend on the state and are retrieved once
+        const Real rq = riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+                      - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+
+        const Real* s0 = x0.row_begin(0);
+        const Real* v0 = x0.row_begin(1);
+        const Real* dw0 = dw.row_begin(0);
+        const Real* dw1 = dw.row_begin(1);
+        Real* s = x.row_begin(0);
+        Real* v = x.row_begin(1);
+
+        // same calculations as in evolve(), see there for details
+        switch (discretization_) {
+          case PartialTruncation:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = (v0[j] > 0.0) ? std::sqrt(v0[j]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - v0[j]);
+                const Real corr = rho_*dw0[j] + sqrhov*dw1[j];
+
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = v0[j] + nu*dt + vol2*sdt*corr;
+            }
+            break;
+          case FullTruncation:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = (v0[j] > 0.0) ? std::sqrt(v0[j]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+                const Real corr = rho_*dw0[j] + sqrhov*dw1[j];
+
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = v0[j] + nu*dt + vol2*sdt*corr;
+            }
+            break;
+          case Reflection:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = std::sqrt(std::fabs(v0[j]));
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol*vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+                const Real corr = rho_*dw0[j] + sqrhov*dw1[j];
+
+                s[j] = s0[j]*std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = vol*vol + nu*dt + vol2*sdt*corr;
+            }
+            break;
+          default:
+            QL_FAIL("unknown discretization schema");
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
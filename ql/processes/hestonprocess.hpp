@@ -73,6 +73,10 @@ namespace QuantLib {
         Disposable<Matrix> diffusion(Time t, const Array& x) const override;
         Disposable<Array> apply(const Array& x0, const Array& dx) const override;
         Disposable<Array> evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
+        /*! The truncation and reflection schemes work on all paths at
+            once; the other discretizations evolve each path in turn.
+        */
+        void evolveBatch(Time t0, const Matrix& x0, Time dt, const Matrix& dw, Matrix& x) const override;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -62,6 +62,28 @@ namespace QuantLib {
         return process_->variance(t0, x0, dt);
     }
 
+    void HullWhiteProcess::evolveBatch(Time t0, const Array& x0,
+                                       Time dt, const Array& dw,
+                                       Array& x) const {
+        QL_REQUIRE(dw.size() == x0.size(),
+                   "mismatch between states and Brownian increments");
+        if (x.size() != x0.size())
+            x = Array(x0.size());
+        if (x0.empty())
+            return;
+
+        // same calculations as expectation() and stdDeviation(), with
+        // the terms not depending on the state computed only once
+        const Real level = process_->level();
+        const Real decay = std::exp(-process_->speed()*dt);
+        const Real alphaT = alpha(t0 + dt);
+        const Real alphaDecay = alpha(t0)*std::exp(-a_*dt);
+        const Real stdDev = process_->stdDeviation(t0, x0[0], dt);
+        for (Size j=0; j<x0.size(); ++j)
+            x[j] = (level + (x0[j] - level) * decay + alphaT - alphaDecay)
+                 + stdDev*dw[j];
+    }
+
     Real HullWhiteProcess::alpha(Time t) const {
         Real alfa = a_ > QL_EPSILON ?
                     (sigma_/a_)*(1 - std::exp(-a_*t)) :
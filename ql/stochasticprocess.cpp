@@ -20,6 +20,7 @@
 */
 
 #include <ql/stochasticprocess.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -62,6 +63,25 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess::evolveBatch(Time t0, const Matrix& x0,
+                                        Time dt, const Matrix& dw,
+                                        Matrix& x) const {
+        QL_REQUIRE(x0.rows() == size() && dw.rows() == factors(),
+                   "wrong batch dimensions");
+        QL_REQUIRE(dw.columns() == x0.columns(),
+                   "mismatch between states and Brownian increments");
+        if (x.rows() != x0.rows() || x.columns() != x0.columns())
+            x = Matrix(x0.rows(), x0.columns());
+
+        Array y0(x0.rows()), dw0(dw.rows());
+        for (Size j=0; j<x0.columns(); ++j) {
+            std::copy(x0.column_begin(j), x0.column_end(j), y0.begin());
+            std::copy(dw.column_begin(j), dw.column_end(j), dw0.begin());
+            const Array y = evolve(t0, y0, dt, dw0);
+            std::copy(y.begin(), y.end(), x.column_begin(j));
+        }
+    }
+
     Time StochasticProcess::time(const Date& ) const {
         QL_FAIL("date/time conversion not supported");
     }
@@ -97,4 +117,28 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess1D::evolveBatch(Time t0, const Array& x0,
+                                          Time dt, const Array& dw,
+                                          Array& x) const {
+        QL_REQUIRE(dw.size() == x0.size(),
+                   "mismatch between states and Brownian increments");
+        if (x.size() != x0.size())
+            x = Array(x0.size());
+        for (Size j=0; j<x0.size(); ++j)
+            x[j] = evolve(t0, x0[j], dt, dw[j]);
+    }
+
+    void StochasticProcess1D::evolveBatch(Time t0, const Matrix& x0,
+                                          Time dt, const Matrix& dw,
+                                          Matrix& x) const {
+        QL_REQUIRE(x0.rows() == 1 && dw.rows() == 1,
+                   "1-D batch required");
+        Array y0(x0.row_begin(0), x0.row_end(0)),
+              dw0(dw.row_begin(0), dw.row_end(0)), y;
+        evolveBatch(t0, y0, dt, dw0, y);
+        if (x.rows() != 1 || x.columns() != y.size())
+            x = Matrix(1, y.size());
+        std::copy(y.begin(), y.end(), x.row_begin(0));
+    }
+
 }
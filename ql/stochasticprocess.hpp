@@ -128,6 +128,19 @@ namespace QuantLib {
         */
         virtual Disposable<Array> apply(const Array& x0,
                                         const Array& dx) const;
+        /*! returns the asset values after a time interval \f$ \Delta t
+            \f$ for a batch of paths, each stored as a column of the
+            given matrices; \f$ \mathrm{x}_0 \f$ and \f$ \mathrm{x}
+            \f$ have size() rows and \f$ \Delta \mathrm{w} \f$ has
+            factors() rows.  By default, it calls evolve() on each
+            path; it can be overridden in derived classes which can
+            work on all paths at once.
+        */
+        virtual void evolveBatch(Time t0,
+                                 const Matrix& x0,
+                                 Time dt,
+                                 const Matrix& dw,
+                                 Matrix& x) const;
         //@}
 
         //! \name utilities
@@ -220,6 +233,13 @@ namespace QuantLib {
             returns \f$ x + \Delta x \f$.
         */
         virtual Real apply(Real x0, Real dx) const;
+        /*! returns the asset values after a time interval \f$ \Delta t
+            \f$ for a batch of paths.  By default, it calls evolve()
+            on each value; it can be overridden in derived classes
+            which can work on all paths at once.
+        */
+        virtual void evolveBatch(Time t0, const Array& x0,
+                                 Time dt, const Array& dw, Array& x) const;
         //@}
       protected:
         StochasticProcess1D() = default;
@@ -236,6 +256,7 @@ namespace QuantLib {
         Disposable<Matrix> covariance(Time t0, const Array& x0, Time dt) const override;
         Disposable<Array> evolve(Time t0, const Array& x0, Time dt, const Array& dw) const override;
         Disposable<Array> apply(const Array& x0, const Array& dx) const override;
+        void evolveBatch(Time t0, const Matrix& x0, Time dt, const Matrix& dw, Matrix& x) const override;
     };
 
 
@@ -34,6 +34,7 @@
 #include <ql/settings.hpp>
 #include <ql/time/date.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -70,6 +71,17 @@ namespace QuantLib {
         const Handle<Quote>& quote() const { return quote_; }
         virtual Real impliedQuote() const = 0;
         Real quoteError() const { return quote_->value() - impliedQuote(); }
+        //! sensitivities of the implied quote
+        /*! Returns the dates at which the implied quote depends on
+            the term structure being bootstrapped, together with the
+            derivative of the quote with respect to the value of the
+            term structure at each date (e.g., the discount factor
+            for yield curves.)  An empty result means that analytic
+            sensitivities are not available; bootstrappers using them
+            will resort to finite differences.
+        */
+        virtual std::vector<std::pair<Date, Real> >
+        impliedQuoteSensitivities() const;
         //! sets the term structure to be used for pricing
         /*! \warning Being a pointer and not a shared_ptr, the term
                      structure is not guaranteed to remain allocated
@@ -164,6 +176,12 @@ namespace QuantLib {
         termStructure_ = t;
     }
 
+    template <class TS>
+    std::vector<std::pair<Date, Real> >
+    BootstrapHelper<TS>::impliedQuoteSensitivities() const {
+        return std::vector<std::pair<Date, Real> >();
+    }
+
     template <class TS>
     Date BootstrapHelper<TS>::earliestDate() const {
         return earliestDate_;
@@ -28,21 +28,59 @@
 #include <ql/functional.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/defaulttermstructure.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
 
+namespace detail {
+
+    /* the term-structure values to which bootstrap helpers report
+       the sensitivities of their implied quotes */
+    inline Real bootstrapValue(const YieldTermStructure* ts, const Date& d) {
+        return ts->discount(d, true);
+    }
+
+    inline Real bootstrapValue(const DefaultProbabilityTermStructure* ts, const Date& d) {
+        return ts->survivalProbability(d, true);
+    }
+
+    inline Real bootstrapValue(const void*, const Date&) {
+        QL_FAIL("implied-quote sensitivities not supported for this term structure");
+    }
+
+}
+
 //! Global boostrapper, with additional restrictions
+/*! By default, the optimizer computes the Jacobian of the error terms
+    by bumping each variable in turn.  When useJacobian is set, it is
+    given a Jacobian built column by column by the bootstrap instead.
+    Helpers returning analytic sensitivities of their implied quotes
+    (see BootstrapHelper::impliedQuoteSensitivities()) only need the
+    curve to be interpolated again; the others are repriced, and with
+    a local interpolation only those whose latest relevant date is
+    after the previous pillar are.
+
+    In warm-start mode, the Jacobian at the last solution is kept;
+    when the quotes move by a small amount, a few Newton steps using
+    it are usually enough to fit the new quotes without a full
+    optimization, which is used when they aren't.
+*/
 template <class Curve> class GlobalBootstrap {
     typedef typename Curve::traits_type Traits;             // ZeroYield, Discount, ForwardRate
     typedef typename Curve::interpolator_type Interpolator; // Linear, LogLinear, ...
 
   public:
-    GlobalBootstrap(Real accuracy = Null<Real>());
+    GlobalBootstrap(Real accuracy = Null<Real>(),
+                    bool warmStart = false,
+                    bool useJacobian = false);
     /*! The set of (alive) additional dates is added to the interpolation grid. The set of additional dates must only
       depend on the current global evaluation date.  The additionalErrors functor must yield at least as many values
       such that
@@ -62,14 +100,20 @@ template <class Curve> class GlobalBootstrap {
     GlobalBootstrap(std::vector<ext::shared_ptr<typename Traits::helper> > additionalHelpers,
                     ext::function<std::vector<Date>()> additionalDates,
                     ext::function<Array()> additionalErrors,
-                    Real accuracy = Null<Real>());
+                    Real accuracy = Null<Real>(),
+                    bool warmStart = false,
+                    bool useJacobian = false);
     void setup(Curve *ts);
     void calculate() const;
 
   private:
+    class TargetFunction;
     void initialize() const;
+    bool newtonSteps(const TargetFunction& cost, Real accuracy) const;
     Curve *ts_;
     Real accuracy_;
+    bool warmStart_, useJacobian_;
+    mutable Matrix inverseJacobian_;
     mutable std::vector<ext::shared_ptr<typename Traits::helper> > additionalHelpers_;
     ext::function<std::vector<Date>()> additionalDates_;
     ext::function<Array()> additionalErrors_;
@@ -83,16 +127,180 @@ template <class Curve> class GlobalBootstrap {
 // template definitions
 
 template <class Curve>
-GlobalBootstrap<Curve>::GlobalBootstrap(Real accuracy) : ts_(0), accuracy_(accuracy) {}
+GlobalBootstrap<Curve>::GlobalBootstrap(Real accuracy, bool warmStart, bool useJacobian)
+: ts_(0), accuracy_(accuracy), warmStart_(warmStart), useJacobian_(useJacobian) {}
 
 template <class Curve>
 GlobalBootstrap<Curve>::GlobalBootstrap(
     std::vector<ext::shared_ptr<typename Traits::helper> > additionalHelpers,
     ext::function<std::vector<Date>()> additionalDates,
     ext::function<Array()> additionalErrors,
-    Real accuracy)
-: ts_(nullptr), accuracy_(accuracy), additionalHelpers_(std::move(additionalHelpers)),
-  additionalDates_(std::move(additionalDates)), additionalErrors_(std::move(additionalErrors)) {}
+    Real accuracy,
+    bool warmStart,
+    bool useJacobian)
+: ts_(nullptr), accuracy_(accuracy), warmStart_(warmStart), useJacobian_(useJacobian),
+  additionalHelpers_(std::move(additionalHelpers)), additionalDates_(std::move(additionalDates)),
+  additionalErrors_(std::move(additionalErrors)) {}
+
+// cost function: the variables are mapped to the curve data between the given bounds
+template <class Curve> class GlobalBootstrap<Curve>::TargetFunction : public CostFunction {
+  public:
+    TargetFunction(const Size firstHelper,
+                   const Size numberHelpers,
+                   ext::function<Array()> additionalErrors,
+                   Curve* ts,
+                   std::vector<Real> lowerBounds,
+                   std::vector<Real> upperBounds)
+    : firstHelper_(firstHelper), numberHelpers_(numberHelpers),
+      additionalErrors_(std::move(additionalErrors)), ts_(ts),
+      lowerBounds_(std::move(lowerBounds)), upperBounds_(std::move(upperBounds)) {}
+
+    Real transformDirect(const Real x, const Size i) const {
+        return (std::atan(x) + M_PI_2) / M_PI * (upperBounds_[i] - lowerBounds_[i]) + lowerBounds_[i];
+    }
+
+    Real transformInverse(const Real y, const Size i) const {
+        return std::tan((y - lowerBounds_[i]) * M_PI / (upperBounds_[i] - lowerBounds_[i]) - M_PI_2);
+    }
+
+    Real value(const Array& x) const override {
+        Array v = values(x);
+        std::transform(v.begin(), v.end(), v.begin(), square<Real>());
+        return std::sqrt(std::accumulate(v.begin(), v.end(), 0.0) / static_cast<Real>(v.size()));
+    }
+
+    Disposable<Array> values(const Array& x) const override {
+        for (Size i = 0; i < x.size(); ++i) {
+            Traits::updateGuess(ts_->data_, transformDirect(x[i], i), i + 1);
+        }
+        ts_->interpolation_.update();
+        return errors();
+    }
+
+    void jacobian(Matrix& jac, const Array& x) const override {
+        for (Size i = 0; i < x.size(); ++i) {
+            Traits::updateGuess(ts_->data_, transformDirect(x[i], i), i + 1);
+        }
+        ts_->interpolation_.update();
+        curveJacobian(jac);
+        for (Size j = 0; j < x.size(); ++j) {
+            Real dydx = (upperBounds_[j] - lowerBounds_[j]) / (M_PI * (1.0 + x[j] * x[j]));
+            for (Size i = 0; i < jac.rows(); ++i)
+                jac[i][j] *= dydx;
+        }
+    }
+
+    //! whether the given curve data are strictly within the bounds
+    bool inBounds(const Array& y) const {
+        for (Size i = 0; i < y.size(); ++i) {
+            if (y[i] <= lowerBounds_[i] || y[i] >= upperBounds_[i])
+                return false;
+        }
+        return true;
+    }
+
+    //! sets the curve data (not including the one at the reference date)
+    void setCurveData(const Array& y) const {
+        for (Size i = 0; i < y.size(); ++i) {
+            Traits::updateGuess(ts_->data_, y[i], i + 1);
+        }
+        ts_->interpolation_.update();
+    }
+
+    //! error terms for the current curve data
+    Disposable<Array> errors() const {
+        std::vector<Real> result(numberHelpers_);
+        for (Size i = 0; i < numberHelpers_; ++i) {
+            result[i] = ts_->instruments_[firstHelper_ + i]->quote()->value() -
+                        ts_->instruments_[firstHelper_ + i]->impliedQuote();
+        }
+        if (!(additionalErrors_ == QL_NULL_FUNCTION)) {
+            Array tmp = additionalErrors_();
+            result.resize(numberHelpers_ + tmp.size());
+            for (Size i = 0; i < tmp.size(); ++i) {
+                result[numberHelpers_ + i] = tmp[i];
+            }
+        }
+        Array asArray(result.begin(), result.end());
+        return asArray;
+    }
+
+    //! derivatives of the error terms with respect to the curve data
+    void curveJacobian(Matrix& jac) const {
+        const std::vector<Real> data = ts_->data_;
+        const std::vector<Date> dates = ts_->dates_;
+        const Array base = errors();
+        const Size n = lowerBounds_.size();
+        QL_REQUIRE(jac.rows() == base.size() && jac.columns() == n,
+                   "wrong jacobian size (" << jac.rows() << "x" << jac.columns() << "), "
+                   << base.size() << "x" << n << " required");
+        std::fill(jac.begin(), jac.end(), 0.0);
+
+        std::vector<std::vector<std::pair<Date, Real> > > sensitivities(numberHelpers_);
+        std::vector<Date> sensitivityDates;
+        for (Size i = 0; i < numberHelpers_; ++i) {
+            sensitivities[i] = ts_->instruments_[firstHelper_ + i]->impliedQuoteSensitivities();
+            for (Size k = 0; k < sensitivities[i].size(); ++k)
+                sensitivityDates.push_back(sensitivities[i][k].first);
+        }
+        std::sort(sensitivityDates.begin(), sensitivityDates.end());
+        sensitivityDates.erase(std::unique(sensitivityDates.begin(), sensitivityDates.end()),
+                               sensitivityDates.end());
+        std::vector<Real> valuesUp(sensitivityDates.size()), valuesDown(sensitivityDates.size());
+
+        for (Size j = 0; j < n; ++j) {
+            Real y = data[j + 1];
+            Real h = 1.0e-6 * std::max(std::fabs(y), 1.0);
+
+            // helpers without sensitivities and additional errors are repriced
+            Traits::updateGuess(ts_->data_, y + h, j + 1);
+            ts_->interpolation_.update();
+            for (Size i = 0; i < numberHelpers_; ++i) {
+                const ext::shared_ptr<typename Traits::helper>& helper =
+                    ts_->instruments_[firstHelper_ + i];
+                if (!sensitivities[i].empty())
+                    continue;
+                // with a local interpolation, the curve doesn't change before the previous pillar
+                if (!Interpolator::global && helper->latestRelevantDate() <= dates[j])
+                    continue;
+                jac[i][j] = (helper->quote()->value() - helper->impliedQuote() - base[i]) / h;
+            }
+            if (!(additionalErrors_ == QL_NULL_FUNCTION)) {
+                Array tmp = additionalErrors_();
+                for (Size i = 0; i < tmp.size(); ++i)
+                    jac[numberHelpers_ + i][j] = (tmp[i] - base[numberHelpers_ + i]) / h;
+            }
+
+            // the others only need the values of the curve
+            if (!sensitivityDates.empty()) {
+                for (Size k = 0; k < sensitivityDates.size(); ++k)
+                    valuesUp[k] = detail::bootstrapValue(ts_, sensitivityDates[k]);
+                ts_->data_ = data;
+                Traits::updateGuess(ts_->data_, y - h, j + 1);
+                ts_->interpolation_.update();
+                for (Size k = 0; k < sensitivityDates.size(); ++k)
+                    valuesDown[k] = detail::bootstrapValue(ts_, sensitivityDates[k]);
+                for (Size i = 0; i < numberHelpers_; ++i) {
+                    for (Size k = 0; k < sensitivities[i].size(); ++k) {
+                        Size l = std::lower_bound(sensitivityDates.begin(), sensitivityDates.end(),
+                                                  sensitivities[i][k].first) -
+                                 sensitivityDates.begin();
+                        jac[i][j] -= sensitivities[i][k].second * (valuesUp[l] - valuesDown[l]) / (2.0 * h);
+                    }
+                }
+            }
+
+            ts_->data_ = data;
+            ts_->interpolation_.update();
+        }
+    }
+
+  private:
+    Size firstHelper_, numberHelpers_;
+    ext::function<Array()> additionalErrors_;
+    Curve *ts_;
+    const std::vector<Real> lowerBounds_, upperBounds_;
+};
 
 template <class Curve> void GlobalBootstrap<Curve>::setup(Curve *ts) {
     ts_ = ts;
@@ -222,7 +430,7 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
 
     // setup optimizer and EndCriteria
     Real optEps = accuracy;
-    LevenbergMarquardt optimizer(optEps, optEps, optEps); // FIXME hardcoded tolerances
+    LevenbergMarquardt optimizer(optEps, optEps, optEps, useJacobian_); // FIXME hardcoded tolerances
     EndCriteria ec(1000, 10, optEps, optEps, optEps);      // FIXME hardcoded values here as well
 
     // setup interpolation
@@ -241,61 +449,12 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
     }
 
     // setup cost function
-    class TargetFunction : public CostFunction {
-      public:
-        TargetFunction(const Size firstHelper,
-                       const Size numberHelpers,
-                       ext::function<Array()> additionalErrors,
-                       Curve* ts,
-                       std::vector<Real> lowerBounds,
-                       std::vector<Real> upperBounds)
-        : firstHelper_(firstHelper), numberHelpers_(numberHelpers),
-          additionalErrors_(std::move(additionalErrors)), ts_(ts),
-          lowerBounds_(std::move(lowerBounds)), upperBounds_(std::move(upperBounds)) {}
-
-        Real transformDirect(const Real x, const Size i) const {
-            return (std::atan(x) + M_PI_2) / M_PI * (upperBounds_[i] - lowerBounds_[i]) + lowerBounds_[i];
-        }
-
-        Real transformInverse(const Real y, const Size i) const {
-            return std::tan((y - lowerBounds_[i]) * M_PI / (upperBounds_[i] - lowerBounds_[i]) - M_PI_2);
-        }
-
-        Real value(const Array& x) const override {
-            Array v = values(x);
-            std::transform(v.begin(), v.end(), v.begin(), square<Real>());
-            return std::sqrt(std::accumulate(v.begin(), v.end(), 0.0) / static_cast<Real>(v.size()));
-        }
-
-        Disposable<Array> values(const Array& x) const override {
-            for (Size i = 0; i < x.size(); ++i) {
-                Traits::updateGuess(ts_->data_, transformDirect(x[i], i), i + 1);
-            }
-            ts_->interpolation_.update();
-            std::vector<Real> result(numberHelpers_);
-            for (Size i = 0; i < numberHelpers_; ++i) {
-                result[i] = ts_->instruments_[firstHelper_ + i]->quote()->value() -
-                            ts_->instruments_[firstHelper_ + i]->impliedQuote();
-            }
-            if (!(additionalErrors_ == QL_NULL_FUNCTION)) {
-                Array tmp = additionalErrors_();
-                result.resize(numberHelpers_ + tmp.size());
-                for (Size i = 0; i < tmp.size(); ++i) {
-                    result[numberHelpers_ + i] = tmp[i];
-                }
-            }
-            Array asArray(result.begin(), result.end());
-            return asArray;
-        }
-
-      private:
-        Size firstHelper_, numberHelpers_;
-        ext::function<Array()> additionalErrors_;
-        Curve *ts_;
-        const std::vector<Real> lowerBounds_, upperBounds_;
-    };
     TargetFunction cost(firstHelper_, numberHelpers_, additionalErrors_, ts_, lowerBounds, upperBounds);
 
+    // starting from the previous solution, the Jacobian there might be enough
+    if (warmStart_ && validCurve_ && newtonSteps(cost, accuracy))
+        return;
+
     // setup guess
     Array guess(numberHelpers_ + numberAdditionalDates_);
     for (Size i = 0; i < guess.size(); ++i) {
@@ -317,10 +476,62 @@ template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
     QL_REQUIRE(finalTargetError <= accuracy,
                "global bootstrap failed, error is " << finalTargetError << ", accuracy is " << accuracy);
 
+    // keep the inverse Jacobian at the solution for the next warm start
+    if (warmStart_) {
+        Array errors = cost.errors();
+        inverseJacobian_ = Matrix();
+        if (errors.size() == guess.size()) {
+            Matrix jacobian(errors.size(), guess.size());
+            cost.curveJacobian(jacobian);
+            try {
+                inverseJacobian_ = inverse(jacobian);
+            } catch (Error&) {
+                // singular: no warm start
+            }
+        }
+    }
+
     // set valid flag
     validCurve_ = true;
 }
 
+template <class Curve>
+bool GlobalBootstrap<Curve>::newtonSteps(const TargetFunction& cost, Real accuracy) const {
+    const Size n = numberHelpers_ + numberAdditionalDates_;
+    if (inverseJacobian_.rows() != n)
+        return false;
+
+    const std::vector<Real> previousData = ts_->data_;
+    Array y(n);
+    for (Size i = 0; i < n; ++i)
+        y[i] = ts_->data_[i + 1];
+    cost.setCurveData(y);
+    Array errors = cost.errors();
+
+    if (errors.size() == n) {
+        Real previousError = QL_MAX_REAL;
+        for (Size iteration = 0; iteration < 10; ++iteration) {
+            Real error = std::sqrt(DotProduct(errors, errors) / static_cast<Real>(n));
+            if (error <= accuracy)
+                return true;
+            // stop as soon as the steps don't improve the fit
+            if (error >= previousError)
+                break;
+            previousError = error;
+            y -= inverseJacobian_ * errors;
+            if (!cost.inBounds(y))
+                break;
+            cost.setCurveData(y);
+            errors = cost.errors();
+        }
+    }
+
+    // no luck; the optimization starts from the previous solution
+    ts_->data_ = previousData;
+    ts_->interpolation_.update();
+    return false;
+}
+
 } // namespace QuantLib
 
 #endif
@@ -29,10 +29,13 @@
 
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
+#include <ql/termstructures/defaulttermstructure.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -71,9 +74,49 @@ namespace detail {
         return result;
     }
 
+    //! Records whether a bootstrap helper sent a notification
+    template <class Helper>
+    class BootstrapHelperFlag : public Observer {
+      public:
+        explicit BootstrapHelperFlag(ext::shared_ptr<Helper> helper)
+        : helper_(std::move(helper)) {
+            registerWith(helper_);
+        }
+        void update() override { up_ = true; }
+        bool isUp() const { return up_; }
+        void lower() { up_ = false; }
+        const ext::shared_ptr<Helper>& helper() const { return helper_; }
+      private:
+        ext::shared_ptr<Helper> helper_;
+        bool up_ = true;
+    };
+
+    /* Jumps are observed by the curve itself, not by its helpers;
+       a change in their quotes can't be traced to a pillar. */
+    inline bool hasJumps(const YieldTermStructure* ts) {
+        return !ts->jumpDates().empty();
+    }
+
+    inline bool hasJumps(const DefaultProbabilityTermStructure* ts) {
+        return !ts->jumpDates().empty();
+    }
+
+    inline bool hasJumps(const void*) {
+        return false;
+    }
+
 }
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the curve was already bootstrapped, its interpolation is
+        local and each pillar only depends on the helpers up to it,
+        a recalculation only solves again the pillars starting from
+        the first one whose helper sent a notification (e.g., because
+        its quote changed); the previous pillars are kept unchanged.
+        The bootstrap starts from scratch if any other change might
+        have occurred, i.e., when no helper notified its observers,
+        when the pillar dates moved or when the curve has jumps.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -104,6 +147,7 @@ namespace detail {
         void calculate() const;
       private:
         void initialize() const;
+        Size firstChangedPillar() const;
         Real accuracy_;
         Real minValue_, maxValue_;
         Size maxAttempts_;
@@ -116,9 +160,12 @@ namespace detail {
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
         mutable bool initialized_ = false, validCurve_ = false, loopRequired_;
+        mutable bool pillarsChanged_ = true;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<ext::shared_ptr<BootstrapError<Curve> > > errors_;
+        std::vector<ext::shared_ptr<
+            detail::BootstrapHelperFlag<typename Traits::helper> > > flags_;
     };
 
 
@@ -145,8 +192,13 @@ namespace detail {
         ts_ = ts;
         n_ = ts_->instruments_.size();
         QL_REQUIRE(n_ > 0, "no bootstrap helpers given");
-        for (Size j=0; j<n_; ++j)
+        flags_.resize(n_);
+        for (Size j=0; j<n_; ++j) {
             ts_->registerWith(ts_->instruments_[j]);
+            flags_[j] = ext::make_shared<
+                detail::BootstrapHelperFlag<typename Traits::helper> >(
+                                                    ts_->instruments_[j]);
+        }
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
@@ -174,6 +226,7 @@ namespace detail {
         // calculate dates and times, create errors_
         std::vector<Date>& dates = ts_->dates_;
         std::vector<Time>& times = ts_->times_;
+        const std::vector<Date> previousDates = dates;
         dates.resize(alive_+1);
         times.resize(alive_+1);
         errors_.resize(alive_+1);
@@ -212,6 +265,7 @@ namespace detail {
                 BootstrapError<Curve>(ts_, helper, i));
         }
         ts_->maxDate_ = maxDate;
+        pillarsChanged_ = (dates != previousDates);
 
         // set initial guess only if the current curve cannot be used as guess
         if (!validCurve_ || ts_->data_.size()!=alive_+1) {
@@ -236,8 +290,14 @@ namespace detail {
         if (!initialized_ || ts_->moving_)
             initialize();
 
+        // pillars before the first changed one still solve their helpers
+        Size firstPillar = 1;
+        if (validCurve_ && !loopRequired_ && !pillarsChanged_
+            && !detail::hasJumps(ts_))
+            firstPillar = firstChangedPillar();
+
         // setup helpers
-        for (Size j=firstAliveHelper_; j<n_; ++j) {
+        for (Size j=firstAliveHelper_+firstPillar-1; j<n_; ++j) {
             const ext::shared_ptr<typename Traits::helper>& helper =
                                                         ts_->instruments_[j];
             // check for valid quote
@@ -268,7 +328,7 @@ namespace detail {
             std::vector<Real> maxValues(alive_+1, Null<Real>());
             std::vector<Size> attempts(alive_+1, 1);
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // shorter aliases for readability and to avoid duplication
                 Real& min = minValues[i];
@@ -383,6 +443,30 @@ namespace detail {
             validData = true;
         }
         validCurve_ = true;
+
+        for (Size j=0; j<n_; ++j)
+            flags_[j]->lower();
+    }
+
+    template <class Curve>
+    Size IterativeBootstrap<Curve>::firstChangedPillar() const {
+        Date firstChange = Date::maxDate();
+        bool changed = false;
+        for (Size j=0; j<n_; ++j) {
+            if (flags_[j]->isUp()) {
+                firstChange = std::min(firstChange,
+                                       flags_[j]->helper()->pillarDate());
+                changed = true;
+            }
+        }
+        // the curve was notified by something else
+        if (!changed)
+            return 1;
+
+        const std::vector<Date>& dates = ts_->dates_;
+        Size i = std::lower_bound(dates.begin()+1, dates.end(), firstChange)
+            - dates.begin();
+        return i <= alive_ ? i : 1;
     }
 
 }
@@ -21,6 +21,7 @@
 #include <ql/termstructures/yield/quantotermstructure.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/ultimateforwardtermstructure.hpp>
+#include <ql/termstructures/yield/yieldcurvesnapshot.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zeroyieldstructure.hpp>
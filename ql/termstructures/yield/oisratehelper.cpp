@@ -18,6 +18,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/cashflows/cashflows.hpp>
 #include <ql/instruments/makeois.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/termstructures/yield/oisratehelper.hpp>
@@ -107,6 +108,9 @@ namespace QuantLib {
         }
 
         latestDate_ = std::max(swap_->maturityDate(), lastPaymentDate);
+
+        fixedLeg_ = CompiledLeg(swap_->fixedLeg());
+        overnightLeg_ = CompiledLeg(swap_->overnightLeg());
     }
 
     void OISRateHelper::setTermStructure(YieldTermStructure* t) {
@@ -127,9 +131,28 @@ namespace QuantLib {
 
     Real OISRateHelper::impliedQuote() const {
         QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
-        // we didn't register as observers - force calculation
-        swap_->recalculate();
-        return swap_->fairRate();
+        // the legs are valued directly, as the swap engine would do
+        const YieldTermStructure& discountCurve = **discountRelinkableHandle_;
+        static const Spread basisPoint = 1.0e-4;
+        Date settlementDate = discountCurve.referenceDate();
+        Real overnightLegNPV, overnightLegBPS, fixedLegNPV, fixedLegBPS;
+        CashFlows::npvbps(overnightLeg_, discountCurve, false,
+                          settlementDate, settlementDate,
+                          overnightLegNPV, overnightLegBPS);
+        CashFlows::npvbps(fixedLeg_, discountCurve, false,
+                          settlementDate, settlementDate,
+                          fixedLegNPV, fixedLegBPS);
+        overnightLegNPV *= swap_->payer(1) ? -1.0 : 1.0;
+        fixedLegBPS *= swap_->payer(0) ? -1.0 : 1.0;
+        // the fixed rate of the swap is zero, and so is the NPV of its
+        // fixed leg; therefore, the swap NPV is the overnight-leg NPV
+        return - overnightLegNPV/(fixedLegBPS/basisPoint);
+    }
+
+    ext::shared_ptr<OvernightIndexedSwap> OISRateHelper::swap() const {
+        // the swap is not notified when the curve changes
+        swap_->update();
+        return swap_;
     }
 
     void OISRateHelper::accept(AcyclicVisitor& v) {
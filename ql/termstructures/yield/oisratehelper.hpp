@@ -56,7 +56,15 @@ namespace QuantLib {
         //@}
         //! \name inspectors
         //@{
-        ext::shared_ptr<OvernightIndexedSwap> swap() const { return swap_; }
+        /*! \note impliedQuote() doesn't price the swap: its fixed
+                  rate is null, so only the NPV of the overnight leg
+                  and the BPS of the fixed leg are calculated.  Since
+                  the swap doesn't observe the curve being
+                  bootstrapped, it is marked for recalculation when
+                  returned by this method; it should be retrieved
+                  again after the curve changes.
+        */
+        ext::shared_ptr<OvernightIndexedSwap> swap() const;
         //@}
         //! \name Visitability
         //@{
@@ -84,6 +92,7 @@ namespace QuantLib {
       Period forwardStart_;
       Spread overnightSpread_;
       RateAveraging::Type averagingMethod_;
+      CompiledLeg fixedLeg_, overnightLeg_;
     };
 
     //! Rate helper for bootstrapping over Overnight Indexed Swap rates
@@ -23,6 +23,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/currency.hpp>
 #include <ql/indexes/swapindex.hpp>
@@ -39,6 +40,37 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // sensitivities of the forward rate (D(d1)/D(d2) - 1)/t
+        // to the discount factors D(d1) and D(d2)
+        std::vector<std::pair<Date, Real> >
+        forwardRateSensitivities(const YieldTermStructure* ts,
+                                 const Date& d1, const Date& d2, Time t) {
+            DiscountFactor disc1 = ts->discount(d1);
+            DiscountFactor disc2 = ts->discount(d2);
+            std::vector<std::pair<Date, Real> > result(2);
+            result[0] = std::make_pair(d1, 1.0 / (t * disc2));
+            result[1] = std::make_pair(d2, -disc1 / (t * disc2 * disc2));
+            return result;
+        }
+
+        // sensitivities of the forecast of the fixing used by the helpers
+        std::vector<std::pair<Date, Real> >
+        fixingSensitivities(const YieldTermStructure* ts,
+                            const IborIndex& index,
+                            const Date& fixingDate) {
+            // past fixings don't depend on the curve
+            if (fixingDate < Settings::instance().evaluationDate())
+                return std::vector<std::pair<Date, Real> >();
+            Date d1 = index.valueDate(fixingDate);
+            Date d2 = index.maturityDate(d1);
+            Time t = index.dayCounter().yearFraction(d1, d2);
+            return forwardRateSensitivities(ts, d1, d2, t);
+        }
+
+    }
+
     FuturesRateHelper::FuturesRateHelper(const Handle<Quote>& price,
                                          const Date& iborStartDate,
                                          Natural lengthInMonths,
@@ -275,6 +307,17 @@ namespace QuantLib {
         return 100.0 * (1.0 - futureRate);
     }
 
+    std::vector<std::pair<Date, Real> >
+    FuturesRateHelper::impliedQuoteSensitivities() const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        std::vector<std::pair<Date, Real> > result =
+            forwardRateSensitivities(termStructure_, earliestDate_,
+                                     maturityDate_, yearFraction_);
+        for (auto& sensitivity : result)
+            sensitivity.second *= -100.0;
+        return result;
+    }
+
     Real FuturesRateHelper::convexityAdjustment() const {
         return convAdj_.empty() ? 0.0 : convAdj_->value();
     }
@@ -338,6 +381,12 @@ namespace QuantLib {
         return iborIndex_->fixing(fixingDate_, true);
     }
 
+    std::vector<std::pair<Date, Real> >
+    DepositRateHelper::impliedQuoteSensitivities() const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        return fixingSensitivities(termStructure_, *iborIndex_, fixingDate_);
+    }
+
     void DepositRateHelper::setTermStructure(YieldTermStructure* t) {
         // do not set the relinkable handle as an observer -
         // force recalculation when needed---the index is not lazy
@@ -590,6 +639,17 @@ namespace QuantLib {
                    spanningTime_;
     }
 
+    std::vector<std::pair<Date, Real> >
+    FraRateHelper::impliedQuoteSensitivities() const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        if (useIndexedCoupon_)
+            return fixingSensitivities(termStructure_, *iborIndex_,
+                                       fixingDate_);
+        else
+            return forwardRateSensitivities(termStructure_, earliestDate_,
+                                            maturityDate_, spanningTime_);
+    }
+
     void FraRateHelper::setTermStructure(YieldTermStructure* t) {
         // do not set the relinkable handle as an observer -
         // force recalculation when needed---the index is not lazy
@@ -862,6 +922,8 @@ namespace QuantLib {
 
         latestDate_ = pillarDate_; // backward compatibility
 
+        fixedLeg_ = CompiledLeg(swap_->fixedLeg());
+        floatingLeg_ = CompiledLeg(swap_->floatingLeg());
     }
 
     void SwapRateHelper::setTermStructure(YieldTermStructure* t) {
@@ -882,18 +944,36 @@ namespace QuantLib {
 
     Real SwapRateHelper::impliedQuote() const {
         QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
-        // we didn't register as observers - force calculation
-        swap_->recalculate();
+        // the legs are valued directly, as the swap engine would do
+        const YieldTermStructure& discountCurve = **discountRelinkableHandle_;
         // weak implementation... to be improved
         static const Spread basisPoint = 1.0e-4;
-        Real floatingLegNPV = swap_->floatingLegNPV();
+        Date settlementDate = discountCurve.referenceDate();
+        Real floatingLegNPV, floatingLegBPS, fixedLegNPV, fixedLegBPS;
+        CashFlows::npvbps(floatingLeg_, discountCurve, false,
+                          settlementDate, settlementDate,
+                          floatingLegNPV, floatingLegBPS);
+        CashFlows::npvbps(fixedLeg_, discountCurve, false,
+                          settlementDate, settlementDate,
+                          fixedLegNPV, fixedLegBPS);
+        Real floatingSign = swap_->payer(1) ? -1.0 : 1.0;
+        Real fixedSign = swap_->payer(0) ? -1.0 : 1.0;
+        floatingLegNPV *= floatingSign;
+        floatingLegBPS *= floatingSign;
+        fixedLegBPS *= fixedSign;
         Spread spread = spread_.empty() ? 0.0 : spread_->value();
-        Real spreadNPV = swap_->floatingLegBPS()/basisPoint*spread;
+        Real spreadNPV = floatingLegBPS/basisPoint*spread;
         Real totNPV = - (floatingLegNPV+spreadNPV);
-        Real result = totNPV/(swap_->fixedLegBPS()/basisPoint);
+        Real result = totNPV/(fixedLegBPS/basisPoint);
         return result;
     }
 
+    ext::shared_ptr<VanillaSwap> SwapRateHelper::swap() const {
+        // the swap is not notified when the curve changes
+        swap_->update();
+        return swap_;
+    }
+
     void SwapRateHelper::accept(AcyclicVisitor& v) {
         auto* v1 = dynamic_cast<Visitor<SwapRateHelper>*>(&v);
         if (v1 != nullptr)
@@ -30,6 +30,7 @@
 #ifndef quantlib_ratehelpers_hpp
 #define quantlib_ratehelpers_hpp
 
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/instruments/vanillaswap.hpp>
 #include <ql/instruments/bmaswap.hpp>
@@ -95,6 +96,8 @@ namespace QuantLib {
         //! \name RateHelper interface
         //@{
         Real impliedQuote() const override;
+        std::vector<std::pair<Date, Real> >
+        impliedQuoteSensitivities() const override;
         //@}
         //! \name FuturesRateHelper inspectors
         //@{
@@ -134,6 +137,8 @@ namespace QuantLib {
         //! \name RateHelper interface
         //@{
         Real impliedQuote() const override;
+        std::vector<std::pair<Date, Real> >
+        impliedQuoteSensitivities() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
         //! \name Visitability
@@ -236,6 +241,8 @@ namespace QuantLib {
         //! \name RateHelper interface
         //@{
         Real impliedQuote() const override;
+        std::vector<std::pair<Date, Real> >
+        impliedQuoteSensitivities() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
         //! \name Visitability
@@ -323,6 +330,13 @@ namespace QuantLib {
         //! \name SwapRateHelper inspectors
         //@{
         Spread spread() const;
+        /*! \note impliedQuote() values the fixed and floating legs
+                  of the swap directly instead of pricing it.  Since
+                  the swap doesn't observe the curve being
+                  bootstrapped, it is marked for recalculation when
+                  returned by this method; it should be retrieved
+                  again after the curve changes.
+        */
         ext::shared_ptr<VanillaSwap> swap() const;
         const Period& forwardStart() const;
         //@}
@@ -348,6 +362,7 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountHandle_;
         RelinkableHandle<YieldTermStructure> discountRelinkableHandle_;
         boost::optional<bool> useIndexedCoupons_;
+        CompiledLeg fixedLeg_, floatingLeg_;
     };
 
 
@@ -483,10 +498,6 @@ namespace QuantLib {
         return spread_.empty() ? 0.0 : spread_->value();
     }
 
-    inline ext::shared_ptr<VanillaSwap> SwapRateHelper::swap() const {
-        return swap_;
-    }
-
     inline const Period& SwapRateHelper::forwardStart() const {
         return fwdStart_;
     }
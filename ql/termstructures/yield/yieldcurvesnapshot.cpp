@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/yield/yieldcurvesnapshot.hpp>
+
+namespace QuantLib {
+
+    YieldCurveSnapshot::YieldCurveSnapshot(const YieldTermStructure& curve,
+                                           const std::vector<Time>& times)
+    : referenceDate_(curve.referenceDate()), dayCounter_(curve.dayCounter()),
+      times_(1, 0.0) {
+        for (Time t : times) {
+            if (t == 0.0)
+                continue;
+            QL_REQUIRE(t > times_.back(),
+                       "times must be positive and increasing, "
+                       "while " << t << " follows " << times_.back());
+            times_.push_back(t);
+        }
+        initialize(curve);
+    }
+
+    YieldCurveSnapshot::YieldCurveSnapshot(const YieldTermStructure& curve,
+                                           const std::vector<Date>& dates)
+    : referenceDate_(curve.referenceDate()), dayCounter_(curve.dayCounter()),
+      times_(1, 0.0) {
+        for (const Date& d : dates) {
+            Time t = curve.timeFromReference(d);
+            if (t == 0.0)
+                continue;
+            QL_REQUIRE(t > times_.back(),
+                       "dates must be after the reference date and increasing; "
+                       << d << " is not");
+            times_.push_back(t);
+        }
+        initialize(curve);
+    }
+
+    void YieldCurveSnapshot::initialize(const YieldTermStructure& curve) {
+        QL_REQUIRE(times_.size() > 1, "no positive time given");
+
+        logDiscounts_.resize(times_.size());
+        for (Size i=0; i<times_.size(); ++i)
+            logDiscounts_[i] = std::log(curve.discount(times_[i]));
+
+        forwards_.resize(times_.size() - 1);
+        for (Size i=0; i<forwards_.size(); ++i)
+            forwards_[i] = (logDiscounts_[i] - logDiscounts_[i+1]) /
+                           (times_[i+1] - times_[i]);
+    }
+
+    void YieldCurveSnapshot::discount(const Time* begin,
+                                      const Time* end,
+                                      DiscountFactor* out) const {
+        QL_REQUIRE(!forwards_.empty(), "empty yield-curve snapshot");
+        const Size last = forwards_.size() - 1;
+        Size i = 0;
+        for (const Time* t = begin; t != end; ++t, ++out) {
+            // walk the grid as long as the times are increasing and
+            // close; otherwise, look the segment up
+            if (*t < times_[i]) {
+                i = segment(*t);
+            } else if (i < last && *t >= times_[i+1]) {
+                ++i;
+                if (i < last && *t >= times_[i+1])
+                    i = segment(*t);
+            }
+            *out = std::exp(logDiscount(*t, i));
+        }
+    }
+
+}
@@ -0,0 +1,121 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file yieldcurvesnapshot.hpp
+    \brief frozen copy of a yield term structure for bulk discounting
+*/
+
+#ifndef quantlib_yield_curve_snapshot_hpp
+#define quantlib_yield_curve_snapshot_hpp
+
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Frozen copy of a yield term structure
+    /*! The snapshot samples the discount factors of a yield term
+        structure at a given set of times and interpolates them
+        log-linearly, i.e., with piecewise-flat forward rates.  The
+        last forward rate is used for extrapolation beyond the last
+        time.
+
+        The snapshot is not a term structure: it is not linked to the
+        original curve, it is not notified of its changes and its
+        methods are not virtual.  It is meant for engines and
+        simulations that discount many times on a curve that doesn't
+        change meanwhile, and that would otherwise pay for handle
+        dereferencing, range checks and virtual calls (possibly through
+        a chain of spreaded or implied curves) at each call.
+
+        The snapshot reproduces the original curve at the sampled
+        times.  It reproduces it everywhere (up to rounding) if the
+        original curve is log-linear in the discount factors between
+        them; this is the case, for instance, of a
+        PiecewiseYieldCurve<Discount,LogLinear> sampled at its own
+        dates, or of a flat forward curve with continuous compounding,
+        possibly with a continuous zero spread on top.
+
+        \ingroup yieldtermstructures
+    */
+    class YieldCurveSnapshot {
+      public:
+        //! empty snapshot; it must be assigned before being used
+        YieldCurveSnapshot() = default;
+        /*! The times must be increasing; a null time, if present, is
+            ignored.  Extrapolation must be enabled on the curve if
+            any time is beyond its maximum time.
+        */
+        YieldCurveSnapshot(const YieldTermStructure& curve,
+                           const std::vector<Time>& times);
+        /*! The dates are converted to times by means of the curve;
+            therefore, the dates of an interpolated curve can be
+            passed directly.
+        */
+        YieldCurveSnapshot(const YieldTermStructure& curve,
+                           const std::vector<Date>& dates);
+        //! \name Inspectors
+        //@{
+        const Date& referenceDate() const { return referenceDate_; }
+        const DayCounter& dayCounter() const { return dayCounter_; }
+        //! sampled times, including the null reference time
+        const std::vector<Time>& times() const { return times_; }
+        //@}
+        //! \name Discount factors
+        //@{
+        DiscountFactor discount(Time t) const;
+        DiscountFactor discount(const Date& d) const;
+        /*! Writes to out the discount factors at the times in the
+            range [begin, end).  Increasing times are found in the
+            sampled grid by walking it; other times by bisection.
+        */
+        void discount(const Time* begin, const Time* end, DiscountFactor* out) const;
+        //@}
+      private:
+        void initialize(const YieldTermStructure& curve);
+        Size segment(Time t) const;
+        Real logDiscount(Time t, Size i) const {
+            return logDiscounts_[i] - forwards_[i] * (t - times_[i]);
+        }
+        Date referenceDate_;
+        DayCounter dayCounter_;
+        std::vector<Time> times_;
+        std::vector<Real> logDiscounts_, forwards_;
+    };
+
+
+    // inline definitions
+
+    inline Size YieldCurveSnapshot::segment(Time t) const {
+        QL_REQUIRE(!forwards_.empty(), "empty yield-curve snapshot");
+        QL_REQUIRE(t >= 0.0, "negative time (" << t << ") given");
+        // the last segment is extended to infinity
+        return std::upper_bound(times_.begin() + 1, times_.end() - 1, t) - times_.begin() - 1;
+    }
+
+    inline DiscountFactor YieldCurveSnapshot::discount(Time t) const {
+        return std::exp(logDiscount(t, segment(t)));
+    }
+
+    inline DiscountFactor YieldCurveSnapshot::discount(const Date& d) const {
+        return discount(dayCounter_.yearFraction(referenceDate_, d));
+    }
+
+}
+
+#endif
@@ -24,9 +24,21 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        int bitCount(unsigned long long x) {
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return int((x * 0x0101010101010101ULL) >> 56);
+        }
+
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -42,6 +54,8 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+
+        updateBusinessDayCache(_d, false);
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -59,6 +73,40 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+
+        updateBusinessDayCache(_d, true);
+    }
+
+    void Calendar::updateBusinessDayCache(const Date& d, bool businessDay) {
+        const ext::shared_ptr<detail::BusinessDayCache>& cache =
+            impl_->businessDayCache;
+        // a stale cache must stay so; the caches of calendars using
+        // this one (e.g., joint calendars) become stale.
+        bool upToDate = cache && cache->isUpToDate(impl_->version());
+        ++impl_->changes;
+        if (upToDate)
+            cache->update(d, businessDay, impl_->version());
+    }
+
+    void Calendar::enableBusinessDayCache(Year from, Year to) {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        QL_REQUIRE(from <= to, "first year (" << from
+                   << ") must not be later than last year (" << to << ")");
+        // the cache is built from the uncached calendar
+        impl_->businessDayCache.reset();
+        impl_->businessDayCache = ext::make_shared<detail::BusinessDayCache>(
+            *this, Date(1, January, from), Date(31, December, to),
+            impl_->version());
+    }
+
+    unsigned long Calendar::version(const Calendar& calendar) {
+        QL_REQUIRE(calendar.impl_, "no calendar implementation provided");
+        return calendar.impl_->version();
+    }
+
+    void Calendar::disableBusinessDayCache() {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        impl_->businessDayCache.reset();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -115,6 +163,13 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            const ext::shared_ptr<detail::BusinessDayCache>& cache =
+                impl_->businessDayCache;
+            if (cache && cache->covers(d, impl_->version())) {
+                Date d1 = cache->advance(d, n);
+                if (d1 != Date())
+                    return d1;
+            }
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -159,21 +214,22 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            const ext::shared_ptr<detail::BusinessDayCache>& cache =
+                impl_->businessDayCache;
+            unsigned long version = cache ? impl_->version() : 0;
+            if (cache && cache->covers(first, version) &&
+                cache->covers(last, version)) {
+                wd = cache->businessDays(first, last);
+            } else {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
+                for (Date d = first; d < last; ++d) {
                     if (isBusinessDay(d))
                         ++wd;
                 }
-                if (isBusinessDay(from))
+                if (isBusinessDay(last))
                     ++wd;
             }
 
@@ -304,4 +360,73 @@ namespace QuantLib {
        }
        return result;
     }
+
+
+    namespace detail {
+
+        BusinessDayCache::BusinessDayCache(const Calendar& calendar,
+                                           const Date& first,
+                                           const Date& last,
+                                           unsigned long version)
+        : first_(first.serialNumber()),
+          size_(last.serialNumber() - first.serialNumber() + 1),
+          bits_((size_ >> 6) + 1, 0ULL), counts_((size_ >> 6) + 1, 0),
+          version_(version) {
+            QL_REQUIRE(first <= last, "first date (" << first
+                       << ") must not be later than last date ("
+                       << last << ")");
+            for (Date::serial_type i = 0; i < size_; ++i) {
+                if (calendar.isBusinessDay(Date(first_ + i)))
+                    bits_[i >> 6] |= 1ULL << (i & 63);
+            }
+            for (Size j = 1; j < counts_.size(); ++j)
+                counts_[j] = counts_[j-1] + bitCount(bits_[j-1]);
+        }
+
+        Date::serial_type BusinessDayCache::rank(Date::serial_type i) const {
+            // business days in [first_, first_ + i)
+            unsigned long long mask = (1ULL << (i & 63)) - 1;
+            return counts_[i >> 6] + bitCount(bits_[i >> 6] & mask);
+        }
+
+        Date::serial_type BusinessDayCache::businessDays(
+                                                    const Date& from,
+                                                    const Date& to) const {
+            return rank(to.serialNumber() - first_ + 1)
+                - rank(from.serialNumber() - first_);
+        }
+
+        Date BusinessDayCache::advance(const Date& d, Integer n) const {
+            Date::serial_type i = d.serialNumber() - first_;
+            // index of the target among the business days in the cache
+            Date::serial_type k = n > 0 ? rank(i + 1) + n - 1 : rank(i) + n;
+            if (k < 0 || k >= rank(size_))
+                return Date();
+            Size j = std::upper_bound(counts_.begin(), counts_.end(), k)
+                - counts_.begin() - 1;
+            unsigned long long word = bits_[j];
+            for (Date::serial_type m = counts_[j]; m < k; ++m)
+                word &= word - 1;
+            Date::serial_type offset = 0;
+            while ((word & 1ULL) == 0) {
+                word >>= 1;
+                ++offset;
+            }
+            return Date(first_ + Date::serial_type(j << 6) + offset);
+        }
+
+        void BusinessDayCache::update(const Date& d, bool businessDay,
+                                      unsigned long version) {
+            Date::serial_type i = d.serialNumber() - first_;
+            if (i >= 0 && i < size_ && businessDay != isBusinessDay(d)) {
+                bits_[i >> 6] ^= 1ULL << (i & 63);
+                Date::serial_type change = businessDay ? 1 : -1;
+                for (Size j = (i >> 6) + 1; j < counts_.size(); ++j)
+                    counts_[j] += change;
+            }
+            version_ = version;
+        }
+
+    }
+
 }
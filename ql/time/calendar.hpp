@@ -32,6 +32,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <ql/shared_ptr.hpp>
+#include <atomic>
 #include <set>
 #include <vector>
 #include <string>
@@ -40,6 +41,10 @@ namespace QuantLib {
 
     class Period;
 
+    namespace detail {
+        class BusinessDayCache;
+    }
+
     //! %calendar class
     /*! This class provides methods for determining whether a date is a
         business day or a holiday for a given market, and for
@@ -67,9 +72,19 @@ namespace QuantLib {
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            /*! identifies the current set of business days; it must
+                change whenever they do, including when calendars
+                used by this one (if any) are modified.
+            */
+            virtual unsigned long version() const { return changes; }
             std::set<Date> addedHolidays, removedHolidays;
+            //! number of changes made to the business days
+            std::atomic<unsigned long> changes{0};
+            ext::shared_ptr<detail::BusinessDayCache> businessDayCache;
         };
         ext::shared_ptr<Impl> impl_;
+        //! version of the business days of the given calendar
+        static unsigned long version(const Calendar&);
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -117,6 +132,23 @@ namespace QuantLib {
         /*! Removes a date from the set of holidays for the given calendar. */
         void removeHoliday(const Date&);
 
+        /*! Precomputes the business days between the first day of
+            year \c from and the last day of year \c to.  Within that
+            range, isBusinessDay and businessDaysBetween run in
+            constant time and advance by business days in logarithmic
+            time; dates outside the range are handled as usual.
+
+            As for added and removed holidays, the cache is shared by
+            all copies of the calendar.  It is kept up to date by
+            addHoliday and removeHoliday; however, changing any other
+            calendar (e.g., one of the components of a joint calendar)
+            makes it stale, in which case it is ignored until this
+            method is called again.
+        */
+        void enableBusinessDayCache(Year from, Year to);
+        /*! Removes the cache of business days, if any. */
+        void disableBusinessDayCache();
+
         /*! Returns the holidays between two dates. */
         std::vector<Date> holidayList(const Date& from,
                                       const Date& to,
@@ -156,6 +188,9 @@ namespace QuantLib {
                                               bool includeLast = false) const;
         //@}
 
+      private:
+        void updateBusinessDayCache(const Date&, bool businessDay);
+
       protected:
         //! partial calendar implementation
         /*! This class provides the means of determining the Easter
@@ -194,6 +229,49 @@ namespace QuantLib {
     std::ostream& operator<<(std::ostream&, const Calendar&);
 
 
+    namespace detail {
+
+        //! precomputed business days of a calendar
+        /*! Business days are stored as a bitmap, one bit per day,
+            together with the number of business days preceding each
+            64-day block; the two allow to count business days in a
+            range or to find the n-th one without looping over dates.
+
+            The cache is built for a given version of the calendar
+            (see Calendar::Impl::version) and is considered stale
+            when passed any other.
+        */
+        class BusinessDayCache {
+          public:
+            BusinessDayCache(const Calendar& calendar,
+                             const Date& first,
+                             const Date& last,
+                             unsigned long version);
+            //! whether the cache is up to date and contains the date
+            bool covers(const Date& d, unsigned long version) const;
+            bool isBusinessDay(const Date& d) const;
+            //! number of business days in the closed range [from, to]
+            Date::serial_type businessDays(const Date& from,
+                                           const Date& to) const;
+            /*! returns the date n business days after (or, if n is
+                negative, before) the given one, or a null date if the
+                result is out of range.
+            */
+            Date advance(const Date& d, Integer n) const;
+            //! records a change in the given date and marks the cache as up to date
+            void update(const Date& d, bool businessDay, unsigned long version);
+            bool isUpToDate(unsigned long version) const;
+          private:
+            Date::serial_type rank(Date::serial_type i) const;
+            Date::serial_type first_, size_;
+            std::vector<unsigned long long> bits_;
+            std::vector<Date::serial_type> counts_;
+            unsigned long version_;
+        };
+
+    }
+
+
     // inline definitions
 
     inline bool Calendar::empty() const {
@@ -226,6 +304,11 @@ namespace QuantLib {
         const Date& _d = d;
 #endif
 
+        const ext::shared_ptr<detail::BusinessDayCache>& cache =
+            impl_->businessDayCache;
+        if (cache && cache->covers(_d, impl_->version()))
+            return cache->isBusinessDay(_d);
+
         if (!impl_->addedHolidays.empty() &&
             impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
             return false;
@@ -254,6 +337,25 @@ namespace QuantLib {
         return impl_->isWeekend(w);
     }
 
+    namespace detail {
+
+        inline bool BusinessDayCache::isUpToDate(unsigned long version) const {
+            return version_ == version;
+        }
+
+        inline bool BusinessDayCache::covers(const Date& d,
+                                             unsigned long version) const {
+            Date::serial_type i = d.serialNumber() - first_;
+            return version_ == version && i >= 0 && i < size_;
+        }
+
+        inline bool BusinessDayCache::isBusinessDay(const Date& d) const {
+            Date::serial_type i = d.serialNumber() - first_;
+            return ((bits_[i >> 6] >> (i & 63)) & 1ULL) != 0;
+        }
+
+    }
+
     inline bool operator==(const Calendar& c1, const Calendar& c2) {
         return (c1.empty() && c2.empty())
             || (!c1.empty() && !c2.empty() && c1.name() == c2.name());
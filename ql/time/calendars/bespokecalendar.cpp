@@ -50,6 +50,8 @@ namespace QuantLib {
 
     void BespokeCalendar::addWeekend(Weekday w) {
         bespokeImpl_->addWeekend(w);
+        // business days changed; cached ones are no longer valid
+        ++bespokeImpl_->changes;
     }
 
 }
@@ -120,6 +120,14 @@ namespace QuantLib {
         }
     }
 
+    unsigned long JointCalendar::Impl::version() const {
+        // the versions only increase, and so does their sum
+        unsigned long result = changes;
+        for (const auto& calendar : calendars_)
+            result += Calendar::version(calendar);
+        return result;
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
@@ -47,6 +47,10 @@ namespace QuantLib {
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
 
+        Since checking a date requires querying each of the given
+        calendars, heavy users might want to call
+        enableBusinessDayCache() on the joint calendar.
+
         \ingroup calendars
 
         \test the correctness of the returned results is tested by
@@ -67,6 +71,7 @@ namespace QuantLib {
             std::string name() const override;
             bool isWeekend(Weekday) const override;
             bool isBusinessDay(const Date&) const override;
+            unsigned long version() const override;
 
           private:
             JointCalendarRule rule_;
@@ -29,6 +29,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
 #include <ql/functional.hpp>
+#include <boost/container/flat_map.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
 #include <boost/utility.hpp>
@@ -43,10 +44,17 @@ namespace QuantLib {
         date, while sets of consecutive data can be accessed through
         iterators.
 
+        By default, data are stored contiguously in a vector sorted by
+        date; this makes lookups and copies cheap, and so is adding
+        data in chronological order.  Adding data for earlier dates
+        takes linear time and invalidates iterators; if that's the
+        common case, <c>std::map<Date,T></c> can be passed as the
+        container type instead.
+
         \pre The <c>Container</c> type must satisfy the requirements
              set by the C++ standard for associative containers.
     */
-    template <class T, class Container = std::map<Date, T> >
+    template <class T, class Container = boost::container::flat_map<Date, T> >
     class TimeSeries {
       public:
         typedef Date key_type;
@@ -58,13 +66,18 @@ namespace QuantLib {
         TimeSeries() = default;
         /*! This constructor initializes the history with a set of
             values passed as two sequences, the first containing dates
-            and the second containing corresponding values.
+            and the second containing corresponding values.  If a date
+            is repeated, the last corresponding value is kept.
+
+            When the dates are sorted, as is the case for columns of
+            data loaded from a file or a database, the history is built
+            in linear time.
         */
         template <class DateIterator, class ValueIterator>
         TimeSeries(DateIterator dBegin, DateIterator dEnd,
                    ValueIterator vBegin) {
             while (dBegin != dEnd)
-                values_[*(dBegin++)] = *(vBegin++);
+                append(*(dBegin++), *(vBegin++));
         }
         /*! This constructor initializes the history with a set of
             values. Such values are assigned to a corresponding number
@@ -76,7 +89,7 @@ namespace QuantLib {
                    ValueIterator begin, ValueIterator end) {
             Date d = firstDate;
             while (begin != end)
-                values_[d++] = *(begin++);
+                append(d++, *(begin++));
         }
         //! \name Inspectors
         //@{
@@ -93,8 +106,9 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
+            typename Container::const_iterator i = values_.find(d);
+            if (i != values_.end())
+                return i->second;
             else
                 return Null<T>();
         }
@@ -229,6 +243,12 @@ namespace QuantLib {
         //@}
 
       private:
+        // the hint makes insertion in chronological order cheap
+        void append(const Date& d, const T& value) {
+            typename Container::iterator i =
+                values_.insert(values_.end(), std::make_pair(d, value));
+            i->second = value;
+        }
         static const Date& get_time (const container_value_type& v) {
             return v.first;
         }
@@ -69,6 +69,17 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to have singletons return different instances for
+   different threads, with no need for a sessionId() function.
+   Each thread starts with default settings (e.g., today's date as
+   the evaluation date) and its instances are destroyed when it
+   exits; therefore, objects built in a thread should not be used
+   from other threads.  Not compatible with QL_ENABLE_SESSIONS.
+*/
+#ifndef QL_ENABLE_THREAD_LOCAL_SESSIONS
+//#   define QL_ENABLE_THREAD_LOCAL_SESSIONS
+#endif
+
 /* Define this to enable the thread-safe observer pattern. You should
    enable it if you want to use QuantLib via the SWIG layer within
    the JVM or .NET eco system or any environment with an
@@ -9,6 +9,7 @@
 #include <ql/utilities/null_deleter.hpp>
 #include <ql/utilities/observablevalue.hpp>
 #include <ql/utilities/steppingiterator.hpp>
+#include <ql/utilities/threads.hpp>
 #include <ql/utilities/tracing.hpp>
 #include <ql/utilities/vectors.hpp>
 
@@ -0,0 +1,41 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file threads.hpp
+    \brief utilities for classes that can run on several threads
+*/
+
+#ifndef quantlib_threads_hpp
+#define quantlib_threads_hpp
+
+#include <ql/errors.hpp>
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! checks a number of threads passed by the user
+        inline void checkThreads(Size threads) {
+            QL_REQUIRE(threads > 0, "at least one thread required");
+        }
+
+    }
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include "utilities.hpp"
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/andersenlakeoffengendenengine.hpp>
 #include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
 #include <ql/pricingengines/vanilla/bjerksundstenslandengine.hpp>
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
@@ -424,6 +425,197 @@ void AmericanOptionTest::testFdValues() {
 }
 
 
+void AmericanOptionTest::testAndersenLakeOffengendenValues() {
+
+    BOOST_TEST_MESSAGE("Testing Andersen-Lake-Offengenden engine "
+                       "for American options...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    DayCounter dc = Actual360();
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(0.0));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.0));
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.0));
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS));
+
+    typedef AndersenLakeOffengendenEngine ALO;
+
+    // the reference values are calculated by the engine itself with
+    // a much finer discretization; they are checked against a fine
+    // finite-difference grid, whose error is up to about 5e-3 here
+    ext::shared_ptr<PricingEngine> referenceEngine =
+        ext::make_shared<ALO>(stochProcess, 201, 16, 65, 401);
+    ext::shared_ptr<PricingEngine> fdEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(stochProcess, 800, 800);
+    const Real fdTolerance = 1.0e-2;
+
+    const std::pair<ext::shared_ptr<PricingEngine>, Real> engines[] = {
+        std::make_pair(ext::make_shared<ALO>(stochProcess, ALO::Fast), 1.0e-3),
+        std::make_pair(ext::make_shared<ALO>(stochProcess, ALO::Accurate), 1.0e-4),
+        std::make_pair(ext::make_shared<ALO>(stochProcess, ALO::HighPrecision), 1.0e-5),
+        std::make_pair(ext::make_shared<ALO>(stochProcess, ALO::Accurate, ALO::FP_A), 5.0e-4),
+        std::make_pair(ext::make_shared<ALO>(stochProcess, ALO::Accurate, ALO::FP_B), 1.0e-4)
+    };
+    const Size nEngines = LENGTH(engines);
+    std::vector<Real> maxError(nEngines, 0.0);
+
+    for (auto& juValue : juValues) {
+
+        ext::shared_ptr<StrikedTypePayoff> payoff(
+            new PlainVanillaPayoff(juValue.type, juValue.strike));
+
+        Date exDate = today + timeToDays(juValue.t);
+        ext::shared_ptr<Exercise> exercise(
+                                         new AmericanExercise(today, exDate));
+
+        spot->setValue(juValue.s);
+        qRate->setValue(juValue.q);
+        rRate->setValue(juValue.r);
+        vol->setValue(juValue.v);
+
+        VanillaOption option(payoff, exercise);
+        option.setPricingEngine(referenceEngine);
+        Real expected = option.NPV();
+
+        option.setPricingEngine(fdEngine);
+        Real fdValue = option.NPV();
+        if (std::fabs(fdValue - expected) > fdTolerance) {
+            REPORT_FAILURE("reference value", payoff, exercise, juValue.s, juValue.q,
+                           juValue.r, today, juValue.v, fdValue, expected,
+                           std::fabs(fdValue - expected), fdTolerance);
+        }
+
+        for (Size i=0; i<nEngines; ++i) {
+            option.setPricingEngine(engines[i].first);
+
+            Real calculated = option.NPV();
+            Real error = std::fabs(calculated - expected);
+            maxError[i] = std::max(maxError[i], error);
+            Real tolerance = engines[i].second;
+            if (error > tolerance) {
+                REPORT_FAILURE("value", payoff, exercise, juValue.s, juValue.q, juValue.r,
+                               today, juValue.v, expected, calculated, error, tolerance);
+            }
+        }
+    }
+
+    // the error must decrease with the required accuracy
+    if (maxError[1] >= maxError[0] || maxError[2] >= maxError[1]) {
+        BOOST_ERROR("errors not decreasing with accuracy:"
+                    << std::scientific
+                    << "\n    Fast:          " << maxError[0]
+                    << "\n    Accurate:      " << maxError[1]
+                    << "\n    HighPrecision: " << maxError[2]);
+    }
+}
+
+
+void AmericanOptionTest::testAndersenLakeOffengendenGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing Andersen-Lake-Offengenden engine "
+                       "greeks for American options...");
+
+    SavedSettings backup;
+
+    std::map<std::string,Real> calculated, expected, tolerance;
+    tolerance["delta"] = 1.0e-6;
+    tolerance["gamma"] = 1.0e-6;
+    tolerance["theta"] = 2.0e-2;
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 90.0, 100.0, 110.0 };
+    Rate qRates[] = { 0.0, 0.03, 0.08 };
+    Rate rRates[] = { 0.01, 0.05 };
+    Volatility vols[] = { 0.2, 0.5 };
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    Real u = 100.0;
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(u));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.0));
+    Handle<YieldTermStructure> qTS(flatRate(qRate, dc));
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.0));
+    Handle<YieldTermStructure> rTS(flatRate(rRate, dc));
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.0));
+    Handle<BlackVolTermStructure> volTS(flatVol(vol, dc));
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot), qTS, rTS, volTS));
+
+    ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<AndersenLakeOffengendenEngine>(stochProcess);
+    ext::shared_ptr<PricingEngine> fdEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(stochProcess, 800, 800);
+
+    Date exDate = today + 1 * Years;
+    ext::shared_ptr<Exercise> exercise(new AmericanExercise(today, exDate));
+
+    for (auto& type : types) {
+        for (Real strike : strikes) {
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                new PlainVanillaPayoff(type, strike));
+
+            VanillaOption option(payoff, exercise);
+
+            for (Rate q : qRates) {
+                for (Rate r : rRates) {
+                    for (Volatility v : vols) {
+                        qRate->setValue(q);
+                        rRate->setValue(r);
+                        vol->setValue(v);
+
+                        option.setPricingEngine(fdEngine);
+                        expected["theta"] = option.theta();
+
+                        option.setPricingEngine(engine);
+                        option.NPV();
+                        calculated["delta"] = option.delta();
+                        calculated["gamma"] = option.gamma();
+                        calculated["theta"] = option.theta();
+
+                        // perturb spot and get delta and gamma
+                        Real du = u * 1.0e-4;
+                        spot->setValue(u + du);
+                        Real value_p = option.NPV(), delta_p = option.delta();
+                        spot->setValue(u - du);
+                        Real value_m = option.NPV(), delta_m = option.delta();
+                        spot->setValue(u);
+                        expected["delta"] = (value_p - value_m) / (2 * du);
+                        expected["gamma"] = (delta_p - delta_m) / (2 * du);
+
+                        for (const auto& it : calculated) {
+                            const std::string& greek = it.first;
+                            Real expct = expected[greek], calcl = it.second,
+                                 tol = tolerance[greek];
+                            Real error = std::fabs(expct - calcl);
+                            if (error > tol) {
+                                REPORT_FAILURE(greek, payoff, exercise, u, q, r,
+                                               today, v, expct, calcl, error, tol);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 namespace {
 
     template <class Engine>
@@ -909,6 +1101,8 @@ test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testBjerksundStenslandValues));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testJuValues));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdValues));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testAndersenLakeOffengendenValues));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testAndersenLakeOffengendenGreeks));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFDShoutNPV));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testZeroVolFDShoutNPV));
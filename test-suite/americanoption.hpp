@@ -34,6 +34,8 @@ class AmericanOptionTest {
     static void testBjerksundStenslandValues();
     static void testJuValues();
     static void testFdValues();
+    static void testAndersenLakeOffengendenValues();
+    static void testAndersenLakeOffengendenGreeks();
     static void testFdAmericanGreeks();
     static void testFdShoutGreeks();
     static void testFDShoutNPV();
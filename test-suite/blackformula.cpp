@@ -434,6 +434,131 @@ void BlackFormulaTest::testBachelierBlackFormulaForwardDerivativeWithZeroVolatil
     assertBachelierBlackFormulaForwardDerivative(Option::Put, strikes, vol);
 }
 
+void BlackFormulaTest::testBatchFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black and Bachelier formulas...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0, 0.01};
+    Real strikes[] = {0.0, 0.005, 0.01, 0.02, 0.03, 0.05, 0.1};
+    Real stdDevs[] = {0.0, 0.01, 0.1, 0.3, 1.0, 3.0};
+    Real forward = 0.03, discount = 0.95;
+
+    std::vector<Option::Type> batchTypes;
+    std::vector<Real> batchStrikes, batchStdDevs;
+    for (auto type : types) {
+        for (Real strike : strikes) {
+            for (Real stdDev : stdDevs) {
+                batchTypes.push_back(type);
+                batchStrikes.push_back(strike);
+                batchStdDevs.push_back(stdDev);
+            }
+        }
+    }
+    const Size n = batchTypes.size();
+    Array k(batchStrikes.begin(), batchStrikes.end());
+    Array s(batchStdDevs.begin(), batchStdDevs.end());
+    Array f(n, forward), d(n, discount);
+
+    const Real tol = 1.0e-14;
+
+    for (Real displacement : displacements) {
+        Array prices = blackFormula(batchTypes, k, f, s, d, displacement);
+        for (Size i=0; i<n; ++i) {
+            Real expected = blackFormula(batchTypes[i], k[i], f[i], s[i],
+                                         d[i], displacement);
+            if (std::fabs(prices[i]-expected) > tol) {
+                BOOST_ERROR("batch Black formula differs from scalar one"
+                            << "\n option type:  " << batchTypes[i]
+                            << "\n strike:       " << k[i]
+                            << "\n forward:      " << f[i]
+                            << "\n stdDev:       " << s[i]
+                            << "\n displacement: " << displacement
+                            << "\n batch:        " << prices[i]
+                            << "\n scalar:       " << expected);
+            }
+        }
+    }
+
+    Array normalStdDevs = s*0.01;
+    Array prices = bachelierBlackFormula(batchTypes, k, f, normalStdDevs, d);
+    for (Size i=0; i<n; ++i) {
+        Real expected = bachelierBlackFormula(batchTypes[i], k[i], f[i],
+                                              normalStdDevs[i], d[i]);
+        if (std::fabs(prices[i]-expected) > tol) {
+            BOOST_ERROR("batch Bachelier formula differs from scalar one"
+                        << "\n option type: " << batchTypes[i]
+                        << "\n strike:      " << k[i]
+                        << "\n forward:     " << f[i]
+                        << "\n stdDev:      " << normalStdDevs[i]
+                        << "\n batch:       " << prices[i]
+                        << "\n scalar:      " << expected);
+        }
+    }
+}
+
+void BlackFormulaTest::testBatchImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black implied standard deviation...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0, 0.005};
+    Real forward = 100.0, discount = 0.9;
+    Real stdDevs[] = {0.01, 0.05, 0.1, 0.2, 0.5, 1.0, 2.0};
+
+    std::vector<Option::Type> batchTypes;
+    std::vector<Real> batchStrikes, batchStdDevs;
+    for (auto type : types) {
+        for (Real m=-2.0; m<=2.0; m+=0.25) {
+            for (Real stdDev : stdDevs) {
+                batchTypes.push_back(type);
+                batchStrikes.push_back(forward*std::exp(m*stdDev));
+                batchStdDevs.push_back(stdDev);
+            }
+        }
+    }
+    // an option at zero price must give zero standard deviation
+    batchTypes.push_back(Option::Call);
+    batchStrikes.push_back(2.0*forward);
+    batchStdDevs.push_back(0.0);
+
+    const Size n = batchTypes.size();
+    Array k(batchStrikes.begin(), batchStrikes.end());
+    Array s(batchStdDevs.begin(), batchStdDevs.end());
+    Array f(n, forward), d(n, discount);
+
+    const Real accuracy = 1.0e-10, tol = 1.0e-8;
+
+    for (Real displacement : displacements) {
+        Array prices = blackFormula(batchTypes, k, f, s, d, displacement);
+        Array implied = blackFormulaImpliedStdDev(batchTypes, k, f, prices, d,
+                                                  displacement, accuracy);
+        for (Size i=0; i<n; ++i) {
+            Real scalar = blackFormulaImpliedStdDev(
+                batchTypes[i], k[i], f[i], prices[i], d[i], displacement,
+                Null<Real>(), accuracy);
+            // the price can lose all sensitivity to the volatility far
+            // from the money, so check the repriced option as well
+            Real repriced = blackFormula(batchTypes[i], k[i], f[i],
+                                         implied[i], d[i], displacement);
+            if (std::fabs(implied[i]-scalar) > tol
+                || std::fabs(repriced-prices[i]) > tol*forward) {
+                BOOST_ERROR("failed to recover standard deviation"
+                            << std::setprecision(12)
+                            << "\n option type:  " << batchTypes[i]
+                            << "\n strike:       " << k[i]
+                            << "\n forward:      " << f[i]
+                            << "\n price:        " << prices[i]
+                            << "\n displacement: " << displacement
+                            << "\n expected:     " << s[i]
+                            << "\n batch:        " << implied[i]
+                            << "\n scalar:       " << scalar
+                            << "\n repriced:     " << repriced);
+            }
+        }
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -457,6 +582,8 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierBlackFormulaForwardDerivative));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testBachelierBlackFormulaForwardDerivativeWithZeroVolatility));
+    suite->add(QUANTLIB_TEST_CASE(&BlackFormulaTest::testBatchFormulas));
+    suite->add(QUANTLIB_TEST_CASE(&BlackFormulaTest::testBatchImpliedStdDev));
 
     return suite;
 }
@@ -38,6 +38,8 @@ class BlackFormulaTest {
     static void testBlackFormulaForwardDerivativeWithZeroVolatility();
     static void testBachelierBlackFormulaForwardDerivative();
     static void testBachelierBlackFormulaForwardDerivativeWithZeroVolatility();
+    static void testBatchFormulas();
+    static void testBatchImpliedStdDev();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -2169,6 +2169,109 @@ void CalendarTest::testDayLists() {
     }
 }
 
+void CalendarTest::testBusinessDayCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached business days...");
+
+    Calendar uk = UnitedKingdom(UnitedKingdom::Exchange);
+    Calendar japan = Japan();
+    Calendar cached = JointCalendar(uk, japan);
+    // same calendar, separate implementation without cache
+    Calendar plain = JointCalendar(uk, japan);
+
+    Date from(1, January, 2000), to(31, December, 2030);
+    Integer steps[] = { -40, -3, -1, 1, 3, 40 };
+    Date::serial_type lengths[] = { 1, 30, 400 };
+
+    auto compare = [&](const std::string& stage) {
+        for (Date d = from; d <= to; ++d) {
+            if (cached.isBusinessDay(d) != plain.isBusinessDay(d))
+                BOOST_FAIL(stage << ": mismatch for " << d
+                           << "\n    cached: " << cached.isBusinessDay(d)
+                           << "\n    plain:  " << plain.isBusinessDay(d));
+            if (d.serialNumber() % 7 != 0)
+                continue;
+            for (Integer n : steps) {
+                Date d1 = cached.advance(d, n, Days);
+                Date d2 = plain.advance(d, n, Days);
+                if (d1 != d2)
+                    BOOST_FAIL(stage << ": advancing " << d << " by "
+                               << n << " business days"
+                               << "\n    cached: " << d1
+                               << "\n    plain:  " << d2);
+            }
+            for (Date::serial_type l : lengths) {
+                for (Integer i = 0; i < 4; ++i) {
+                    bool includeFirst = i % 2 != 0, includeLast = i / 2 != 0;
+                    Date::serial_type n1 = cached.businessDaysBetween(
+                        d, d + l, includeFirst, includeLast);
+                    Date::serial_type n2 = plain.businessDaysBetween(
+                        d, d + l, includeFirst, includeLast);
+                    Date::serial_type n3 = cached.businessDaysBetween(
+                        d + l, d, includeFirst, includeLast);
+                    Date::serial_type n4 = plain.businessDaysBetween(
+                        d + l, d, includeFirst, includeLast);
+                    if (n1 != n2 || n3 != n4)
+                        BOOST_FAIL(stage << ": business days between " << d
+                                   << " and " << d + l
+                                   << "\n    cached: " << n1 << ", " << n3
+                                   << "\n    plain:  " << n2 << ", " << n4);
+                }
+            }
+        }
+    };
+
+    cached.enableBusinessDayCache(2005, 2025);
+    compare("joint calendar");
+
+    // changes to a component make the joint cache stale
+    Date holiday(15, March, 2011);
+    uk.addHoliday(holiday);
+    if (cached.isBusinessDay(holiday))
+        BOOST_ERROR("stale cache used after adding " << holiday
+                    << " to component calendar");
+    compare("stale joint calendar");
+
+    cached.enableBusinessDayCache(2005, 2025);
+    compare("rebuilt joint calendar");
+
+    // changes to the cached calendar itself update its cache
+    uk.enableBusinessDayCache(2005, 2025);
+    Date start(1, January, 2011), end(31, December, 2011);
+    Date::serial_type expected = uk.businessDaysBetween(start, end);
+    uk.removeHoliday(holiday);
+    if (uk.isHoliday(holiday))
+        BOOST_ERROR(holiday << " still a holiday after removal");
+    if (uk.businessDaysBetween(start, end) != expected + 1)
+        BOOST_ERROR("wrong number of business days after removing "
+                    << holiday << " from cached calendar"
+                    << "\n    calculated: " << uk.businessDaysBetween(start, end)
+                    << "\n    expected:   " << expected + 1);
+    if (uk.advance(Date(14, March, 2011), 1, Days) != holiday)
+        BOOST_ERROR("wrong date after removing " << holiday
+                    << " from cached calendar"
+                    << "\n    calculated: "
+                    << uk.advance(Date(14, March, 2011), 1, Days)
+                    << "\n    expected:   " << holiday);
+
+    cached.enableBusinessDayCache(2005, 2025);
+    compare("joint calendar with cached component");
+
+    uk.disableBusinessDayCache();
+    cached.disableBusinessDayCache();
+
+    // changes to the weekend of bespoke calendars make their cache stale
+    BespokeCalendar bespoke("bespoke");
+    bespoke.enableBusinessDayCache(2005, 2025);
+    Date saturday(19, March, 2011);
+    if (!bespoke.isBusinessDay(saturday))
+        BOOST_ERROR(saturday << " not a business day for bespoke calendar");
+    bespoke.addWeekend(Saturday);
+    if (bespoke.isBusinessDay(saturday))
+        BOOST_ERROR("stale cache used after adding Saturday to the weekend"
+                    " of bespoke calendar");
+}
+
 test_suite* CalendarTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -2208,6 +2311,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testIntradayAddHolidays));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testDayLists));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayCache));
 
     return suite;
 }
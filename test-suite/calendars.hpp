@@ -63,6 +63,7 @@ class CalendarTest {
 
     static void testIntradayAddHolidays();
     static void testDayLists();
+    static void testBusinessDayCache();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -27,9 +28,13 @@
 #include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/yieldcurvesnapshot.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
@@ -538,6 +543,129 @@ void CashFlowsTest::testFixedIborCouponWithoutForecastCurve() {
     }
 }
 
+void CashFlowsTest::testCompiledLeg() {
+
+    BOOST_TEST_MESSAGE("Testing cash-flow analysis of compiled legs...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, June, 2023);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> curve(
+        ext::make_shared<FlatForward>(today, 0.03, Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index = ext::make_shared<Euribor6M>(curve);
+
+    // a fixed-rate leg with past coupons, ex-coupon dates and a
+    // redemption, and a floating-rate leg starting in the future
+    Schedule fixedSchedule = MakeSchedule()
+                                 .from(Date(10, January, 2022))
+                                 .to(Date(10, January, 2033))
+                                 .withFrequency(Semiannual)
+                                 .withCalendar(TARGET())
+                                 .withConvention(Following);
+    Leg fixedLeg = FixedRateLeg(fixedSchedule)
+                       .withNotionals(100.0)
+                       .withCouponRates(0.04, Thirty360(Thirty360::BondBasis))
+                       .withExCouponPeriod(Period(5, Days), TARGET(), Preceding, false);
+    fixedLeg.push_back(ext::make_shared<Redemption>(100.0, fixedLeg.back()->date()));
+
+    Schedule floatingSchedule = MakeSchedule()
+                                    .from(Date(20, July, 2023))
+                                    .to(Date(20, July, 2033))
+                                    .withFrequency(Semiannual)
+                                    .withCalendar(TARGET())
+                                    .withConvention(ModifiedFollowing);
+    Leg floatingLeg = IborLeg(floatingSchedule, index)
+                          .withNotionals(100.0)
+                          .withSpreads(0.001);
+
+    // a settlement date equal to a payment date, besides today
+    std::vector<Date> settlementDates = { today, fixedLeg[5]->date() };
+
+    Real tolerance = 1.0e-10;
+    for (const Leg& leg : { fixedLeg, floatingLeg }) {
+        CompiledLeg compiled(leg);
+        for (bool includeSettlementDateFlows : { false, true }) {
+            for (const Date& settlementDate : settlementDates) {
+
+                #define CHECK_SAME(what, calculated, expected) \
+                if ((calculated) != (expected)) \
+                    BOOST_ERROR("failed to reproduce " << what \
+                                << " with settlement date " << settlementDate \
+                                << (includeSettlementDateFlows ? " (included)" : "") \
+                                << std::setprecision(17) \
+                                << "\n    calculated: " << (calculated) \
+                                << "\n    expected:   " << (expected));
+
+                CHECK_SAME("NPV",
+                           CashFlows::npv(compiled, **curve, includeSettlementDateFlows,
+                                          settlementDate),
+                           CashFlows::npv(leg, **curve, includeSettlementDateFlows,
+                                          settlementDate));
+                CHECK_SAME("BPS",
+                           CashFlows::bps(compiled, **curve, includeSettlementDateFlows,
+                                          settlementDate),
+                           CashFlows::bps(leg, **curve, includeSettlementDateFlows,
+                                          settlementDate));
+
+                Real npv = 0.0, bps = 0.0, expectedNPV = 0.0, expectedBPS = 0.0;
+                CashFlows::npvbps(compiled, **curve, includeSettlementDateFlows,
+                                  settlementDate, settlementDate, npv, bps);
+                CashFlows::npvbps(leg, **curve, includeSettlementDateFlows,
+                                  settlementDate, settlementDate, expectedNPV, expectedBPS);
+                CHECK_SAME("NPV from npvbps", npv, expectedNPV);
+                CHECK_SAME("BPS from npvbps", bps, expectedBPS);
+
+                DayCounter dc = ActualActual(ActualActual::ISMA);
+                Rate yield = CashFlows::yield(compiled, 0.9 * npv, dc, Compounded, Semiannual,
+                                              includeSettlementDateFlows, settlementDate);
+                CHECK_SAME("yield", yield,
+                           CashFlows::yield(leg, 0.9 * npv, dc, Compounded, Semiannual,
+                                            includeSettlementDateFlows, settlementDate));
+
+                InterestRate rate(yield, dc, Compounded, Semiannual);
+                for (Duration::Type type :
+                         { Duration::Simple, Duration::Modified, Duration::Macaulay }) {
+                    CHECK_SAME("duration",
+                               CashFlows::duration(compiled, rate, type,
+                                                   includeSettlementDateFlows,
+                                                   settlementDate),
+                               CashFlows::duration(leg, rate, type,
+                                                   includeSettlementDateFlows,
+                                                   settlementDate));
+                }
+
+                #undef CHECK_SAME
+            }
+        }
+
+        // discount scenarios; the snapshots reproduce the flat curves
+        std::vector<Rate> rates = { 0.01, 0.02, 0.03, 0.05 };
+        std::vector<Time> times = { 1.0, 5.0, 10.0, 20.0 };
+        std::vector<YieldCurveSnapshot> scenarios;
+        for (Rate r : rates)
+            scenarios.emplace_back(FlatForward(today, r, Actual365Fixed()), times);
+        std::vector<Real> npvs = CashFlows::npv(compiled, scenarios, false);
+        std::vector<Real> bpss = CashFlows::bps(compiled, scenarios, false);
+        for (Size i=0; i<rates.size(); ++i) {
+            FlatForward scenario(today, rates[i], Actual365Fixed());
+            Real expectedNPV = CashFlows::npv(leg, scenario, false);
+            Real expectedBPS = CashFlows::bps(leg, scenario, false);
+            if (std::fabs(npvs[i] - expectedNPV) > tolerance)
+                BOOST_ERROR("failed to reproduce NPV in scenario #" << i+1 << ":"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << npvs[i]
+                            << "\n    expected:   " << expectedNPV);
+            if (std::fabs(bpss[i] - expectedBPS) > tolerance)
+                BOOST_ERROR("failed to reproduce BPS in scenario #" << i+1 << ":"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << bpss[i]
+                            << "\n    expected:   " << expectedBPS);
+        }
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -552,6 +680,7 @@ test_suite* CashFlowsTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testPartialScheduleLegConstruction));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testFixedIborCouponWithoutForecastCurve));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
 
     return suite;
 }
@@ -33,6 +33,7 @@ class CashFlowsTest {
     static void testIrregularLastCouponReferenceDatesAtEndOfMonth();
     static void testPartialScheduleLegConstruction();
     static void testFixedIborCouponWithoutForecastCurve();
+    static void testCompiledLeg();
     static boost::unit_test_framework::test_suite* suite();
 };
 
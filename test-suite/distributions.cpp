@@ -753,6 +753,85 @@ void DistributionTest::testSankaranApproximation() {
     }
 }
 
+void DistributionTest::testBatchEvaluation() {
+
+    BOOST_TEST_MESSAGE("Testing batch evaluation of normal distributions...");
+
+    // the batch versions are expected to reproduce the scalar ones;
+    // the tolerance only allows for different floating-point
+    // contractions in vectorized code
+    const Real tolerance = 1.0e-15;
+
+    std::vector<Real> x;
+    for (Real v=-40.0; v<=40.0; v+=0.0173)
+        x.push_back(v);
+    x.push_back(0.0);
+    x.push_back(1.0e-12);
+    x.push_back(-1.0e-300);
+    std::vector<Real> result(x.size());
+
+    CumulativeNormalDistribution cdf(0.3, 1.7);
+    cdf(x.data(), x.data()+x.size(), result.data());
+    for (Size i=0; i<x.size(); ++i) {
+        Real expected = cdf(x[i]);
+        if (std::fabs(result[i]-expected) > tolerance*expected) {
+            BOOST_ERROR("batch cumulative normal distribution differs "
+                        "from scalar one at x = " << x[i]
+                        << std::setprecision(17)
+                        << "\n    batch:  " << result[i]
+                        << "\n    scalar: " << expected);
+        }
+    }
+
+    std::vector<Real> u;
+    for (Real v=1.0e-10; v<1.0; v+=0.000731)
+        u.push_back(v);
+    u.push_back(1.0-1.0e-10);
+    result.resize(u.size());
+
+    InverseCumulativeNormal invCdf(0.1, 2.0);
+    invCdf(u.data(), u.data()+u.size(), result.data());
+    for (Size i=0; i<u.size(); ++i) {
+        Real expected = invCdf(u[i]);
+        if (std::fabs(result[i]-expected) > tolerance*std::fabs(expected)) {
+            BOOST_ERROR("batch inverse cumulative normal distribution "
+                        "differs from scalar one at x = " << u[i]
+                        << std::setprecision(17)
+                        << "\n    batch:  " << result[i]
+                        << "\n    scalar: " << expected);
+        }
+    }
+
+    std::vector<Real> a, b;
+    for (Real v=-6.0; v<=6.0; v+=0.25) {
+        for (Real w=-6.0; w<=6.0; w+=0.5) {
+            a.push_back(v);
+            b.push_back(w);
+        }
+    }
+    result.resize(a.size());
+
+    Real rhos[] = { -1.0, -0.95, -0.8, -0.5, -0.1, 0.0,
+                    0.2, 0.6, 0.9, 0.95, 1.0 };
+    for (Real rho : rhos) {
+        BivariateCumulativeNormalDistributionWe04DP bivariate(rho);
+        bivariate(a.data(), a.data()+a.size(), b.data(), result.data());
+        for (Size i=0; i<a.size(); ++i) {
+            Real expected = bivariate(a[i], b[i]);
+            if (std::fabs(result[i]-expected) > tolerance) {
+                BOOST_ERROR("batch bivariate cumulative normal distribution "
+                            "differs from scalar one"
+                            << std::setprecision(17)
+                            << "\n    rho:    " << rho
+                            << "\n    a:      " << a[i]
+                            << "\n    b:      " << b[i]
+                            << "\n    batch:  " << result[i]
+                            << "\n    scalar: " << expected);
+            }
+        }
+    }
+}
+
 test_suite* DistributionTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Distribution tests");
 
@@ -764,6 +843,7 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariateCumulativeStudent));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testInvCDFviaStochasticCollocation));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testSankaranApproximation));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBatchEvaluation));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariateCumulativeStudentVsBivariate));
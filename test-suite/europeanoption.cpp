@@ -24,6 +24,8 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/math/randomnumbers/haltonrsg.hpp>
+#include <ql/math/randomnumbers/knuthuniformrng.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
@@ -1253,6 +1255,98 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcParallelSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing parallel Monte Carlo simulation "
+                       "against serial results...");
+
+    SavedSettings backup;
+
+    const Date today(28, January, 2021);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual360();
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.06, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    EuropeanOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    for (Size threads=1; threads<=4; ++threads) {
+        for (Size antithetic=0; antithetic<2; ++antithetic) {
+            // tolerance-driven, so that samples are added in batches
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(10)
+                .withAntitheticVariate(antithetic != 0U)
+                .withAbsoluteTolerance(0.05)
+                .withSeed(42));
+            const Real serialNPV = option.NPV();
+            const Real serialError = option.errorEstimate();
+
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(10)
+                .withAntitheticVariate(antithetic != 0U)
+                .withAbsoluteTolerance(0.05)
+                .withSeed(42)
+                .withThreads(threads));
+            const Real parallelNPV = option.NPV();
+            const Real parallelError = option.errorEstimate();
+
+            if (serialNPV != parallelNPV || serialError != parallelError)
+                BOOST_ERROR("failed to reproduce serial pseudo-random result"
+                            << "\n    threads:        " << threads
+                            << "\n    antithetic:     " << antithetic
+                            << std::setprecision(16)
+                            << "\n    serial NPV:     " << serialNPV
+                            << "\n    parallel NPV:   " << parallelNPV
+                            << "\n    serial error:   " << serialError
+                            << "\n    parallel error: " << parallelError);
+        }
+
+        // a generator without direct skipping, with a fixed number
+        // of samples
+        typedef GenericPseudoRandom<KnuthUniformRng,
+                                    InverseCumulativeNormal> KnuthRandom;
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<KnuthRandom>(process)
+            .withSteps(10)
+            .withSamples(4095)
+            .withSeed(42));
+        const Real serialNPV = option.NPV();
+
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<KnuthRandom>(process)
+            .withSteps(10)
+            .withSamples(4095)
+            .withSeed(42)
+            .withThreads(threads));
+        const Real parallelNPV = option.NPV();
+
+        if (serialNPV != parallelNPV)
+            BOOST_ERROR("failed to reproduce serial Knuth-generator result"
+                        << "\n    threads:      " << threads
+                        << std::setprecision(16)
+                        << "\n    serial NPV:   " << serialNPV
+                        << "\n    parallel NPV: " << parallelNPV);
+    }
+
+    // generators that can't skip samples can still be used serially
+    typedef GenericLowDiscrepancy<HaltonRsg,
+                                  InverseCumulativeNormal> HaltonSequence;
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<HaltonSequence>(process)
+        .withSteps(10)
+        .withSamples(1023));
+    option.NPV();
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1766,6 +1860,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &EuropeanOptionTest::testMcParallelSimulation));
 
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
 
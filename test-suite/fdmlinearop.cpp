@@ -199,6 +199,17 @@ void FdmLinearOpTest::testFdmLinearOpLayout() {
                         BOOST_FAIL("next neighbourhood index is " << nn
                                     << " but should be " << calculatedIndex);
                     }
+
+                    const FdmLinearOpIterator neighbour
+                        = layout.iter_neighbourhood(iter, 1, n);
+                    if (neighbour.index() != calculatedIndex
+                        || layout.index(neighbour.coordinates()) != nn
+                        || neighbour.coordinates()[0] != k
+                        || neighbour.coordinates()[2] != m) {
+                        BOOST_FAIL("neighbourhood iterator index is "
+                                   << neighbour.index()
+                                   << " but should be " << calculatedIndex);
+                    }
                 }
 
                 for (Size n=1; n < 7; ++n) {
@@ -213,6 +224,31 @@ void FdmLinearOpTest::testFdmLinearOpLayout() {
             }
         }
     }
+
+    // layouts with more than three dimensions don't fit
+    // into the inline coordinate storage of the iterator
+    const std::vector<Size> dim4 = {3,4,2,5};
+    FdmLinearOpLayout layout4(dim4);
+    const FdmLinearOpIterator endIter = layout4.end();
+    Size expectedIndex = 0;
+    for (FdmLinearOpIterator iter4 = layout4.begin(); iter4 != endIter;
+         ++iter4, ++expectedIndex) {
+        const FdmLinearOpIterator::coordinates_type& coordinates
+            = iter4.coordinates();
+        const std::vector<Size> tmp = coordinates;
+
+        if (coordinates.size() != dim4.size()
+            || iter4.index() != expectedIndex
+            || layout4.index(coordinates) != expectedIndex
+            || layout4.index(tmp) != expectedIndex) {
+            BOOST_FAIL("iterator index is " << iter4.index()
+                       << " but should be " << expectedIndex);
+        }
+    }
+    if (expectedIndex != layout4.size()) {
+        BOOST_FAIL("iterator visited " << expectedIndex
+                   << " points, but layout size is " << layout4.size());
+    }
 }
 
 void FdmLinearOpTest::testUniformGridMesher() {
@@ -729,6 +765,131 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
                 << "\n calculated    : " << t[i]);
         }
     }
+
+    // apply and solve line by line along each direction of a 3d layout
+    const std::vector<Size> dim3 = {5, 6, 7};
+    ext::shared_ptr<FdmLinearOpLayout> layout3(new FdmLinearOpLayout(dim3));
+    ext::shared_ptr<FdmMesher> mesher3(new UniformGridMesher(
+        layout3, std::vector<std::pair<Real, Real> >(3, {0.0, 1.0})));
+
+    Array v(layout3->size());
+    boost::numeric::ublas::vector<Real> w(layout3->size());
+    for (Size i=0; i < layout3->size(); ++i)
+        w[i] = v[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    for (Size direction=0; direction < dim3.size(); ++direction) {
+        SecondDerivativeOp op(direction, mesher3);
+        op.axpyb(Array(1, 0.5), op, FirstDerivativeOp(direction, mesher3),
+                 Array(1, 1.0));
+
+        const Array applied = op.apply(v);
+        const boost::numeric::ublas::vector<Real> expected
+            = boost::numeric::ublas::prod(op.toMatrix(), w);
+
+        const Array solved = op.solve_splitting(applied, 1.0, 0.0);
+
+        for (Size i=0; i < v.size(); ++i) {
+            if (std::fabs(applied[i] - expected[i]) > 1e-10) {
+                BOOST_FAIL("apply and matrix representation are not "
+                           "consistent in direction " << direction
+                           << "\n expected      : " << expected[i]
+                           << "\n calculated    : " << applied[i]);
+            }
+            if (std::fabs(v[i] - solved[i]) > 1e-6) {
+                BOOST_FAIL("solve and apply are not consistent "
+                           "in direction " << direction
+                           << "\n expected      : " << v[i]
+                           << "\n calculated    : " << solved[i]);
+            }
+        }
+    }
+}
+
+
+void FdmLinearOpTest::testTripleBandFactorizationReuse() {
+
+    BOOST_TEST_MESSAGE("Testing reuse of triple-band map factorization...");
+
+    const std::vector<Size> dim = {50, 40};
+
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    ext::shared_ptr<FdmMesher> mesher(new UniformGridMesher(
+        layout, std::vector<std::pair<Real, Real> >(2, {0.0, 1.0})));
+
+    const FirstDerivativeOp dx(0, mesher);
+    const SecondDerivativeOp dxx(0, mesher);
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    TripleBandLinearOp op(0, mesher);
+    op.axpyb(Array(1, 0.05), dx, dxx, Array(1, -0.03));
+
+    const Real dt = 1e-3;
+    const Array t0 = op.solve_splitting(u, -dt, 1.0);
+
+    // the factorization is reused for the same system...
+    const Array t1 = op.solve_splitting(u, -dt, 1.0);
+
+    // ...and when the same bands are stored again
+    op.axpyb(Array(1, 0.05), dx, dxx, Array(1, -0.03));
+    const Array t2 = op.solve_splitting(u, -dt, 1.0);
+
+    if (op.factorizations() != 1)
+        BOOST_FAIL("factorization not reused"
+                   << "\n factorizations: " << op.factorizations()
+                   << "\n expected      : " << 1);
+
+    // any change of the bands, however small, needs a new one
+    op.axpyb(Array(1, 0.05*(1.0+QL_EPSILON)), dx, dxx, Array(1, -0.03));
+    op.solve_splitting(u, -dt, 1.0);
+
+    if (op.factorizations() != 2)
+        BOOST_FAIL("factorization not updated"
+                   << "\n factorizations: " << op.factorizations()
+                   << "\n expected      : " << 2);
+
+    TripleBandLinearOp ref(0, mesher);
+    ref.axpyb(Array(1, 0.05*(1.0+QL_EPSILON)), dx, dxx, Array(1, -0.03));
+    const Array a0 = op.apply(u);
+    const Array a1 = ref.apply(u);
+
+    for (Size i=0; i < u.size(); ++i) {
+        if (t0[i] != t1[i] || t0[i] != t2[i]) {
+            BOOST_FAIL("reused factorization gives a different solution"
+                       << "\n first solution : " << t0[i]
+                       << "\n second solution: " << t1[i]
+                       << "\n after update   : " << t2[i]);
+        }
+        if (a0[i] != a1[i]) {
+            BOOST_FAIL("updated operator differs from a new one"
+                       << "\n updated operator: " << a0[i]
+                       << "\n new operator    : " << a1[i]);
+        }
+    }
+
+    // new bands or a new time step need a new factorization
+    op.axpyb(Array(1, 0.5), dx, dxx, Array(1, -0.3));
+
+    for (Real a : { -dt, -2.0*dt }) {
+        const Array t = op.solve_splitting(u, a, 1.0);
+        const Array r = a*op.apply(t) + t;
+
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(r[i] - u[i]) > 1e-10) {
+                BOOST_FAIL("solve and apply are not consistent "
+                           "after update of the operator"
+                           << "\n expected      : " << u[i]
+                           << "\n calculated    : " << r[i]);
+            }
+        }
+    }
+
+    if (op.factorizations() != 4)
+        BOOST_FAIL("wrong number of factorizations"
+                   << "\n factorizations: " << op.factorizations()
+                   << "\n expected      : " << 4);
 }
 
 
@@ -1711,6 +1872,7 @@ test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testDerivativeWeightsOnNonUniformGrids));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandFactorizationReuse));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
@@ -37,6 +37,7 @@ public:
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandFactorizationReuse();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
@@ -28,6 +28,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
@@ -36,8 +37,11 @@
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonhullwhiteengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
+#include <ql/pricingengines/vanilla/cossurfaceengine.hpp>
 #include <ql/pricingengines/vanilla/exponentialfittinghestonengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
@@ -55,7 +59,11 @@
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/period.hpp>
 #include <cmath>
+#include <set>
 #include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -136,6 +144,33 @@ namespace {
         
         return marketData;
     }
+
+    // forwards to another helper and records the OpenMP threads it
+    // is evaluated on
+    class ThreadRecordingHelper : public CalibrationHelper {
+      public:
+        explicit ThreadRecordingHelper(ext::shared_ptr<CalibrationHelper> helper)
+        : helper_(std::move(helper)) {}
+        Real calibrationError() override {
+            record();
+            return helper_->calibrationError();
+        }
+        Array calibrationErrorGradient() override {
+            record();
+            return helper_->calibrationErrorGradient();
+        }
+        const std::set<int>& threads() const { return threads_; }
+      private:
+        void record() {
+            #ifdef _OPENMP
+            threads_.insert(omp_get_thread_num());
+            #else
+            threads_.insert(0);
+            #endif
+        }
+        ext::shared_ptr<CalibrationHelper> helper_;
+        std::set<int> threads_;
+    };
         
 }
 
@@ -289,6 +324,125 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+void HestonModelTest::testDAXCalibrationWithAnalyticJacobian() {
+
+    BOOST_TEST_MESSAGE(
+             "Testing Heston model calibration using DAX volatility data "
+             "with analytic Jacobian and several threads...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const Array initialParams = model->params();
+
+    // a single engine, shared by all helpers and used serially
+    const ext::shared_ptr<PricingEngine> sharedEngine =
+        ext::make_shared<AnalyticHestonEngine>(model, 64);
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(sharedEngine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    const EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+
+    model->calibrate(options, om, endCriteria);
+
+    Real sse = 0;
+    for (Size i = 0; i < 13*8; ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error "
+                   "with analytic Jacobian"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+
+    const Array serialParams = model->params();
+    const Integer serialEvaluations = model->functionEvaluation();
+
+    // one engine per helper, so that they can be used concurrently
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(ext::make_shared<AnalyticHestonEngine>(model, 64));
+
+    std::vector<ext::shared_ptr<ThreadRecordingHelper> > recorders;
+    std::vector<ext::shared_ptr<CalibrationHelper> > recordedOptions;
+    for (const auto& option : options) {
+        recorders.push_back(ext::make_shared<ThreadRecordingHelper>(option));
+        recordedOptions.push_back(recorders.back());
+    }
+
+    model->setParams(initialParams);
+    model->setCalibrationThreads(4);
+    model->calibrate(recordedOptions, om, endCriteria);
+
+    const Array parallelParams = model->params();
+    for (Size i=0; i<serialParams.size(); ++i) {
+        if (parallelParams[i] != serialParams[i]) {
+            BOOST_ERROR("Failed to reproduce serial calibration "
+                        "on several threads"
+                        << std::setprecision(16)
+                        << "\n    parameter:  " << i
+                        << "\n    calculated: " << parallelParams[i]
+                        << "\n    expected:   " << serialParams[i]);
+        }
+    }
+    if (model->functionEvaluation() != serialEvaluations) {
+        BOOST_ERROR("Failed to reproduce number of function evaluations "
+                    "on several threads"
+                    << "\n    calculated: " << model->functionEvaluation()
+                    << "\n    expected:   " << serialEvaluations);
+    }
+
+    // a shared engine with several threads: the helpers using it
+    // must be evaluated one after the other
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(sharedEngine);
+
+    model->setParams(initialParams);
+    model->calibrate(options, om, endCriteria);
+
+    const Array sharedEngineParams = model->params();
+    for (Size i=0; i<serialParams.size(); ++i) {
+        if (sharedEngineParams[i] != serialParams[i]) {
+            BOOST_ERROR("Failed to reproduce serial calibration "
+                        "on several threads with a shared engine"
+                        << std::setprecision(16)
+                        << "\n    parameter:  " << i
+                        << "\n    calculated: " << sharedEngineParams[i]
+                        << "\n    expected:   " << serialParams[i]);
+        }
+    }
+
+    std::set<int> threads;
+    for (const auto& recorder : recorders)
+        threads.insert(recorder->threads().begin(), recorder->threads().end());
+    #if defined(_OPENMP) && !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    if (threads.size() < 2)
+        BOOST_ERROR("helpers evaluated on " << threads.size()
+                    << " thread(s) instead of several");
+    #else
+    BOOST_TEST_MESSAGE("    no parallel calibration in this build: "
+                       "helpers evaluated on " << threads.size() << " thread");
+    #endif
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -3310,12 +3464,415 @@ void HestonModelTest::testLocalVolFromHestonModel() {
     }
 }
 
+void HestonModelTest::testAnalyticPriceGradient() {
+    BOOST_TEST_MESSAGE("Testing analytic Heston and Bates price gradients "
+                       "against finite differences...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> model =
+        ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.4, -0.6));
+
+    const ext::shared_ptr<BatesProcess> batesProcess =
+        ext::make_shared<BatesProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.4, -0.6,
+            0.2, -0.1, 0.15);
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(batesProcess);
+    const ext::shared_ptr<BatesDetJumpModel> batesDetJumpModel =
+        ext::make_shared<BatesDetJumpModel>(batesProcess, 0.8, 0.3);
+    const ext::shared_ptr<BatesDoubleExpModel> batesDoubleExpModel =
+        ext::make_shared<BatesDoubleExpModel>(
+            model->process(), 0.2, 0.08, 0.12, 0.4);
+    const ext::shared_ptr<BatesDoubleExpDetJumpModel>
+        batesDoubleExpDetJumpModel =
+            ext::make_shared<BatesDoubleExpDetJumpModel>(
+                model->process(), 0.2, 0.08, 0.12, 0.4, 0.8, 0.3);
+
+    typedef AnalyticHestonEngine::Integration Integration;
+    const std::vector<std::pair<ext::shared_ptr<CalibratedModel>,
+                                ext::shared_ptr<AnalyticHestonEngine> > >
+        engines = {
+            { model, ext::make_shared<AnalyticHestonEngine>(model) },
+            { model, ext::make_shared<AnalyticHestonEngine>(
+                  model, AnalyticHestonEngine::Gatheral,
+                  Integration::gaussLobatto(1e-10, Null<Real>(), 10000)) },
+            // the jump parameters follow the Heston ones
+            { batesModel, ext::make_shared<BatesEngine>(batesModel) },
+            { batesDetJumpModel,
+              ext::make_shared<BatesDetJumpEngine>(batesDetJumpModel) },
+            { batesDoubleExpModel,
+              ext::make_shared<BatesDoubleExpEngine>(batesDoubleExpModel) },
+            { batesDoubleExpDetJumpModel,
+              ext::make_shared<BatesDoubleExpDetJumpEngine>(
+                  batesDoubleExpDetJumpModel) }
+    };
+
+    const Date maturities[] = { today + Period(3, Months),
+                                today + Period(2, Years) };
+    const Real strikes[] = { 70.0, 100.0, 130.0 };
+
+    const Real h = 1e-5;
+    const Real tol = 1e-5;
+
+    for (const auto& e : engines) {
+        const ext::shared_ptr<CalibratedModel>& m = e.first;
+        const ext::shared_ptr<AnalyticHestonEngine>& engine = e.second;
+        const Array params = m->params();
+        for (const auto& maturity : maturities) {
+            for (Real strike : strikes) {
+                m->setParams(params);
+                const Array calculated =
+                    engine->priceGradient(strike, maturity);
+
+                if (calculated.size() != params.size())
+                    BOOST_FAIL("wrong gradient size: " << calculated.size());
+
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(Option::Call, strike),
+                    ext::make_shared<EuropeanExercise>(maturity));
+                option.setPricingEngine(engine);
+
+                for (Size i=0; i<params.size(); ++i) {
+                    Array bumped = params;
+                    bumped[i] = params[i] + h;
+                    m->setParams(bumped);
+                    const Real up = option.NPV();
+                    bumped[i] = params[i] - h;
+                    m->setParams(bumped);
+                    const Real down = option.NPV();
+                    const Real expected = (up - down)/(2*h);
+
+                    if (std::fabs(calculated[i] - expected) > tol) {
+                        BOOST_ERROR("failed to reproduce price derivative"
+                                    << "\n    parameters: " << params
+                                    << "\n    maturity:   " << maturity
+                                    << "\n    strike:     " << strike
+                                    << "\n    parameter:  " << i
+                                    << "\n    calculated: " << calculated[i]
+                                    << "\n    expected:   " << expected
+                                    << "\n    tolerance:  " << tol);
+                    }
+                }
+            }
+        }
+        m->setParams(params);
+    }
+
+    // no gradient is available if the engine adds terms to chF
+    // that it can't differentiate
+    const ext::shared_ptr<HullWhite> hullWhiteModel =
+        ext::make_shared<HullWhite>(riskFreeTS, 0.05, 0.01);
+    if (!AnalyticHestonHullWhiteEngine(model, hullWhiteModel)
+             .priceGradient(100.0, maturities[0]).empty())
+        BOOST_ERROR("gradient returned by Heston-Hull-White engine");
+}
+
+void HestonModelTest::testAnalyticEngineSharedNodeValues() {
+    BOOST_TEST_MESSAGE("Testing analytic Heston engine sharing "
+                       "characteristic-function values among strikes...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> hestonModel =
+        ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.4, -0.6));
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(ext::make_shared<BatesProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.4, -0.6,
+            0.2, -0.1, 0.15));
+    const ext::shared_ptr<HullWhite> hullWhiteModel =
+        ext::make_shared<HullWhite>(riskFreeTS, 0.05, 0.01);
+
+    typedef AnalyticHestonEngine::Integration Integration;
+
+    struct EngineCase {
+        std::string description;
+        ext::shared_ptr<HestonModel> model;
+        ext::shared_ptr<AnalyticHestonEngine> engine;
+        AnalyticHestonEngine::ComplexLogFormula cpxLog;
+        Integration integration;
+    };
+
+    const std::vector<EngineCase> engineCases = {
+        { "Gatheral, Gauss-Laguerre", hestonModel,
+          ext::make_shared<AnalyticHestonEngine>(hestonModel),
+          AnalyticHestonEngine::Gatheral, Integration::gaussLaguerre(144) },
+        { "branch correction, Gauss-Laguerre", hestonModel,
+          ext::make_shared<AnalyticHestonEngine>(
+              hestonModel, AnalyticHestonEngine::BranchCorrection,
+              Integration::gaussLaguerre(128)),
+          AnalyticHestonEngine::BranchCorrection,
+          Integration::gaussLaguerre(128) },
+        { "Gatheral, Gauss-Legendre", hestonModel,
+          ext::make_shared<AnalyticHestonEngine>(
+              hestonModel, AnalyticHestonEngine::Gatheral,
+              Integration::gaussLegendre(128)),
+          AnalyticHestonEngine::Gatheral, Integration::gaussLegendre(128) },
+        { "Andersen-Piterbarg, Gauss-Laguerre", hestonModel,
+          ext::make_shared<AnalyticHestonEngine>(
+              hestonModel, AnalyticHestonEngine::AndersenPiterbarg,
+              Integration::gaussLaguerre(96)),
+          AnalyticHestonEngine::AndersenPiterbarg,
+          Integration::gaussLaguerre(96) },
+        { "optimal control variate, Gauss-Legendre", hestonModel,
+          ext::make_shared<AnalyticHestonEngine>(
+              hestonModel, AnalyticHestonEngine::OptimalCV,
+              Integration::gaussLegendre(64)),
+          AnalyticHestonEngine::OptimalCV, Integration::gaussLegendre(64) },
+        { "Gatheral, Gauss-Lobatto", hestonModel,
+          ext::make_shared<AnalyticHestonEngine>(
+              hestonModel, AnalyticHestonEngine::Gatheral,
+              Integration::gaussLobatto(1e-8, Null<Real>(), 10000)),
+          AnalyticHestonEngine::Gatheral,
+          Integration::gaussLobatto(1e-8, Null<Real>(), 10000) },
+        { "Bates", batesModel,
+          ext::make_shared<BatesEngine>(batesModel),
+          AnalyticHestonEngine::Gatheral, Integration::gaussLaguerre(144) },
+        { "Heston-Hull-White", hestonModel,
+          ext::make_shared<AnalyticHestonHullWhiteEngine>(
+              hestonModel, hullWhiteModel),
+          AnalyticHestonEngine::Gatheral, Integration::gaussLaguerre(144) }
+    };
+
+    const std::vector<Date> maturities = {
+        today + Period(3, Months), today + Period(1, Years),
+        today + Period(3, Years)
+    };
+    const Array strikes = { 60.0, 80.0, 95.0, 100.0, 105.0, 120.0, 150.0 };
+    std::vector<Option::Type> types(strikes.size());
+    for (Size i=0; i<strikes.size(); ++i)
+        types[i] = strikes[i] < 100.0 ? Option::Put : Option::Call;
+
+    for (const auto& engineCase : engineCases) {
+        const ext::shared_ptr<HestonModel>& model = engineCase.model;
+        const ext::shared_ptr<AnalyticHestonEngine>& engine =
+            engineCase.engine;
+
+        // expected values from the single-strike calculation, which
+        // doesn't use the values stored in the engine
+        const auto expectedValue = [&](Size i, const Date& maturity) {
+            Real value;
+            Size evaluations;
+            AnalyticHestonEngine::doCalculation(
+                riskFreeTS->discount(maturity),
+                dividendTS->discount(maturity),
+                s0->value(), strikes[i],
+                model->process()->time(maturity),
+                model->kappa(), model->theta(), model->sigma(),
+                model->v0(), model->rho(),
+                PlainVanillaPayoff(types[i], strikes[i]),
+                engineCase.integration, engineCase.cpxLog,
+                engine.get(), value, evaluations);
+            return value;
+        };
+
+        for (Size pass=0; pass<2; ++pass) {
+            if (pass == 1) {
+                // the stored values must be discarded
+                Array params = model->params();
+                params[0] = 0.07;
+                params[3] = -0.3;
+                model->setParams(params);
+            }
+
+            for (const auto& maturity : maturities) {
+                const Array calculated =
+                    engine->priceVanillaPayoffs(types, strikes, maturity);
+
+                for (Size i=0; i<strikes.size(); ++i) {
+                    const Real expected = expectedValue(i, maturity);
+                    if (calculated[i] != expected) {
+                        BOOST_ERROR("failed to reproduce single-strike "
+                                    "price with batch calculation"
+                                    << "\n    engine:     "
+                                    << engineCase.description
+                                    << "\n    maturity:   " << maturity
+                                    << "\n    strike:     " << strikes[i]
+                                    << std::setprecision(16)
+                                    << "\n    calculated: " << calculated[i]
+                                    << "\n    expected:   " << expected);
+                    }
+                }
+            }
+
+            // options priced one by one and grouped by maturity, as
+            // in a calibration, reuse the values stored by the first
+            // one of each group
+            for (const auto& maturity : maturities) {
+                for (Size i=0; i<strikes.size(); ++i) {
+                    VanillaOption option(
+                        ext::make_shared<PlainVanillaPayoff>(types[i],
+                                                             strikes[i]),
+                        ext::make_shared<EuropeanExercise>(maturity));
+                    option.setPricingEngine(engine);
+
+                    const Real calculated = option.NPV();
+                    const Real expected = expectedValue(i, maturity);
+                    if (calculated != expected) {
+                        BOOST_ERROR("failed to reproduce single-strike "
+                                    "price with stored node values"
+                                    << "\n    engine:     "
+                                    << engineCase.description
+                                    << "\n    maturity:   " << maturity
+                                    << "\n    strike:     " << strikes[i]
+                                    << std::setprecision(16)
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void HestonModelTest::testCOSSurfaceEngines() {
+    BOOST_TEST_MESSAGE("Testing Fourier-cosine surface engines "
+                       "against analytic engines...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dc));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> hestonModel =
+        ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.4, -0.6));
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(ext::make_shared<BatesProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.4, -0.6,
+            0.2, -0.1, 0.15));
+
+    std::vector<Time> modelTimes = {0.5, 2.0, 10.0};
+    const TimeGrid modelGrid(modelTimes.begin(), modelTimes.end());
+    std::vector<Time> pTimes = {0.5, 2.0};
+    PiecewiseConstantParameter sigma(pTimes, PositiveConstraint());
+    sigma.setParam(0, 0.3);
+    sigma.setParam(1, 0.5);
+    sigma.setParam(2, 0.4);
+    const ext::shared_ptr<PiecewiseTimeDependentHestonModel> ptdModel =
+        ext::make_shared<PiecewiseTimeDependentHestonModel>(
+            riskFreeTS, dividendTS, s0, 0.04,
+            ConstantParameter(0.05, PositiveConstraint()),
+            ConstantParameter(1.5, PositiveConstraint()),
+            sigma,
+            ConstantParameter(-0.6, BoundaryConstraint(-1.0, 1.0)),
+            modelGrid);
+
+    struct EngineCase {
+        std::string description;
+        ext::shared_ptr<CalibratedModel> model;
+        ext::shared_ptr<COSSurfaceEngine> cosEngine;
+        ext::shared_ptr<PricingEngine> analyticEngine;
+    };
+
+    const std::vector<EngineCase> engineCases = {
+        { "Heston", hestonModel,
+          ext::make_shared<COSHestonSurfaceEngine>(hestonModel),
+          ext::make_shared<AnalyticHestonEngine>(
+              hestonModel, 1e-12, 100000) },
+        { "Bates", batesModel,
+          ext::make_shared<COSBatesSurfaceEngine>(batesModel),
+          ext::make_shared<BatesEngine>(batesModel, 1e-12, 100000) },
+        { "time-dependent Heston", ptdModel,
+          ext::make_shared<COSPTDHestonSurfaceEngine>(ptdModel),
+          ext::make_shared<AnalyticPTDHestonEngine>(
+              ptdModel, 1e-12, 100000) }
+    };
+
+    const std::vector<Date> maturities = {
+        today + Period(1, Months), today + Period(1, Years),
+        today + Period(5, Years)
+    };
+    const Array strikes = { 50.0, 80.0, 95.0, 100.0, 105.0, 120.0, 200.0 };
+    std::vector<Option::Type> types(strikes.size());
+    for (Size i=0; i<strikes.size(); ++i)
+        types[i] = strikes[i] < 100.0 ? Option::Put : Option::Call;
+
+    const Real tol = 1e-6;
+
+    for (const auto& engineCase : engineCases) {
+        for (Size pass=0; pass<2; ++pass) {
+            if (pass == 1) {
+                // the cached coefficients must be discarded
+                Array params = engineCase.model->params();
+                params[0] = 0.07;
+                engineCase.model->setParams(params);
+            }
+
+            for (const auto& maturity : maturities) {
+                const Array batch = engineCase.cosEngine->priceVanillaPayoffs(
+                    types, strikes, maturity);
+
+                for (Size i=0; i<strikes.size(); ++i) {
+                    VanillaOption option(
+                        ext::make_shared<PlainVanillaPayoff>(types[i],
+                                                             strikes[i]),
+                        ext::make_shared<EuropeanExercise>(maturity));
+
+                    option.setPricingEngine(engineCase.analyticEngine);
+                    const Real expected = option.NPV();
+
+                    option.setPricingEngine(engineCase.cosEngine);
+                    const Real calculated = option.NPV();
+
+                    if (std::fabs(calculated - expected) > tol) {
+                        BOOST_ERROR("failed to reproduce analytic price"
+                                    << "\n    model:      "
+                                    << engineCase.description
+                                    << "\n    maturity:   " << maturity
+                                    << "\n    strike:     " << strikes[i]
+                                    << std::setprecision(12)
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected
+                                    << "\n    tolerance:  " << tol);
+                    }
+                    if (batch[i] != calculated) {
+                        BOOST_ERROR("failed to reproduce single-option "
+                                    "price with batch calculation"
+                                    << "\n    model:      "
+                                    << engineCase.description
+                                    << "\n    maturity:   " << maturity
+                                    << "\n    strike:     " << strikes[i]
+                                    << std::setprecision(16)
+                                    << "\n    calculated: " << batch[i]
+                                    << "\n    expected:   " << calculated);
+                    }
+                }
+            }
+        }
+    }
+}
 
 test_suite* HestonModelTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Heston model tests");
 
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibrationWithAnalyticJacobian));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
@@ -3342,6 +3899,9 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testOptimalControlVariateChoice));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAsymptoticControlVariate));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testLocalVolFromHestonModel));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticPriceGradient));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticEngineSharedNodeValues));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testCOSSurfaceEngines));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDifferentIntegrals));
@@ -30,6 +30,7 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testDAXCalibrationWithAnalyticJacobian();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -61,6 +62,9 @@ class HestonModelTest {
     static void testOptimalControlVariateChoice();
     static void testAsymptoticControlVariate();
     static void testLocalVolFromHestonModel();
+    static void testAnalyticPriceGradient();
+    static void testAnalyticEngineSharedNodeValues();
+    static void testCOSSurfaceEngines();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
     static boost::unit_test_framework::test_suite* experimental();
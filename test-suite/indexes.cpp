@@ -22,6 +22,7 @@
 #include <ql/indexes/bmaindex.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -110,10 +111,95 @@ void IndexTest::testFixingHasHistoricalFixing() {
     testCase(name, fixingNotFound, IndexManager::instance().hasHistoricalFixing(name, today));
 }
 
+void IndexTest::testSavingAndLoadingFixings() {
+    BOOST_TEST_MESSAGE("Testing saving and loading of index fixings...");
+
+    IndexHistoryCleaner cleaner;
+
+    auto euribor = ext::make_shared<Euribor6M>();
+    auto bma = ext::make_shared<BMAIndex>();
+
+    Flag flag;
+    flag.registerWith(euribor);
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    Date d = euribor->fixingCalendar().adjust(Date(3, January, 2000));
+    for (Size i = 0; i < 5000; ++i) {
+        dates.push_back(d);
+        values.push_back(0.01 + 0.0001 * (i % 97));
+        d = euribor->fixingCalendar().advance(d, 1, Days);
+    }
+    euribor->addFixings(dates.begin(), dates.end(), values.begin());
+    Date bmaDate(5, May, 2010);
+    bma->addFixing(bmaDate, 0.02);
+
+    std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+    IndexManager::instance().saveHistories(stream);
+
+    flag.lower();
+    IndexManager::instance().clearHistory(euribor->name());
+    if (!flag.isUp())
+        BOOST_FAIL("Observer was not notified of cleared fixings");
+    if (IndexManager::instance().hasHistory(euribor->name()) ||
+        !IndexManager::instance().hasHistory(bma->name()))
+        BOOST_FAIL("wrong histories reported after clearing "
+                   << euribor->name());
+
+    IndexManager::instance().clearHistories();
+    if (!IndexManager::instance().histories().empty())
+        BOOST_FAIL("histories reported after clearing all of them");
+    flag.lower();
+
+    IndexManager::instance().loadHistories(stream);
+
+    if (!flag.isUp())
+        BOOST_FAIL("Observer was not notified of loaded fixings");
+
+    const TimeSeries<Real>& history = euribor->timeSeries();
+    if (history.size() != dates.size())
+        BOOST_FAIL("wrong number of loaded fixings"
+                   << "\n    loaded:   " << history.size()
+                   << "\n    expected: " << dates.size());
+    for (Size i = 0; i < dates.size(); ++i) {
+        if (history[dates[i]] != values[i])
+            BOOST_FAIL("wrong fixing loaded for " << dates[i]
+                       << "\n    loaded:   " << history[dates[i]]
+                       << "\n    expected: " << values[i]);
+    }
+    if (bma->timeSeries().size() != 1 ||
+        bma->timeSeries()[bmaDate] != 0.02)
+        BOOST_FAIL("wrong BMA fixings loaded");
+
+    std::stringstream garbage("not a fixing file");
+    BOOST_CHECK_THROW(IndexManager::instance().loadHistories(garbage), Error);
+    if (euribor->timeSeries().size() != dates.size())
+        BOOST_FAIL("fixings modified by failed load");
+
+    // corrupted counts or truncated data must give an error as well,
+    // not an allocation failure; the number of histories follows the
+    // 16-byte header and is followed by the size of the first name
+    const std::string saved = stream.str();
+    for (std::size_t offset : {16, 24}) {
+        std::string corrupted = saved;
+        std::fill(corrupted.begin() + offset, corrupted.begin() + offset + 8,
+                  char(0x7f));
+        std::stringstream in(corrupted,
+                             std::ios::in | std::ios::out | std::ios::binary);
+        BOOST_CHECK_THROW(IndexManager::instance().loadHistories(in), Error);
+    }
+    std::stringstream truncated(saved.substr(0, saved.size() / 2),
+                                std::ios::in | std::ios::out | std::ios::binary);
+    BOOST_CHECK_THROW(IndexManager::instance().loadHistories(truncated), Error);
+    if (euribor->timeSeries().size() != dates.size())
+        BOOST_FAIL("fixings modified by failed load");
+}
+
 
 test_suite* IndexTest::suite() {
     auto* suite = BOOST_TEST_SUITE("index tests");
     suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingObservability));
     suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingHasHistoricalFixing));
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testSavingAndLoadingFixings));
     return suite;
 }
@@ -19,6 +19,12 @@
 
 #include "instruments.hpp"
 #include "utilities.hpp"
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/experimental/risk/portfoliovaluation.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
 #include <ql/instruments/stock.hpp>
 #include <ql/instruments/compositeinstrument.hpp>
 #include <ql/instruments/europeanoption.hpp>
@@ -113,11 +119,214 @@ void InstrumentTest::testCompositeWhenShiftingDates() {
         BOOST_FAIL("Composite didn't recalculate");
 }
 
+namespace {
+
+    struct Portfolio {
+        ext::shared_ptr<SimpleQuote> spot;
+        ext::shared_ptr<BlackScholesMertonProcess> process;
+        std::vector<ext::shared_ptr<Instrument> > instruments;
+    };
+
+    // options sharing engines, options with their own engine,
+    // and instruments without an engine
+    Portfolio makePortfolio(const Date& today) {
+        Portfolio p;
+        DayCounter dc = Actual360();
+        p.spot = ext::make_shared<SimpleQuote>(100.0);
+        ext::shared_ptr<BlackScholesMertonProcess> process = p.process =
+            ext::make_shared<BlackScholesMertonProcess>(
+                Handle<Quote>(p.spot),
+                Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+                Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+                Handle<BlackVolTermStructure>(flatVol(today, 0.2, dc)));
+
+        std::vector<ext::shared_ptr<PricingEngine> > engines = {
+            ext::make_shared<AnalyticEuropeanEngine>(process),
+            ext::make_shared<AnalyticEuropeanEngine>(process)
+        };
+        for (Size i=0; i<20; ++i) {
+            ext::shared_ptr<Instrument> option =
+                ext::make_shared<EuropeanOption>(
+                    ext::make_shared<PlainVanillaPayoff>(
+                        i%2 == 0 ? Option::Call : Option::Put,
+                        80.0 + 2.0*i),
+                    ext::make_shared<EuropeanExercise>(
+                        today + Integer(30*(i+1))));
+            if (i < 14)
+                option->setPricingEngine(engines[i%2]);
+            else
+                option->setPricingEngine(
+                    ext::make_shared<AnalyticEuropeanEngine>(process));
+            p.instruments.push_back(option);
+        }
+        auto composite = ext::make_shared<CompositeInstrument>();
+        composite->add(p.instruments[0], 2.0);
+        composite->subtract(p.instruments[15]);
+        p.instruments.push_back(composite);
+        p.instruments.push_back(
+            ext::make_shared<Stock>(Handle<Quote>(p.spot)));
+        return p;
+    }
+
+}
+
+void InstrumentTest::testPortfolioValuation() {
+
+    BOOST_TEST_MESSAGE("Testing batch valuation of a portfolio...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Portfolio portfolio = makePortfolio(today);
+    Portfolio reference = makePortfolio(today);
+    Size n = portfolio.instruments.size();
+
+    auto valuation =
+        ext::make_shared<PortfolioValuation>(portfolio.instruments);
+    Flag flag;
+    flag.registerWith(valuation);
+
+    // two shared engines plus six single ones
+    if (valuation->groups() != 8)
+        BOOST_ERROR("unexpected number of groups:"
+                    << "\n    calculated: " << valuation->groups()
+                    << "\n    expected:   " << 8);
+
+    std::vector<Real> quantities(n);
+    for (Size i=0; i<n; ++i)
+        quantities[i] = 1.0 + 0.5*i;
+
+    for (Real spot : {100.0, 105.0}) {
+        portfolio.spot->setValue(spot);
+        reference.spot->setValue(spot);
+        if (spot != 100.0 && !flag.isUp())
+            BOOST_ERROR("portfolio valuation not notified of market change");
+        flag.lower();
+
+        const std::vector<Real>& npvs = valuation->NPVs();
+        for (Size i=0; i<n; ++i) {
+            Real expected = reference.instruments[i]->NPV();
+            if (std::fabs(npvs[i] - expected) > 1.0e-10)
+                BOOST_ERROR("wrong NPV for instrument #" << i
+                            << " at spot " << spot << ":"
+                            << "\n    calculated: " << npvs[i]
+                            << "\n    expected:   " << expected);
+            if (valuation->additionalResults()[i].size() !=
+                reference.instruments[i]->additionalResults().size())
+                BOOST_ERROR("wrong additional results for instrument #"
+                            << i);
+        }
+
+        Real expected = aggregateNPV(reference.instruments, quantities);
+        Real calculated = valuation->aggregateNPV(quantities);
+        Real batched = aggregateNPV(portfolio.instruments, quantities, true);
+        if (std::fabs(calculated - expected) > 1.0e-8 ||
+            std::fabs(batched - expected) > 1.0e-8)
+            BOOST_ERROR("wrong aggregated NPV at spot " << spot << ":"
+                        << "\n    calculated: " << calculated
+                        << "\n    batched:    " << batched
+                        << "\n    expected:   " << expected);
+    }
+
+    // failures are reported with the failing instrument
+    portfolio.instruments.push_back(ext::make_shared<EuropeanOption>(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        ext::make_shared<EuropeanExercise>(today + 90)));
+    bool failed = false;
+    try {
+        aggregateNPV(portfolio.instruments, std::vector<Real>(), true);
+    } catch (Error& e) {
+        failed = std::string(e.what()).find("instrument #" +
+                                            std::to_string(n))
+                 != std::string::npos;
+    }
+    if (!failed)
+        BOOST_ERROR("failure to price an instrument not reported");
+}
+
+void InstrumentTest::testPortfolioValuationGroups() {
+
+    BOOST_TEST_MESSAGE("Testing grouping of instruments "
+                       "in batch valuation...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+    Portfolio portfolio = makePortfolio(today);
+    Portfolio reference = makePortfolio(today);
+    Size n = portfolio.instruments.size();
+
+    // engines pricing more than three options are split
+    ext::shared_ptr<BlackScholesMertonProcess> process = portfolio.process;
+    PortfolioValuation valuation(
+        portfolio.instruments, 3,
+        [&process](const ext::shared_ptr<PricingEngine>&) {
+            return ext::make_shared<AnalyticEuropeanEngine>(process);
+        });
+
+    // each shared engine prices seven options
+    if (valuation.groups() != 12)
+        BOOST_ERROR("unexpected number of groups:"
+                    << "\n    calculated: " << valuation.groups()
+                    << "\n    expected:   " << 12);
+
+    for (Size i=0; i<n; ++i) {
+        Real expected = reference.instruments[i]->NPV();
+        if (std::fabs(valuation.NPVs()[i] - expected) > 1.0e-10)
+            BOOST_ERROR("wrong NPV for instrument #" << i << ":"
+                        << "\n    calculated: " << valuation.NPVs()[i]
+                        << "\n    expected:   " << expected);
+    }
+
+    // swaps with their own engine, but sharing coupon pricers
+    Handle<YieldTermStructure> curve(flatRate(today, 0.02, Actual360()));
+    ext::shared_ptr<IborIndex> index = ext::make_shared<Euribor6M>(curve);
+    std::vector<ext::shared_ptr<Instrument> > swaps;
+    std::vector<Real> expected;
+    for (Size i=0; i<4; ++i) {
+        ext::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(Period(2+i, Years), index, 0.01*i)
+            .withDiscountingTermStructure(curve);
+        expected.push_back(swap->NPV());
+        swaps.push_back(swap);
+    }
+
+    PortfolioValuation separate(swaps);
+    if (separate.groups() != 4)
+        BOOST_ERROR("unexpected number of groups:"
+                    << "\n    calculated: " << separate.groups()
+                    << "\n    expected:   " << 4);
+
+    ext::shared_ptr<FloatingRateCouponPricer> pricer =
+        ext::make_shared<BlackIborCouponPricer>();
+    for (Size i : {1, 3})
+        setCouponPricer(
+            ext::dynamic_pointer_cast<VanillaSwap>(swaps[i])->floatingLeg(),
+            pricer);
+
+    PortfolioValuation shared(swaps);
+    if (shared.groups() != 3)
+        BOOST_ERROR("groups sharing coupon pricers not merged:"
+                    << "\n    calculated: " << shared.groups()
+                    << "\n    expected:   " << 3);
+
+    for (Size i=0; i<swaps.size(); ++i) {
+        if (std::fabs(shared.NPVs()[i] - expected[i]) > 1.0e-10)
+            BOOST_ERROR("wrong NPV for swap #" << i << ":"
+                        << "\n    calculated: " << shared.NPVs()[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+}
+
 test_suite* InstrumentTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
     suite->add(QUANTLIB_TEST_CASE(
                             &InstrumentTest::testCompositeWhenShiftingDates));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioValuation));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &InstrumentTest::testPortfolioValuationGroups));
     return suite;
 }
 
@@ -21,8 +21,10 @@
 
 #include "mclongstaffschwartzengine.hpp"
 #include "utilities.hpp"
+#include <ql/instruments/basketoption.hpp>
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/pricingengines/basket/mcamericanbasketengine.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
@@ -313,10 +315,209 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testCompactCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz calibration "
+                       "with compact state storage...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+    const Date maturity(17, May, 1999);
+
+    Handle<Quote> underlying(ext::make_shared<SimpleQuote>(36.0));
+    Handle<YieldTermStructure> riskFreeTS(
+        ext::make_shared<FlatForward>(today, 0.06, dayCounter));
+    Handle<YieldTermStructure> dividendTS(
+        ext::make_shared<FlatForward>(today, 0.02, dayCounter));
+    Handle<BlackVolTermStructure> volTS(
+        ext::make_shared<BlackConstantVol>(today, NullCalendar(),
+                                           0.25, dayCounter));
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            underlying, dividendTS, riskFreeTS, volTS);
+
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<AmericanExercise>(today, maturity);
+    ext::shared_ptr<PlainVanillaPayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0);
+
+    const Real tolerance = 1.0e-8;
+
+    VanillaOption option(payoff, exercise);
+
+    LsmBasisSystem::PolynomType polynomTypes[]
+        = { LsmBasisSystem::Monomial, LsmBasisSystem::Laguerre,
+            LsmBasisSystem::Chebyshev2nd };
+
+    for (auto& polynomType : polynomTypes) {
+        Real npv[2];
+        for (Size k=0; k<2; ++k) {
+            option.setPricingEngine(
+                MakeMCAmericanEngine<PseudoRandom>(process)
+                .withSteps(50)
+                .withAntitheticVariate()
+                .withSamples(4096)
+                .withCalibrationSamples(4096)
+                .withSeed(42)
+                .withPolynomOrder(3)
+                .withBasisSystem(polynomType)
+                .withCompactCalibration(k == 1));
+            npv[k] = option.NPV();
+        }
+
+        if (std::fabs(npv[0] - npv[1]) > tolerance) {
+            BOOST_ERROR("failed to reproduce american option price "
+                        "with compact calibration"
+                        << "\n    polynomial type: " << polynomType
+                        << "\n    standard:        " << npv[0]
+                        << "\n    compact:         " << npv[1]);
+        }
+    }
+
+    std::vector<ext::shared_ptr<StochasticProcess1D> > processes(2, process);
+    Matrix correlation(2, 2, 0.3);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    ext::shared_ptr<StochasticProcessArray> processArray =
+        ext::make_shared<StochasticProcessArray>(processes, correlation);
+
+    BasketOption basketOption(
+        ext::make_shared<MinBasketPayoff>(payoff), exercise);
+
+    Real npv[2];
+    for (Size k=0; k<2; ++k) {
+        basketOption.setPricingEngine(
+            MakeMCAmericanBasketEngine<PseudoRandom>(processArray)
+            .withSteps(25)
+            .withSamples(2048)
+            .withCalibrationSamples(2048)
+            .withSeed(42)
+            .withCompactCalibration(k == 1));
+        npv[k] = basketOption.NPV();
+    }
+
+    if (std::fabs(npv[0] - npv[1]) > tolerance) {
+        BOOST_ERROR("failed to reproduce american basket option price "
+                    "with compact calibration"
+                    << "\n    standard: " << npv[0]
+                    << "\n    compact:  " << npv[1]);
+    }
+}
+
+void MCLongstaffSchwartzEngineTest::testParallelPricing() {
+
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz engines on several "
+                       "threads...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    Handle<Quote> underlying(ext::make_shared<SimpleQuote>(36.0));
+    Handle<YieldTermStructure> riskFreeTS(
+        ext::make_shared<FlatForward>(today, 0.06, dayCounter));
+    Handle<YieldTermStructure> dividendTS(
+        ext::make_shared<FlatForward>(today, 0.02, dayCounter));
+    Handle<BlackVolTermStructure> volTS(
+        ext::make_shared<BlackConstantVol>(today, NullCalendar(),
+                                           0.25, dayCounter));
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            underlying, dividendTS, riskFreeTS, volTS);
+
+    std::vector<Date> exerciseDates;
+    for (Integer i=1; i<=12; ++i)
+        exerciseDates.push_back(today + i*Months);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<BermudanExercise>(exerciseDates);
+    ext::shared_ptr<PlainVanillaPayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0);
+
+    // the results must not depend on the number of threads
+    const Real tolerance = 1.0e-12;
+
+    VanillaOption option(payoff, exercise);
+
+    for (Size compact=0; compact<2; ++compact) {
+        Real npv[2], exerciseProbability[2];
+        const Size threads[] = { 1, 4 };
+        for (Size k=0; k<2; ++k) {
+            option.setPricingEngine(
+                MakeMCAmericanEngine<PseudoRandom>(process)
+                .withSteps(48)
+                .withAntitheticVariate()
+                .withSamples(4095)
+                .withCalibrationSamples(2047)
+                .withSeed(42)
+                .withCompactCalibration(compact == 1)
+                .withThreads(threads[k]));
+            npv[k] = option.NPV();
+            exerciseProbability[k] =
+                option.result<Real>("exerciseProbability");
+        }
+
+        if (std::fabs(npv[0] - npv[1]) > tolerance
+            || std::fabs(exerciseProbability[0] - exerciseProbability[1])
+                   > tolerance) {
+            BOOST_ERROR("failed to reproduce bermudan option results "
+                        "on several threads"
+                        << "\n    compact calibration:  " << compact
+                        << std::setprecision(12)
+                        << "\n    price:                " << npv[0]
+                        << "\n    price (4 threads):    " << npv[1]
+                        << "\n    exercise probability: "
+                        << exerciseProbability[0]
+                        << "\n    (4 threads):          "
+                        << exerciseProbability[1]);
+        }
+    }
+
+    std::vector<ext::shared_ptr<StochasticProcess1D> > processes(3, process);
+    Matrix correlation(3, 3, 0.3);
+    for (Size i=0; i<3; ++i)
+        correlation[i][i] = 1.0;
+    ext::shared_ptr<StochasticProcessArray> processArray =
+        ext::make_shared<StochasticProcessArray>(processes, correlation);
+
+    BasketOption basketOption(
+        ext::make_shared<MinBasketPayoff>(payoff),
+        ext::make_shared<AmericanExercise>(today, today + 1*Years));
+
+    Real npv[2];
+    const Size threads[] = { 1, 3 };
+    for (Size k=0; k<2; ++k) {
+        basketOption.setPricingEngine(
+            MakeMCAmericanBasketEngine<PseudoRandom>(processArray)
+            .withSteps(25)
+            .withAntitheticVariate()
+            .withSamples(2048)
+            .withCalibrationSamples(1024)
+            .withSeed(42)
+            .withThreads(threads[k]));
+        npv[k] = basketOption.NPV();
+    }
+
+    if (std::fabs(npv[0] - npv[1]) > tolerance) {
+        BOOST_ERROR("failed to reproduce american basket option price "
+                    "on several threads"
+                    << std::setprecision(12)
+                    << "\n    price:             " << npv[0]
+                    << "\n    price (3 threads): " << npv[1]);
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
 
     suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testCompactCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testParallelPricing));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanOption));
@@ -30,6 +30,8 @@ class MCLongstaffSchwartzEngineTest {
   public:
     static void testAmericanOption();
     static void testAmericanMaxOption();
+    static void testCompactCalibration();
+    static void testParallelPricing();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
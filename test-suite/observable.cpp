@@ -262,6 +262,71 @@ void ObservableTest::testMultiThreadingGlobalSettings() {
         }
     }
 }
+
+
+namespace {
+
+    class Notifier : public Observable {
+      public:
+        void notify() { notifyObservers(); }
+    };
+
+    void registerAndNotify(
+            const std::vector<ext::shared_ptr<Notifier> >& notifiers,
+            Size iterations, boost::atomic<Size>* missed) {
+        for (Size i=0; i<iterations; ++i) {
+            const ext::shared_ptr<MTUpdateCounter> observer(
+                                                    new MTUpdateCounter);
+            for (const auto& notifier : notifiers)
+                observer->registerWith(notifier);
+            notifiers[i % notifiers.size()]->notify();
+            // at least our own notification must have been received
+            if (observer->counter() == 0)
+                ++(*missed);
+        }
+    }
+
+}
+
+void ObservableTest::testConcurrentNotifications() {
+    BOOST_TEST_MESSAGE("Testing concurrent registrations and "
+                       "notifications on shared observables...");
+
+    const Size nThreads = 4, iterations = 2000;
+
+    std::vector<ext::shared_ptr<Notifier> > notifiers;
+    for (Size i=0; i<4; ++i)
+        notifiers.push_back(ext::make_shared<Notifier>());
+
+    // long-lived observers, e.g., instruments priced on all threads
+    std::vector<ext::shared_ptr<MTUpdateCounter> > observers;
+    for (Size i=0; i<10; ++i) {
+        observers.push_back(ext::make_shared<MTUpdateCounter>());
+        observers.back()->registerWith(notifiers[i % notifiers.size()]);
+    }
+
+    boost::atomic<Size> missed(0);
+    boost::thread_group threads;
+    for (Size i=0; i<nThreads; ++i)
+        threads.create_thread([&]() {
+            registerAndNotify(notifiers, iterations, &missed);
+        });
+    threads.join_all();
+
+    if (missed != 0)
+        BOOST_ERROR(Size(missed) << " observers missed a notification "
+                    "sent after their registration");
+
+    const Size expected = nThreads*iterations/notifiers.size();
+    for (Size i=0; i<observers.size(); ++i) {
+        if (Size(observers[i]->counter()) != expected)
+            BOOST_ERROR("observer #" << i << " received "
+                        << observers[i]->counter()
+                        << " notifications instead of " << expected);
+    }
+    if (MTUpdateCounter::instanceCounter() != int(observers.size()))
+        BOOST_ERROR("observers not destroyed");
+}
 #endif
 
 void ObservableTest::testDeepUpdate() {
@@ -319,6 +384,138 @@ void ObservableTest::testEmptyObserverList() {
     dummyObserver->unregisterWith(ext::make_shared<SimpleQuote>(10.0));
 }
 
+namespace {
+
+    // forwards all notifications, as bootstrap helpers do
+    class Forwarder : public Observer, public Observable {
+      public:
+        explicit Forwarder(std::vector<const Forwarder*>& log) : log_(log) {}
+        void update() override {
+            ++counter_;
+            log_.push_back(this);
+            notifyObservers();
+        }
+        Size counter() const { return counter_; }
+
+      private:
+        std::vector<const Forwarder*>& log_;
+        Size counter_ = 0;
+    };
+
+}
+
+void ObservableTest::testNotificationBatch() {
+
+    BOOST_TEST_MESSAGE("Testing batched notifications...");
+
+    ObservableSettings& settings = ObservableSettings::instance();
+
+    // each quote is observed by three forwarders, which are in
+    // turn observed by a fourth one also observing the first quote
+    std::vector<const Forwarder*> log;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    for (Size i=0; i<10; ++i)
+        quotes.push_back(ext::make_shared<SimpleQuote>(1.0));
+    std::vector<ext::shared_ptr<Forwarder> > forwarders;
+    ext::shared_ptr<Forwarder> last = ext::make_shared<Forwarder>(log);
+    for (Size j=0; j<3; ++j) {
+        forwarders.push_back(ext::make_shared<Forwarder>(log));
+        for (auto& quote : quotes)
+            forwarders.back()->registerWith(quote);
+        last->registerWith(forwarders.back());
+    }
+    last->registerWith(quotes[0]);
+    UpdateCounter updateCounter;
+    updateCounter.registerWith(last);
+
+    for (auto& quote : quotes)
+        quote->setValue(2.0);
+    if (updateCounter.counter() != 31)
+        BOOST_FAIL("expected 31 notifications, " << updateCounter.counter()
+                   << " received");
+
+    settings.resetBatchStatistics();
+    log.clear();
+    {
+        NotificationBatch batch;
+        for (auto& quote : quotes)
+            quote->setValue(3.0);
+        if (updateCounter.counter() != 31)
+            BOOST_FAIL("notifications sent while batching");
+        {
+            NotificationBatch nestedBatch;
+            quotes[5]->setValue(4.0);
+        }
+        if (updateCounter.counter() != 31)
+            BOOST_FAIL("notifications sent at the end of a nested batch");
+    }
+
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    // the forwarders notify the last one while the batch is sent;
+    // those notifications are collected as well
+    Size expectedUpdates = 32, expectedLog = 4;
+    // quotes: 10 x 3 + 1 + 3; forwarders: 3 x 1; last: 1
+    Size notifications = 38, updates = 5;
+#else
+    // the notifications sent while the batch is sent are not collected
+    Size expectedUpdates = 35, expectedLog = 7;
+    // quotes: 10 x 3 + 1 + 3
+    Size notifications = 34, updates = 4;
+#endif
+
+    if (updateCounter.counter() != expectedUpdates)
+        BOOST_FAIL("expected " << expectedUpdates << " notifications, "
+                   << updateCounter.counter() << " received");
+
+    for (auto& forwarder : forwarders) {
+        if (forwarder->counter() != 11)
+            BOOST_ERROR("forwarder updated " << forwarder->counter()
+                        << " times instead of 11");
+    }
+    if (last->counter() != expectedUpdates)
+        BOOST_ERROR("last forwarder updated " << last->counter()
+                    << " times instead of " << expectedUpdates);
+    if (log.size() != expectedLog)
+        BOOST_ERROR(log.size() << " updates logged instead of "
+                    << expectedLog);
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    if (log.back() != last.get())
+        BOOST_ERROR("observers not updated in topological order");
+#endif
+
+    if (settings.batchedNotifications() != notifications)
+        BOOST_ERROR("expected " << notifications << " batched notifications, "
+                    << settings.batchedNotifications() << " recorded");
+    if (settings.batchedUpdates() != updates)
+        BOOST_ERROR("expected " << updates << " updates sent, "
+                    << settings.batchedUpdates() << " recorded");
+
+    // explicitly disabled updates take precedence
+    {
+        RestoreUpdates guard;
+        settings.disableUpdates(false);
+        NotificationBatch batch;
+        quotes[0]->setValue(5.0);
+    }
+    if (updateCounter.counter() != expectedUpdates)
+        BOOST_FAIL("disabled notifications sent at the end of a batch");
+
+#ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    // batches don't collect the notifications sent by other threads
+    {
+        NotificationBatch batch;
+        const ext::shared_ptr<SimpleQuote> quote =
+            ext::make_shared<SimpleQuote>(1.0);
+        UpdateCounter counter;
+        counter.registerWith(quote);
+        boost::thread notifier([&quote]() { quote->setValue(2.0); });
+        notifier.join();
+        if (counter.counter() != 1)
+            BOOST_FAIL("notification sent by another thread was batched");
+    }
+#endif
+}
+
 test_suite* ObservableTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Observer tests");
 
@@ -328,10 +525,14 @@ test_suite* ObservableTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testAsyncGarbagCollector));
     suite->add(QUANTLIB_TEST_CASE(
         &ObservableTest::testMultiThreadingGlobalSettings));
+    suite->add(QUANTLIB_TEST_CASE(
+        &ObservableTest::testConcurrentNotifications));
 #endif
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDeepUpdate));
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testEmptyObserverList));
+
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testNotificationBatch));
     return suite;
 }
 
@@ -30,8 +30,10 @@ class ObservableTest {
     static void testObservableSettings();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
+    static void testConcurrentNotifications();
     static void testDeepUpdate();
     static void testEmptyObserverList();
+    static void testNotificationBatch();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -115,6 +115,57 @@ void OperatorTest::testTridiagonal() {
                    "\n                  tolerance: " << tolerance);
 }
 
+void OperatorTest::testTridiagonalFactorizationReuse() {
+
+    BOOST_TEST_MESSAGE("Testing reuse of tridiagonal operator "
+                       "factorization...");
+
+    Size n = 8;
+
+    TridiagonalOperator T(n);
+    T.setFirstRow(1.0, 2.0);
+    T.setMidRows( 0.5, 2.0, 0.5);
+    T.setLastRow(      2.0, 1.0);
+
+    Array rhs(n);
+    for (Size i=0; i<n; ++i)
+        rhs[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    for (Size k=0; k<3; ++k) {
+        // modify the operator after the first solution
+        if (k == 1)
+            T.setMidRow(3, 0.25, 3.0, 0.75);
+        // rows set to their current values must not do any harm
+        if (k == 2)
+            T.setFirstRow(1.0, 2.0);
+
+        const Array calculated = T.solveFor(rhs);
+
+        // a new operator is factorized from scratch
+        const TridiagonalOperator fresh(T.lowerDiagonal(),
+                                        T.diagonal(),
+                                        T.upperDiagonal());
+        const Array expected = fresh.solveFor(rhs);
+
+        for (Size i=0; i<n; ++i) {
+            if (calculated[i] != expected[i])
+                BOOST_FAIL("\n reused factorization gives a different "
+                           "solution:"
+                           "\n   expected: " << expected <<
+                           "\n calculated: " << calculated);
+        }
+
+        // solving again must not factorize again
+        T.solveFor(rhs);
+
+        const Size expectedFactorizations = (k == 0) ? 1 : 2;
+        if (T.factorizations() != expectedFactorizations)
+            BOOST_FAIL("\n wrong number of factorizations:"
+                       "\n   expected: " << expectedFactorizations <<
+                       "\n calculated: " << T.factorizations());
+    }
+}
+
 void OperatorTest::testConsistency() {
 
     BOOST_TEST_MESSAGE("Testing differential operators...");
@@ -229,6 +280,7 @@ void OperatorTest::testBSMOperatorConsistency() {
 test_suite* OperatorTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Operator tests");
     suite->add(QUANTLIB_TEST_CASE(&OperatorTest::testTridiagonal));
+    suite->add(QUANTLIB_TEST_CASE(&OperatorTest::testTridiagonalFactorizationReuse));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&OperatorTest::testConsistency));
     // FLOATING_POINT_EXCEPTION
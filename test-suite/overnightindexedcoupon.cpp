@@ -271,6 +271,69 @@ void OvernightIndexedCouponTest::testAccruedAmountOnFutureHoliday() {
     CHECK_OIS_COUPON_RESULT("coupon amount", coupon->accruedAmount(accrualDate), expectedAmount, 1e-8);
 }
     
+void OvernightIndexedCouponTest::testUpdatedPastFixings() {
+    BOOST_TEST_MESSAGE("Testing overnight-indexed coupon after changes in past fixings...");
+
+    using namespace overnight_indexed_coupon_tests;
+
+    CommonVars vars;
+
+    vars.forecastCurve.linkTo(flatRate(0.0010, Actual360()));
+
+    auto pastCoupon = vars.makeCoupon(Date(18, October, 2021),
+                                      Date(18, November, 2021));
+    auto currentCoupon = vars.makeCoupon(Date(10, November, 2021),
+                                         Date(10, December, 2021));
+
+    Rate expectedPastRate = 0.000987136104;
+    Rate expectedCurrentRate = 0.000926701551;
+    CHECK_OIS_COUPON_RESULT("coupon rate", pastCoupon->rate(), expectedPastRate, 1e-12);
+    CHECK_OIS_COUPON_RESULT("coupon rate", currentCoupon->rate(), expectedCurrentRate, 1e-12);
+
+    // overwritten fixing; fresh coupons give the expected results
+
+    vars.sofr->addFixing(Date(15, November, 2021), 0.0018, true);
+
+    CHECK_OIS_COUPON_RESULT("coupon rate after overwriting fixing",
+                            pastCoupon->rate(),
+                            vars.makeCoupon(Date(18, October, 2021),
+                                            Date(18, November, 2021))->rate(),
+                            1e-15);
+    CHECK_OIS_COUPON_RESULT("coupon rate after overwriting fixing",
+                            currentCoupon->rate(),
+                            vars.makeCoupon(Date(10, November, 2021),
+                                            Date(10, December, 2021))->rate(),
+                            1e-15);
+
+    // cleared and reloaded fixings
+
+    std::vector<Date> dates = vars.sofr->timeSeries().dates();
+    std::vector<Real> values = vars.sofr->timeSeries().values();
+    for (Size i = 0; i < dates.size(); ++i) {
+        if (dates[i] == Date(15, November, 2021))
+            values[i] = 0.0008;
+    }
+    vars.sofr->clearFixings();
+    vars.sofr->addFixings(dates.begin(), dates.end(), values.begin());
+
+    CHECK_OIS_COUPON_RESULT("coupon rate after reloading fixings",
+                            pastCoupon->rate(), expectedPastRate, 1e-12);
+    CHECK_OIS_COUPON_RESULT("coupon rate after reloading fixings",
+                            currentCoupon->rate(), expectedCurrentRate, 1e-12);
+
+    // new fixings, and the evaluation date moving forward
+
+    vars.sofr->addFixing(Date(23, November, 2021), 0.0007);
+    vars.sofr->addFixing(Date(24, November, 2021), 0.0006);
+    Settings::instance().evaluationDate() = Date(26, November, 2021);
+
+    CHECK_OIS_COUPON_RESULT("coupon rate after new fixings",
+                            currentCoupon->rate(),
+                            vars.makeCoupon(Date(10, November, 2021),
+                                            Date(10, December, 2021))->rate(),
+                            1e-15);
+}
+
 test_suite* OvernightIndexedCouponTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Overnight-indexed coupon tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedCouponTest::testPastCouponRate));
@@ -282,6 +345,7 @@ test_suite* OvernightIndexedCouponTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedCouponTest::testAccruedAmountInTheFuture));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedCouponTest::testAccruedAmountOnPastHoliday));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedCouponTest::testAccruedAmountOnFutureHoliday));
+    suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedCouponTest::testUpdatedPastFixings));
 
     return suite;
 }
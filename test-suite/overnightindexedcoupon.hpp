@@ -33,6 +33,7 @@ class OvernightIndexedCouponTest {
     static void testAccruedAmountInTheFuture();
     static void testAccruedAmountOnPastHoliday();
     static void testAccruedAmountOnFutureHoliday();
+    static void testUpdatedPastFixings();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -20,8 +20,12 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -138,6 +142,88 @@ namespace {
         }
     }
 
+    void testSingleBatch(const ext::shared_ptr<StochasticProcess1D>& process,
+                         const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef PathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12, paths = 50;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(timeSteps, seed);
+        PathGenerator<rsg_type> generator(process, length, timeSteps,
+                                          rsg, brownianBridge);
+        PathGenerator<rsg_type> batchGenerator(process, length, timeSteps,
+                                               rsg, brownianBridge);
+
+        for (Size k=0; k<2; k++) {
+            const Matrix batch = batchGenerator.nextBatch(paths);
+            const Matrix antithetic = batchGenerator.antitheticBatch();
+            for (Size j=0; j<paths; j++) {
+                const sample_type sample = generator.next();
+                const sample_type antitheticSample = generator.antithetic();
+                for (Size i=0; i<=timeSteps; i++) {
+                    if (batch[i][j] != sample.value[i]
+                        || antithetic[i][j] != antitheticSample.value[i])
+                        BOOST_FAIL("using " << tag << " process "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "brownian bridge:\n"
+                                   << "batch path " << j
+                                   << " differs at step " << i << ":\n"
+                                   << std::setprecision(16)
+                                   << "    single path: " << sample.value[i]
+                                   << "\n    batch:       " << batch[i][j]
+                                   << "\n    antithetic single path: "
+                                   << antitheticSample.value[i]
+                                   << "\n    antithetic batch:       "
+                                   << antithetic[i][j]);
+                }
+            }
+        }
+    }
+
+    void testMultipleBatch(const ext::shared_ptr<StochasticProcess>& process,
+                           const std::string& tag) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12, paths = 50;
+        Size assets = process->size();
+        rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                        timeSteps*process->factors(), seed);
+        MultiPathGenerator<rsg_type> generator(
+                         process, TimeGrid(length, timeSteps), rsg, false);
+        MultiPathGenerator<rsg_type> batchGenerator(
+                         process, TimeGrid(length, timeSteps), rsg, false);
+
+        const std::vector<Matrix> batch = batchGenerator.nextBatch(paths);
+        const std::vector<Matrix> antithetic =
+            batchGenerator.antitheticBatch();
+        for (Size j=0; j<paths; j++) {
+            const sample_type sample = generator.next();
+            const sample_type antitheticSample = generator.antithetic();
+            for (Size a=0; a<assets; a++) {
+                for (Size i=0; i<=timeSteps; i++) {
+                    if (batch[a][i][j] != sample.value[a][i]
+                        || antithetic[a][i][j] != antitheticSample.value[a][i])
+                        BOOST_FAIL("using " << tag << " process:\n"
+                                   << "batch path " << j << " differs at step "
+                                   << i << " for " << io::ordinal(a+1)
+                                   << " asset:\n"
+                                   << std::setprecision(16)
+                                   << "    single path: " << sample.value[a][i]
+                                   << "\n    batch:       " << batch[a][i][j]
+                                   << "\n    antithetic single path: "
+                                   << antitheticSample.value[a][i]
+                                   << "\n    antithetic batch:       "
+                                   << antithetic[a][i][j]);
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +376,83 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testBatchGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing batch path generation against single paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(ext::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> bsProcess(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testSingleBatch(bsProcess, "Black-Scholes", false);
+    testSingleBatch(bsProcess, "Black-Scholes", true);
+    testSingleBatch(ext::shared_ptr<StochasticProcess1D>(
+                                      new HullWhiteProcess(r, 0.1, 0.01)),
+                    "Hull-White", false);
+    testSingleBatch(ext::shared_ptr<StochasticProcess1D>(
+                                     new OrnsteinUhlenbeckProcess(0.1, 0.20)),
+                    "Ornstein-Uhlenbeck", false);
+
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponentialMartingale };
+    for (auto& scheme : schemes) {
+        testMultipleBatch(ext::shared_ptr<StochasticProcess>(
+                              new HestonProcess(r, q, x0, 0.04, 1.5, 0.04,
+                                                0.6, -0.7, scheme)),
+                          "Heston");
+    }
+
+    Matrix correlation(2,2);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.6;
+    correlation[1][0] = 0.6; correlation[1][1] = 1.0;
+    std::vector<ext::shared_ptr<StochasticProcess1D> > processes(2, bsProcess);
+    testMultipleBatch(ext::shared_ptr<StochasticProcess>(
+                          new StochasticProcessArray(processes, correlation)),
+                      "Black-Scholes array");
+
+    // batch path pricers
+    typedef PseudoRandom::rsg_type rsg_type;
+    Size timeSteps = 12, paths = 100;
+    rsg_type rsg = PseudoRandom::make_sequence_generator(timeSteps, 42);
+    PathGenerator<rsg_type> generator(bsProcess, 1.0, timeSteps, rsg, false);
+    const Matrix& batch = generator.nextBatch(paths);
+
+    EuropeanPathPricer europeanPricer(Option::Call, 100.0, 0.95);
+    ArithmeticAPOPathPricer asianPricer(Option::Put, 100.0, 0.95, 110.0, 1);
+    const Array europeanValues = europeanPricer(batch, generator.timeGrid());
+    const Array asianValues = asianPricer(batch, generator.timeGrid());
+
+    for (Size j=0; j<paths; j++) {
+        Path path(generator.timeGrid(),
+                  Array(batch.column_begin(j), batch.column_end(j)));
+        if (europeanValues[j] != europeanPricer(path)
+            || asianValues[j] != asianPricer(path))
+            BOOST_FAIL("batch pricing differs for path " << j << ":\n"
+                       << std::setprecision(16)
+                       << "    European single path: " << europeanPricer(path)
+                       << "\n    European batch:       " << europeanValues[j]
+                       << "\n    Asian single path:    " << asianPricer(path)
+                       << "\n    Asian batch:          " << asianValues[j]);
+    }
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBatchGeneration));
     return suite;
 }
 
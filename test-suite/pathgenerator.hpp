@@ -29,6 +29,7 @@ class PathGeneratorTest {
   public:
     static void testPathGenerator();
     static void testMultiPathGenerator();
+    static void testBatchGeneration();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/indexes/bmaindex.hpp>
+#include <ql/indexes/ibor/estr.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/jpylibor.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
@@ -33,12 +34,15 @@
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/globalbootstrap.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/oisratehelper.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/time/asx.hpp>
@@ -47,6 +51,7 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/imm.hpp>
@@ -1393,6 +1398,206 @@ void PiecewiseYieldCurveTest::testGlobalBootstrap() {
     }
 }
 
+void PiecewiseYieldCurveTest::testImpliedQuoteSensitivities() {
+
+    BOOST_TEST_MESSAGE("Testing analytic sensitivities of implied quotes...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    ext::shared_ptr<IborIndex> euribor3m = ext::make_shared<Euribor3M>();
+    ext::shared_ptr<IborIndex> euribor6m = ext::make_shared<Euribor6M>();
+    std::vector<ext::shared_ptr<RateHelper> > helpers = {
+        ext::make_shared<DepositRateHelper>(0.03, euribor6m),
+        ext::make_shared<FraRateHelper>(0.03, 3, euribor6m),
+        ext::make_shared<FraRateHelper>(0.03, 3, euribor6m, Pillar::LastRelevantDate,
+                                        Date(), false),
+        ext::make_shared<FuturesRateHelper>(97.0, IMM::nextDate(vars.settlement),
+                                            euribor3m)
+    };
+
+    FlatForward flatCurve(vars.today, 0.03, Actual365Fixed());
+    Real h = 1.0e-6;
+
+    for (auto& helper : helpers) {
+        helper->setTermStructure(&flatCurve);
+        std::vector<std::pair<Date, Real> > sensitivities =
+            helper->impliedQuoteSensitivities();
+        if (sensitivities.empty())
+            BOOST_FAIL("no sensitivities returned for the helper with pillar "
+                       << helper->pillarDate());
+
+        // a curve with nodes at the relevant dates, so that each
+        // discount factor can be moved alone
+        std::vector<Date> dates(1, vars.today);
+        for (auto& sensitivity : sensitivities)
+            dates.push_back(sensitivity.first);
+        dates.push_back(vars.today + 30*Years);
+        std::vector<DiscountFactor> discounts;
+        for (auto& date : dates)
+            discounts.push_back(flatCurve.discount(date));
+
+        for (Size i=0; i<sensitivities.size(); ++i) {
+            std::vector<DiscountFactor> bumped = discounts;
+            bumped[i+1] = discounts[i+1] + h;
+            DiscountCurve up(dates, bumped, Actual365Fixed());
+            helper->setTermStructure(&up);
+            Real quoteUp = helper->impliedQuote();
+            bumped[i+1] = discounts[i+1] - h;
+            DiscountCurve down(dates, bumped, Actual365Fixed());
+            helper->setTermStructure(&down);
+            Real quoteDown = helper->impliedQuote();
+
+            Real calculated = sensitivities[i].second;
+            Real expected = (quoteUp - quoteDown) / (2.0*h);
+            Real tolerance = 1.0e-6 * std::max(1.0, std::fabs(expected));
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce implied-quote sensitivity"
+                            << " for the helper with pillar "
+                            << helper->pillarDate()
+                            << " at " << sensitivities[i].first << ":"
+                            << std::setprecision(10)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
+void PiecewiseYieldCurveTest::testSwapHelpersImpliedQuote() {
+
+    BOOST_TEST_MESSAGE("Testing implied quotes of swap helpers against their swaps...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    ext::shared_ptr<IborIndex> euribor6m = ext::make_shared<Euribor6M>();
+    ext::shared_ptr<OvernightIndex> estr = ext::make_shared<Estr>();
+    Handle<YieldTermStructure> discountCurve(
+        ext::make_shared<FlatForward>(vars.today, 0.02, Actual365Fixed()));
+    Handle<Quote> spread(ext::make_shared<SimpleQuote>(0.001));
+
+    std::vector<ext::shared_ptr<SwapRateHelper> > swapHelpers = {
+        ext::make_shared<SwapRateHelper>(0.03, 10*Years, TARGET(), Annual, Unadjusted,
+                                         Thirty360(Thirty360::BondBasis), euribor6m),
+        ext::make_shared<SwapRateHelper>(0.03, 10*Years, TARGET(), Annual, Unadjusted,
+                                         Thirty360(Thirty360::BondBasis), euribor6m,
+                                         spread, 1*Years, discountCurve)
+    };
+    std::vector<ext::shared_ptr<OISRateHelper> > oisHelpers = {
+        ext::make_shared<OISRateHelper>(2, 5*Years, Handle<Quote>(ext::make_shared<SimpleQuote>(0.03)), estr),
+        ext::make_shared<OISRateHelper>(2, 5*Years, Handle<Quote>(ext::make_shared<SimpleQuote>(0.03)), estr,
+                                        discountCurve, false, 2)
+    };
+
+    Real basisPoint = 1.0e-4;
+
+    for (Rate r : {0.03, 0.01}) {
+        FlatForward flatCurve(vars.today, r, Actual365Fixed());
+
+        for (auto& helper : swapHelpers) {
+            helper->setTermStructure(&flatCurve);
+            Real calculated = helper->impliedQuote();
+            ext::shared_ptr<VanillaSwap> swap = helper->swap();
+            Real expected =
+                -(swap->floatingLegNPV() + swap->floatingLegBPS()/basisPoint*helper->spread())
+                / (swap->fixedLegBPS()/basisPoint);
+            if (calculated != expected)
+                BOOST_ERROR("failed to reproduce swap fair rate"
+                            << " for the helper with pillar " << helper->pillarDate() << ":"
+                            << std::setprecision(17)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+        for (auto& helper : oisHelpers) {
+            helper->setTermStructure(&flatCurve);
+            Real calculated = helper->impliedQuote();
+            Real expected = helper->swap()->fairRate();
+            if (calculated != expected)
+                BOOST_ERROR("failed to reproduce OIS fair rate"
+                            << " for the helper with pillar " << helper->pillarDate() << ":"
+                            << std::setprecision(17)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // after a bootstrap, the swaps must reflect the curve built in place
+    std::vector<ext::shared_ptr<RateHelper> > helpers = {
+        swapHelpers[0], oisHelpers[0]
+    };
+    PiecewiseYieldCurve<Discount, LogLinear> curve(vars.settlement, helpers, Actual365Fixed());
+    curve.discount(1.0);
+
+    Real tolerance = 1.0e-12;
+    Real swapRate = swapHelpers[0]->swap()->fairRate();
+    if (std::fabs(swapRate - 0.03) > tolerance)
+        BOOST_ERROR("failed to reproduce swap quote after bootstrap:"
+                    << std::setprecision(12)
+                    << "\n    fair rate: " << swapRate
+                    << "\n    quote:     " << 0.03);
+    Real oisRate = oisHelpers[0]->swap()->fairRate();
+    if (std::fabs(oisRate - 0.03) > tolerance)
+        BOOST_ERROR("failed to reproduce OIS quote after bootstrap:"
+                    << std::setprecision(12)
+                    << "\n    fair rate: " << oisRate
+                    << "\n    quote:     " << 0.03);
+}
+
+void PiecewiseYieldCurveTest::testGlobalBootstrapWarmStart() {
+
+    BOOST_TEST_MESSAGE("Testing warm start of global bootstrap...");
+
+    using namespace piecewise_yield_curve_test;
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount, LogLinear, GlobalBootstrap> Curve;
+    // the optimizer is also given the bootstrap Jacobian here, while the
+    // expected curves below use the default one
+    Curve curve(vars.settlement, vars.instruments, Actual360(), LogLinear(),
+                Curve::bootstrap_type(1.0e-12, true, true));
+    // the first bootstrap has nothing to start from
+    curve.recalculate();
+
+    Real tolerance = 1.0e-10;
+    Real shifts[] = { 0.00001, -0.00002, 0.0005 };
+
+    for (Size k=0; k<LENGTH(shifts); ++k) {
+        for (Size i=k; i<vars.rates.size(); i+=3)
+            vars.rates[i]->setValue(vars.rates[i]->value() + shifts[k]);
+
+        Curve expected(vars.settlement, vars.instruments, Actual360(),
+                       LogLinear(), Curve::bootstrap_type(1.0e-12));
+
+        for (auto& date : curve.dates()) {
+            Real error = std::fabs(curve.discount(date)
+                                   - expected.discount(date));
+            if (error > tolerance)
+                BOOST_ERROR("warm-started curve differs from a new bootstrap"
+                            << " at " << date << ":"
+                            << std::setprecision(12)
+                            << "\n    discount:   " << curve.discount(date)
+                            << "\n    expected:   " << expected.discount(date)
+                            << "\n    error:      " << error
+                            << "\n    tolerance:  " << tolerance);
+        }
+        for (Size i=0; i<vars.instruments.size(); ++i) {
+            vars.instruments[i]->setTermStructure(&curve);
+            Real error = std::fabs(vars.instruments[i]->quoteError());
+            if (error > tolerance)
+                BOOST_ERROR("failed to reproduce the quote of the "
+                            << io::ordinal(i+1) << " helper:"
+                            << std::setprecision(12)
+                            << "\n    error:      " << error
+                            << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
 /* This test attempts to build an ARS collateralised in USD curve as of 25 Sep 2019. Using the default 
    IterativeBootstrap with no retries, the yield curve building fails. Allowing retries, it expands the min and max 
    bounds and passes.
@@ -1502,6 +1707,213 @@ void PiecewiseYieldCurveTest::testIterativeBootstrapRetries() {
     BOOST_CHECK_SMALL(calcFwd - expFwd, 1e-10);
 }
 
+namespace piecewise_yield_curve_test {
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear> IntradayCurve;
+
+    struct IntradayCurves {
+        ext::shared_ptr<IntradayCurve> estr, euribor;
+        std::vector<ext::shared_ptr<RateHelper> > euriborHelpers;
+    };
+
+    // ESTR swaps plus Euribor 6M deposit, FRAs and swaps discounted
+    // on ESTR, as quoted on a trading desk during the day
+    struct IntradayMarket {
+        std::vector<Period> oisTenors, swapTenors;
+        std::vector<Natural> fraStarts;
+        std::vector<ext::shared_ptr<SimpleQuote> > oisRates, euriborRates;
+
+        IntradayMarket() {
+            for (Integer i=1; i<=3; ++i)
+                oisTenors.push_back(i*Weeks);
+            for (Integer i : {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 15, 18})
+                oisTenors.push_back(i*Months);
+            for (Integer i : {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 15, 20,
+                              25, 30, 40, 50})
+                oisTenors.push_back(i*Years);
+
+            fraStarts = {1, 2, 3, 4, 5, 9, 12};
+
+            for (Integer i : {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 15, 20,
+                              25, 30, 40, 50})
+                swapTenors.push_back(i*Years);
+
+            for (auto& oisTenor : oisTenors)
+                oisRates.push_back(ext::make_shared<SimpleQuote>(
+                                                  rate(years(oisTenor))));
+            euriborRates.push_back(ext::make_shared<SimpleQuote>(
+                                                  rate(0.5) + 0.0020));
+            for (unsigned int fraStart : fraStarts)
+                euriborRates.push_back(ext::make_shared<SimpleQuote>(
+                                        rate((fraStart+6)/12.0) + 0.0020));
+            for (auto& swapTenor : swapTenors)
+                euriborRates.push_back(ext::make_shared<SimpleQuote>(
+                                        rate(years(swapTenor)) + 0.0020));
+        }
+
+        static Time years(const Period& p) {
+            switch (p.units()) {
+              case Weeks:
+                return p.length()/52.0;
+              case Months:
+                return p.length()/12.0;
+              default:
+                return p.length();
+            }
+        }
+
+        static Rate rate(Time t) {
+            return 0.02 + 0.01*(1.0 - std::exp(-t/5.0));
+        }
+
+        // each call builds new helpers and curves on the same quotes
+        IntradayCurves curves() const {
+            IntradayCurves result;
+
+            ext::shared_ptr<OvernightIndex> estr = ext::make_shared<Estr>();
+            std::vector<ext::shared_ptr<RateHelper> > oisHelpers;
+            for (Size i=0; i<oisTenors.size(); ++i)
+                oisHelpers.push_back(ext::make_shared<OISRateHelper>(
+                    2, oisTenors[i], Handle<Quote>(oisRates[i]), estr,
+                    Handle<YieldTermStructure>(), true));
+            result.estr = ext::make_shared<IntradayCurve>(
+                0, TARGET(), oisHelpers, Actual365Fixed());
+
+            Handle<YieldTermStructure> discountCurve(result.estr);
+            ext::shared_ptr<IborIndex> euribor6m =
+                ext::make_shared<Euribor6M>();
+            Size k = 0;
+            result.euriborHelpers.push_back(
+                ext::make_shared<DepositRateHelper>(
+                    Handle<Quote>(euriborRates[k++]), euribor6m));
+            for (unsigned int fraStart : fraStarts)
+                result.euriborHelpers.push_back(
+                    ext::make_shared<FraRateHelper>(
+                        Handle<Quote>(euriborRates[k++]), fraStart,
+                        euribor6m));
+            for (auto& swapTenor : swapTenors)
+                result.euriborHelpers.push_back(
+                    ext::make_shared<SwapRateHelper>(
+                        Handle<Quote>(euriborRates[k++]), swapTenor,
+                        TARGET(), Annual, Unadjusted,
+                        Thirty360(Thirty360::BondBasis), euribor6m,
+                        Handle<Quote>(), 0*Days, discountCurve));
+            result.euribor = ext::make_shared<IntradayCurve>(
+                0, TARGET(), result.euriborHelpers, Actual365Fixed());
+
+            return result;
+        }
+    };
+
+    void checkAgainstNewCurves(const IntradayMarket& market,
+                               const IntradayCurves& curves,
+                               Real tolerance) {
+        IntradayCurves expected = market.curves();
+
+        for (const Date& d : curves.estr->dates()) {
+            Real error = std::fabs(curves.estr->discount(d)
+                                   - expected.estr->discount(d));
+            if (error > tolerance)
+                BOOST_FAIL("ESTR curve differs from a new bootstrap at "
+                           << d << ":"
+                           << std::setprecision(12)
+                           << "\n    discount:   " << curves.estr->discount(d)
+                           << "\n    expected:   " << expected.estr->discount(d)
+                           << "\n    error:      " << error
+                           << "\n    tolerance:  " << tolerance);
+        }
+        for (const Date& d : curves.euribor->dates()) {
+            Real error = std::fabs(curves.euribor->discount(d)
+                                   - expected.euribor->discount(d));
+            if (error > tolerance)
+                BOOST_FAIL("Euribor curve differs from a new bootstrap at "
+                           << d << ":"
+                           << std::setprecision(12)
+                           << "\n    discount:   "
+                           << curves.euribor->discount(d)
+                           << "\n    expected:   "
+                           << expected.euribor->discount(d)
+                           << "\n    error:      " << error
+                           << "\n    tolerance:  " << tolerance);
+        }
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap after quote changes...");
+
+    using namespace piecewise_yield_curve_test;
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, March, 2021);
+
+    IntradayMarket market;
+    IntradayCurves curves = market.curves();
+    Real tolerance = 1.0e-10;
+
+    for (Size i : {Size(3), Size(12), market.euriborRates.size()-1}) {
+        std::vector<Date> dates = curves.euribor->dates();
+        std::vector<Real> data = curves.euribor->data();
+        Date pillar = curves.euriborHelpers[i]->pillarDate();
+
+        market.euriborRates[i]->setValue(market.euriborRates[i]->value()
+                                         + 0.0005);
+
+        const std::vector<Real>& newData = curves.euribor->data();
+        for (Size j=1; j<dates.size(); ++j) {
+            if (dates[j] < pillar && newData[j] != data[j])
+                BOOST_ERROR("pillar " << dates[j] << " modified after a "
+                            "change in the quote for pillar " << pillar);
+            if (dates[j] == pillar && newData[j] == data[j])
+                BOOST_ERROR("pillar " << pillar << " not modified after "
+                            "a change in its quote");
+        }
+        checkAgainstNewCurves(market, curves, tolerance);
+    }
+
+    // the whole Euribor curve depends on the ESTR one
+    market.oisRates[12]->setValue(market.oisRates[12]->value() + 0.0005);
+    checkAgainstNewCurves(market, curves, tolerance);
+
+    // moving the evaluation date moves the pillars as well
+    Settings::instance().evaluationDate() = Date(16, March, 2021);
+    checkAgainstNewCurves(market, curves, tolerance);
+}
+
+void PiecewiseYieldCurveTest::testIntradayTicks() {
+
+    BOOST_TEST_MESSAGE("Testing intraday curve updates after quote ticks...");
+
+    using namespace piecewise_yield_curve_test;
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, March, 2021);
+
+    IntradayMarket market;
+    IntradayCurves curves = market.curves();
+
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes = market.oisRates;
+    quotes.insert(quotes.end(),
+                  market.euriborRates.begin(), market.euriborRates.end());
+
+    // each tick moves a random quote by up to half a basis point
+    // and asks for the updated curves, as a pricing engine would
+    MersenneTwisterUniformRng rng(42);
+    const Size ticks = 250;
+    for (Size i=0; i<ticks; ++i) {
+        const Size j = std::min(Size(rng.nextReal()*quotes.size()),
+                                quotes.size()-1);
+        quotes[j]->setValue(quotes[j]->value()
+                            + (rng.nextReal()-0.5)*1.0e-4);
+        curves.estr->discount(50.0);
+        curves.euribor->discount(50.0);
+    }
+
+    checkAgainstNewCurves(market, curves, 1.0e-10);
+}
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     auto* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -1557,8 +1969,14 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     if (IborCoupon::Settings::instance().usingAtParCoupons()) {
         suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testGlobalBootstrap));
     }
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testImpliedQuoteSensitivities));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testGlobalBootstrapWarmStart));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testIterativeBootstrapRetries));
 
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testIntradayTicks));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testSwapHelpersImpliedQuote));
+
     return suite;
 }
@@ -59,9 +59,15 @@ class PiecewiseYieldCurveTest {
     static void testLargeRates();
 
     static void testGlobalBootstrap();
+    static void testImpliedQuoteSensitivities();
+    static void testGlobalBootstrapWarmStart();
 
     static void testIterativeBootstrapRetries();
 
+    static void testIncrementalBootstrap();
+    static void testIntradayTicks();
+    static void testSwapHelpersImpliedQuote();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -25,6 +25,10 @@
  test cases. The overall QuantLib Benchmark Index is given by the average
  performance in mflops.
 
+ Test cases which aren't dominated by floating point operations
+ (e.g., curve updates driven by market ticks) are reported separately
+ as throughput figures and don't enter the index.
+
  The number of floating point operations of a given test case was measured
  using the perfex library, http://user.it.uu.se/~mikpe/linux/perfctr
  and PAPI, http://icl.cs.utk.edu/papi
@@ -118,6 +122,27 @@
 
 #include "utilities.hpp"
 
+#include <ql/exercise.hpp>
+#include <ql/instruments/basketoption.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/basket/mcamericanbasketengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/mcamericanengine.hpp>
+#include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <thread>
+
+#ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#include <ql/patterns/observable.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
 #include "americanoption.hpp"
 #include "asianoptions.hpp"
 #include "barrieroption.hpp"
@@ -134,6 +159,7 @@
 #include "marketmodel_smm.hpp"
 #include "marketmodel_cms.hpp"
 #include "lowdiscrepancysequences.hpp"
+#include "piecewiseyieldcurve.hpp"
 #include "quantooption.hpp"
 #include "riskstats.hpp"
 #include "shortratemodels.hpp"
@@ -143,7 +169,7 @@ using namespace boost::unit_test_framework;
 
 namespace {
 
-    std::list<double> runTimes;
+    std::list<double> runTimes, throughputRunTimes;
 
     /* PAPI code
     float real_time, proc_time, mflops;
@@ -153,7 +179,8 @@ namespace {
     class TimedCase {
       public:
         typedef void (*fct_ptr)();
-        explicit TimedCase(fct_ptr f) : f_(f) {}
+        explicit TimedCase(fct_ptr f, std::list<double>& times = runTimes)
+        : f_(f), times_(&times) {}
 
         void startMeasurement() const {
             /* PAPI code
@@ -177,10 +204,11 @@ namespace {
             f_();
             auto stopTime = std::chrono::steady_clock::now();
             stopMeasurement();
-            runTimes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(stopTime - startTime).count() * 1e-6);
+            times_->push_back(std::chrono::duration_cast<std::chrono::microseconds>(stopTime - startTime).count() * 1e-6);
         }
       private:
         fct_ptr f_;
+        std::list<double>* times_;
     };
 
     class Benchmark {
@@ -213,6 +241,268 @@ namespace {
 
     std::list<Benchmark> bm;
 
+    class Throughput {
+      public:
+        typedef void (*fct_ptr)();
+        Throughput(std::string name, fct_ptr f,
+                   double operations, std::string unit)
+        : f_(f, throughputRunTimes), name_(std::move(name)),
+          operations_(operations), unit_(std::move(unit)) {}
+
+        test_case* getTestCase() const {
+            #if BOOST_VERSION >= 105900
+            return boost::unit_test::make_test_case(f_, name_,
+                                                    __FILE__, __LINE__);
+            #else
+            return boost::unit_test::make_test_case(
+                       boost::unit_test::callback0<>(f_), name_);
+            #endif
+        }
+        double getOperations() const {
+            return operations_;
+        }
+        std::string getName() const {
+            return name_;
+        }
+        std::string getUnit() const {
+            return unit_;
+        }
+      private:
+        TimedCase f_;
+        const std::string name_;
+        const double operations_; // total number of operations
+                                  // performed (e.g., market ticks)
+        const std::string unit_;
+    };
+
+    std::list<Throughput> tp;
+
+    #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+
+    /* Contention benchmark for the thread-safe observer pattern:
+       several threads create observers registering with a few shared
+       observables and notify them, as pricing threads do with
+       instruments and shared curves.
+    */
+
+    using QuantLib::Size;
+    namespace ext = QuantLib::ext;
+
+    const Size contentionThreads = 4;
+    const Size contentionIterations = 20000;
+    const Size contentionObservables = 4;
+    // registrations, unregistrations and notification per iteration
+    const Size contentionOperations =
+        contentionThreads*contentionIterations*(2*contentionObservables+1);
+
+    class ContentionObserver : public QuantLib::Observer {
+      public:
+        void update() override { ++updates_; }
+      private:
+        boost::atomic<Size> updates_{0};
+    };
+
+    void testObserverContention() {
+        std::vector<ext::shared_ptr<QuantLib::Observable> > observables;
+        for (Size i=0; i<contentionObservables; ++i)
+            observables.push_back(ext::make_shared<QuantLib::Observable>());
+
+        boost::thread_group threads;
+        for (Size t=0; t<contentionThreads; ++t) {
+            threads.create_thread([&observables]() {
+                for (Size i=0; i<contentionIterations; ++i) {
+                    const auto observer =
+                        ext::make_shared<ContentionObserver>();
+                    for (const auto& observable : observables)
+                        observer->registerWith(observable);
+                    observables[i % observables.size()]->notifyObservers();
+                }
+            });
+        }
+        threads.join_all();
+    }
+
+    #endif
+
+    /* Longstaff-Schwartz engines: calibration and pricing paths per
+       second, on one thread and on all available ones (the latter
+       requires OpenMP support.)
+    */
+    namespace lsm {
+
+        using namespace QuantLib;
+
+        const Size calibrationSamples = 8192;
+        const Size samples = 16384;
+        const Size paths = 2*(calibrationSamples + samples);
+
+        Size threads(bool parallel) {
+            return parallel ? std::max(std::thread::hardware_concurrency(),
+                                       1U)
+                            : 1;
+        }
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process(
+                                                    const Date& today) {
+            const DayCounter dayCounter = Actual365Fixed();
+            return ext::make_shared<GeneralizedBlackScholesProcess>(
+                Handle<Quote>(ext::make_shared<SimpleQuote>(36.0)),
+                Handle<YieldTermStructure>(
+                    ext::make_shared<FlatForward>(today, 0.02, dayCounter)),
+                Handle<YieldTermStructure>(
+                    ext::make_shared<FlatForward>(today, 0.06, dayCounter)),
+                Handle<BlackVolTermStructure>(
+                    ext::make_shared<BlackConstantVol>(
+                        today, NullCalendar(), 0.25, dayCounter)));
+        }
+
+        void bermudanPut(bool parallel) {
+            SavedSettings backup;
+            const Date today(15, May, 2020);
+            Settings::instance().evaluationDate() = today;
+
+            std::vector<Date> exerciseDates;
+            for (Integer i=1; i<=24; ++i)
+                exerciseDates.push_back(today + i*Months);
+
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0),
+                ext::make_shared<BermudanExercise>(exerciseDates));
+            option.setPricingEngine(
+                MakeMCAmericanEngine<PseudoRandom>(process(today))
+                .withSteps(96)
+                .withAntitheticVariate()
+                .withCalibrationSamples(calibrationSamples)
+                .withSamples(samples)
+                .withSeed(42)
+                .withThreads(threads(parallel)));
+            option.NPV();
+        }
+
+        void americanBasket(bool parallel) {
+            SavedSettings backup;
+            const Date today(15, May, 2020);
+            Settings::instance().evaluationDate() = today;
+
+            const Size assets = 5;
+            std::vector<ext::shared_ptr<StochasticProcess1D> >
+                processes(assets, process(today));
+            Matrix correlation(assets, assets, 0.2);
+            for (Size i=0; i<assets; ++i)
+                correlation[i][i] = 1.0;
+
+            BasketOption option(
+                ext::make_shared<MaxBasketPayoff>(
+                    ext::make_shared<PlainVanillaPayoff>(Option::Call,
+                                                         40.0)),
+                ext::make_shared<AmericanExercise>(today,
+                                                   today + 1*Years));
+            option.setPricingEngine(
+                MakeMCAmericanBasketEngine<PseudoRandom>(
+                    ext::make_shared<StochasticProcessArray>(processes,
+                                                             correlation))
+                .withSteps(25)
+                .withAntitheticVariate()
+                .withCalibrationSamples(calibrationSamples)
+                .withSamples(samples)
+                .withSeed(42)
+                .withThreads(threads(parallel)));
+            option.NPV();
+        }
+
+        void testBermudanPut() { bermudanPut(false); }
+        void testParallelBermudanPut() { bermudanPut(true); }
+        void testAmericanBasket() { americanBasket(false); }
+        void testParallelAmericanBasket() { americanBasket(true); }
+
+    }
+
+    /* Black implied volatility: option quotes per second for a chain of
+       calls and puts, inverted one by one and as a batch.
+    */
+    namespace impliedvol {
+
+        using namespace QuantLib;
+
+        const Size quotes = 100000;
+
+        struct Chain {
+            std::vector<Option::Type> types;
+            Array strikes, forwards, stdDevs, discounts, prices;
+            Chain()
+            : types(quotes), strikes(quotes), forwards(quotes, 100.0),
+              stdDevs(quotes), discounts(quotes, 0.97) {
+                for (Size i=0; i<quotes; ++i) {
+                    types[i] = (i % 2 == 0) ? Option::Call : Option::Put;
+                    strikes[i] = 50.0 + 100.0*Real(i)/quotes;
+                    stdDevs[i] = 0.05 + 0.5*Real(i % 97)/97;
+                }
+                prices = blackFormula(types, strikes, forwards, stdDevs,
+                                      discounts);
+            }
+        };
+
+        const Chain& chain() {
+            static Chain chain;
+            return chain;
+        }
+
+        void testScalar() {
+            const Chain& c = chain();
+            for (Size i=0; i<quotes; ++i)
+                blackFormulaImpliedStdDev(c.types[i], c.strikes[i],
+                                          c.forwards[i], c.prices[i],
+                                          c.discounts[i]);
+        }
+
+        void testBatch() {
+            const Chain& c = chain();
+            blackFormulaImpliedStdDev(c.types, c.strikes, c.forwards,
+                                      c.prices, c.discounts);
+        }
+
+    }
+
+    /* American Heston put on a fine time grid: the rollback, i.e. the
+       operator updates and the early-exercise condition applied to
+       every grid point at each step, dominates the setup of the mesher
+       and of the operators, so the figure is in time steps per second.
+    */
+    namespace fdheston {
+
+        using namespace QuantLib;
+
+        const Size timeSteps = 1000;
+
+        void testAmericanTimeStepping() {
+            SavedSettings backup;
+            const Date today(28, March, 2004);
+            Settings::instance().evaluationDate() = today;
+
+            const DayCounter dayCounter = Actual365Fixed();
+            ext::shared_ptr<HestonProcess> process =
+                ext::make_shared<HestonProcess>(
+                    Handle<YieldTermStructure>(
+                        ext::make_shared<FlatForward>(today, 0.05,
+                                                      dayCounter)),
+                    Handle<YieldTermStructure>(
+                        ext::make_shared<FlatForward>(today, 0.0,
+                                                      dayCounter)),
+                    Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+                    0.04, 2.5, 0.04, 0.66, -0.8);
+
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+                ext::make_shared<AmericanExercise>(today + 1*Years));
+            option.setPricingEngine(
+                ext::make_shared<FdHestonVanillaEngine>(
+                    ext::make_shared<HestonModel>(process),
+                    timeSteps, 100, 50));
+            option.NPV();
+        }
+
+    }
+
     void printResults() {
         std::string header = "Benchmark Suite "
         "QuantLib " QL_VERSION;
@@ -244,6 +534,20 @@ namespace {
                   << std::fixed << std::setw(6) << std::setprecision(1)
                   << sum/runTimes.size()
                   << " mflops" << std::endl;
+
+        if (!throughputRunTimes.empty()) {
+            std::cout << std::endl;
+            std::list<Throughput>::const_iterator iterTP = tp.begin();
+            for (iterT = throughputRunTimes.begin();
+                 iterT != throughputRunTimes.end(); ++iterT, ++iterTP) {
+                std::cout << iterTP->getName()
+                          << std::string(42-iterTP->getName().length(),' ')
+                          << ":"
+                          << std::fixed << std::setw(6) << std::setprecision(1)
+                          << iterTP->getOperations()/(*iterT)
+                          << " " << iterTP->getUnit() << std::endl;
+            }
+        }
     }
 }
 
@@ -288,12 +592,38 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.emplace_back("RiskStatistics::Results", &RiskStatisticsTest::testResults, 300.28);
     bm.emplace_back("ShortRateModel::Swaps", &ShortRateModelTest::testSwaps, 454.73);
 
+    tp.emplace_back("PiecewiseYieldCurve::IntradayTicks",
+                    &PiecewiseYieldCurveTest::testIntradayTicks, 250, "ticks/s");
+    tp.emplace_back("LongstaffSchwartz::BermudanPut",
+                    &lsm::testBermudanPut, lsm::paths, "paths/s");
+    tp.emplace_back("LongstaffSchwartz::BermudanPut (parallel)",
+                    &lsm::testParallelBermudanPut, lsm::paths, "paths/s");
+    tp.emplace_back("LongstaffSchwartz::Basket5",
+                    &lsm::testAmericanBasket, lsm::paths, "paths/s");
+    tp.emplace_back("LongstaffSchwartz::Basket5 (parallel)",
+                    &lsm::testParallelAmericanBasket, lsm::paths, "paths/s");
+    tp.emplace_back("FdHestonVanillaEngine::AmericanTimeStepping",
+                    &fdheston::testAmericanTimeStepping, fdheston::timeSteps,
+                    "steps/s");
+    tp.emplace_back("BlackFormula::ImpliedStdDev",
+                    &impliedvol::testScalar, impliedvol::quotes, "quotes/s");
+    tp.emplace_back("BlackFormula::ImpliedStdDev (batch)",
+                    &impliedvol::testBatch, impliedvol::quotes, "quotes/s");
+    #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    tp.emplace_back("Observable::Contention",
+                    &testObserverContention, contentionOperations, "ops/s");
+    #endif
+
     auto* test = BOOST_TEST_SUITE("QuantLib benchmark suite");
 
     for (std::list<Benchmark>::const_iterator iter = bm.begin();
          iter != bm.end(); ++iter) {
         test->add(iter->getTestCase());
     }
+    for (std::list<Throughput>::const_iterator iter = tp.begin();
+         iter != tp.end(); ++iter) {
+        test->add(iter->getTestCase());
+    }
 
     test->add(QUANTLIB_TEST_CASE(printResults));
 
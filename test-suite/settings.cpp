@@ -21,6 +21,15 @@
 #include "utilities.hpp"
 #include <ql/settings.hpp>
 
+#ifdef QL_ENABLE_THREAD_LOCAL_SESSIONS
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
@@ -60,8 +69,93 @@ void SettingsTest::testNotificationsOnDateChange() {
         BOOST_ERROR("missing notification");
 }
 
+#ifdef QL_ENABLE_THREAD_LOCAL_SESSIONS
+
+namespace {
+
+    // everything is built in the calling thread, as it depends
+    // on its evaluation date
+    Real swapNPV(const Date& evaluationDate) {
+        Settings::instance().evaluationDate() = evaluationDate;
+        Handle<YieldTermStructure> curve(
+            ext::make_shared<FlatForward>(0, TARGET(), 0.03,
+                                          Actual365Fixed()));
+        ext::shared_ptr<IborIndex> index =
+            ext::make_shared<Euribor6M>(curve);
+        ext::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(5*Years, index, 0.04)
+            .withEffectiveDate(Date(15, January, 2025))
+            .withNominal(1000000.0);
+        return swap->NPV();
+    }
+
+}
+
+void SettingsTest::testThreadLocalSessions() {
+    BOOST_TEST_MESSAGE("Testing concurrent valuations on thread-local "
+                       "evaluation dates...");
+
+    SavedSettings rollback;
+
+    const Size nThreads = 4, datesPerThread = 10;
+    std::vector<Date> dates;
+    for (Size i=0; i<nThreads*datesPerThread; ++i)
+        dates.push_back(Date(1, October, 2024) + Integer(2*i));
+
+    std::vector<Real> expected(dates.size());
+    for (Size i=0; i<dates.size(); ++i)
+        expected[i] = swapNPV(dates[i]);
+
+    const Date today(1, July, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    std::vector<Real> calculated(dates.size(), Null<Real>());
+    std::vector<Date> evaluationDates(nThreads);
+    std::vector<int> fixingsShared(nThreads, 1);
+    boost::thread_group threads;
+    for (Size t=0; t<nThreads; ++t) {
+        threads.create_thread([&, t]() {
+            // settings are not inherited from the main thread...
+            fixingsShared[t] = int(Euribor6M().hasHistoricalFixing(today));
+            for (Size i=t; i<dates.size(); i+=nThreads)
+                calculated[i] = swapNPV(dates[i]);
+            evaluationDates[t] = Settings::instance().evaluationDate();
+            // ...nor shared among threads
+            Euribor6M().addFixing(today, 0.01*Real(t+1));
+        });
+    }
+    threads.join_all();
+
+    for (Size i=0; i<dates.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > 1.0e-8)
+            BOOST_ERROR("swap NPV on " << dates[i] << " calculated in "
+                        "a separate thread differs from the expected one:"
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+    for (Size t=0; t<nThreads; ++t) {
+        const Date last = dates[t + (datesPerThread-1)*nThreads];
+        if (evaluationDates[t] != last)
+            BOOST_ERROR("evaluation date in thread #" << t << " changed by "
+                        "other threads:"
+                        << "\n    calculated: " << evaluationDates[t]
+                        << "\n    expected:   " << last);
+        if (fixingsShared[t] != 0)
+            BOOST_ERROR("fixing visible from thread #" << t);
+    }
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_ERROR("evaluation date in main thread changed by other threads");
+    if (Euribor6M().hasHistoricalFixing(today))
+        BOOST_ERROR("fixing added in other threads visible from main thread");
+}
+
+#endif
+
 test_suite* SettingsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("SettingsTest tests");
     suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testNotificationsOnDateChange));
+#ifdef QL_ENABLE_THREAD_LOCAL_SESSIONS
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testThreadLocalSessions));
+#endif
     return suite;
 }
@@ -28,6 +28,7 @@
 class SettingsTest {
   public:
     static void testNotificationsOnDateChange();
+    static void testThreadLocalSessions();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -26,7 +26,9 @@
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/onefactormodels/extendedcoxingersollross.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
+#include <ql/pricingengines/swaption/g2swaptionengine.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
@@ -461,6 +463,138 @@ void ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor() {
     }
 }
 
+void ShortRateModelTest::testSwaptionHelperGradients() {
+    BOOST_TEST_MESSAGE("Testing swaption-helper gradients for Hull-White "
+                       "and G2 models against finite differences...");
+
+    using namespace short_rate_models_test;
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    ext::shared_ptr<HullWhite> hullWhite(
+                                   new HullWhite(termStructure, 0.05, 0.008));
+    ext::shared_ptr<G2> g2(
+               new G2(termStructure, 0.1, 0.01, 0.3, 0.012, -0.6));
+
+    struct ModelCase {
+        std::string description;
+        ext::shared_ptr<CalibratedModel> model;
+        ext::shared_ptr<PricingEngine> engine;
+    };
+    const ModelCase models[] = {
+        { "Hull-White", hullWhite,
+          ext::make_shared<JamshidianSwaptionEngine>(hullWhite) },
+        { "G2", g2, ext::make_shared<G2SwaptionEngine>(g2, 6.0, 64) }
+    };
+
+    const Integer starts[] = { 1, 3, 5 };
+    const Integer lengths[] = { 5, 2, 1 };
+    const Real relativeStrikes[] = { 0.8, 1.0, 1.2 };
+
+    for (const auto& m : models) {
+        const Array params = m.model->params();
+        for (Size i=0; i<LENGTH(starts); ++i) {
+            for (Real relativeStrike : relativeStrikes) {
+                Handle<Quote> vol(ext::make_shared<SimpleQuote>(0.1));
+                SwaptionHelper atm(Period(starts[i], Years),
+                                   Period(lengths[i], Years), vol, index,
+                                   Period(1, Years),
+                                   Thirty360(Thirty360::BondBasis),
+                                   Actual360(), termStructure);
+                const Rate strike =
+                    relativeStrike*atm.underlyingSwap()->fairRate();
+                SwaptionHelper helper(Period(starts[i], Years),
+                                      Period(lengths[i], Years), vol, index,
+                                      Period(1, Years),
+                                      Thirty360(Thirty360::BondBasis),
+                                      Actual360(), termStructure,
+                                      BlackCalibrationHelper::RelativePriceError,
+                                      strike, 100.0);
+                helper.setPricingEngine(m.engine);
+
+                m.model->setParams(params);
+                const Array calculated = helper.modelValueGradient();
+                if (calculated.size() != params.size())
+                    BOOST_FAIL(m.description << ": wrong gradient size "
+                               << calculated.size());
+
+                for (Size j=0; j<params.size(); ++j) {
+                    const Real h = 1e-5*std::fabs(params[j]);
+                    Array bumped = params;
+                    bumped[j] = params[j] + h;
+                    m.model->setParams(bumped);
+                    const Real up = helper.modelValue();
+                    bumped[j] = params[j] - h;
+                    m.model->setParams(bumped);
+                    const Real down = helper.modelValue();
+                    const Real expected = (up - down)/(2*h);
+
+                    const Real tol = 1e-5*std::max(std::fabs(expected), 1.0);
+                    if (std::fabs(calculated[j] - expected) > tol) {
+                        BOOST_ERROR(m.description << ": failed to reproduce "
+                                    "swaption price derivative"
+                                    << "\n    start:      " << starts[i]
+                                    << "\n    length:     " << lengths[i]
+                                    << "\n    strike:     " << strike
+                                    << "\n    parameter:  " << j
+                                    << "\n    calculated: " << calculated[j]
+                                    << "\n    expected:   " << expected
+                                    << "\n    tolerance:  " << tol);
+                    }
+                }
+            }
+        }
+        m.model->setParams(params);
+    }
+
+    // the analytic Jacobian leads to the same calibration
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    std::vector<ext::shared_ptr<CalibrationHelper> > swaptions;
+    for (auto& i : data) {
+        ext::shared_ptr<BlackCalibrationHelper> helper(
+            new SwaptionHelper(Period(i.start, Years), Period(i.length, Years),
+                               Handle<Quote>(ext::make_shared<SimpleQuote>(i.volatility)),
+                               index, Period(1, Years),
+                               Thirty360(Thirty360::BondBasis), Actual360(),
+                               termStructure));
+        helper->setPricingEngine(models[0].engine);
+        swaptions.push_back(helper);
+    }
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    const Array initialParams = hullWhite->params();
+    LevenbergMarquardt finiteDifferences(1.0e-8, 1.0e-8, 1.0e-8);
+    hullWhite->calibrate(swaptions, finiteDifferences, endCriteria);
+    const Array expected = hullWhite->params();
+
+    hullWhite->setParams(initialParams);
+    LevenbergMarquardt analytic(1.0e-8, 1.0e-8, 1.0e-8, true);
+    hullWhite->calibrate(swaptions, analytic, endCriteria);
+    const Array calculated = hullWhite->params();
+
+    for (Size j=0; j<expected.size(); ++j) {
+        if (std::fabs(calculated[j] - expected[j]) > 1e-6) {
+            BOOST_ERROR("failed to reproduce Hull-White calibration "
+                        "with analytic Jacobian"
+                        << "\n    parameter:  " << j
+                        << "\n    calculated: " << calculated[j]
+                        << "\n    expected:   " << expected[j]);
+        }
+    }
+}
+
 test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Short-rate model tests");
 
@@ -470,6 +604,8 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
     suite->add(QUANTLIB_TEST_CASE(
         &ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor));
+    suite->add(QUANTLIB_TEST_CASE(
+        &ShortRateModelTest::testSwaptionHelperGradients));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
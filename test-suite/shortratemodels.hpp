@@ -34,6 +34,7 @@ class ShortRateModelTest {
     static void testCachedHullWhite2();
     static void testSwaps();
     static void testExtendedCoxIngersollRossDiscountFactor();
+    static void testSwaptionHelperGradients();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -26,11 +26,13 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/yieldcurvesnapshot.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/currency.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -420,6 +422,92 @@ void TermStructureTest::testCompositeZeroYieldStructures() {
     }
 }
 
+void TermStructureTest::testSnapshot() {
+
+    BOOST_TEST_MESSAGE("Testing frozen snapshot of yield term structure...");
+
+    using namespace term_structures_test;
+
+    CommonVars vars;
+
+    auto curve =
+        ext::dynamic_pointer_cast<PiecewiseYieldCurve<Discount,LogLinear> >(
+                                                          vars.termStructure);
+    curve->enableExtrapolation();
+    ext::shared_ptr<YieldTermStructure> spreaded =
+        ext::make_shared<ZeroSpreadedTermStructure>(
+            Handle<YieldTermStructure>(curve),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.01)));
+    spreaded->enableExtrapolation();
+
+    // both curves are log-linear in the discount factors between the
+    // nodes of the bootstrapped curve, so the snapshots must
+    // reproduce them everywhere, including the extrapolated region
+    std::vector<ext::shared_ptr<YieldTermStructure> > curves = { curve, spreaded };
+
+    MersenneTwisterUniformRng rng(42);
+    std::vector<Time> times(1000);
+    for (auto& t : times)
+        t = 40.0 * rng.nextReal();
+    std::vector<Time> sortedTimes = times;
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+
+    Real tolerance = 1.0e-12;
+    for (auto& c : curves) {
+        YieldCurveSnapshot snapshot(*c, curve->dates());
+
+        if (snapshot.referenceDate() != c->referenceDate())
+            BOOST_ERROR("wrong reference date for snapshot: "
+                        << snapshot.referenceDate() << " instead of "
+                        << c->referenceDate());
+
+        Date d = c->referenceDate() + 7*Years;
+        if (std::fabs(snapshot.discount(d) - c->discount(d)) > tolerance)
+            BOOST_ERROR("unable to reproduce discount at " << d << ":"
+                        << std::setprecision(12)
+                        << "\n    snapshot: " << snapshot.discount(d)
+                        << "\n    curve:    " << c->discount(d));
+
+        for (const auto& ts : { times, sortedTimes }) {
+            std::vector<DiscountFactor> discounts(ts.size());
+            snapshot.discount(ts.data(), ts.data() + ts.size(), discounts.data());
+            for (Size i=0; i<ts.size(); ++i) {
+                DiscountFactor expected = c->discount(ts[i]);
+                if (std::fabs(discounts[i] - expected) > tolerance)
+                    BOOST_ERROR("unable to reproduce discount at t = " << ts[i] << ":"
+                                << std::setprecision(12)
+                                << "\n    snapshot: " << discounts[i]
+                                << "\n    curve:    " << expected);
+                if (snapshot.discount(ts[i]) != discounts[i])
+                    BOOST_ERROR("batch and single discounts differ at t = " << ts[i] << ":"
+                                << std::setprecision(17)
+                                << "\n    batch:  " << discounts[i]
+                                << "\n    single: " << snapshot.discount(ts[i]));
+            }
+        }
+    }
+
+    // the snapshot is frozen: changes to the original curve don't
+    // affect it
+    auto spread = ext::make_shared<SimpleQuote>(0.01);
+    ZeroSpreadedTermStructure moving((Handle<YieldTermStructure>(curve)),
+                                     Handle<Quote>(spread));
+    YieldCurveSnapshot snapshot(moving, curve->dates());
+    DiscountFactor before = snapshot.discount(5.0);
+    spread->setValue(0.02);
+    if (snapshot.discount(5.0) != before)
+        BOOST_ERROR("snapshot changed with the original curve");
+
+    BOOST_CHECK_THROW(snapshot.discount(-1.0), Error);
+
+    // a default-constructed snapshot can't be used
+    YieldCurveSnapshot empty;
+    Time t = 1.0;
+    DiscountFactor df;
+    BOOST_CHECK_THROW(empty.discount(t), Error);
+    BOOST_CHECK_THROW(empty.discount(&t, &t + 1, &df), Error);
+}
+
 test_suite* TermStructureTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -435,6 +523,7 @@ test_suite* TermStructureTest::suite() {
                              &TermStructureTest::testLinkToNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                     &TermStructureTest::testCompositeZeroYieldStructures));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testSnapshot));
     return suite;
 }
 
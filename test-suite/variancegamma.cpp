@@ -24,6 +24,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/instruments/europeanoption.hpp>
 #include <ql/experimental/variancegamma/analyticvariancegammaengine.hpp>
+#include <ql/experimental/variancegamma/cosvariancegammaengine.hpp>
 #include <ql/experimental/variancegamma/fftvariancegammaengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -205,6 +206,29 @@ void VarianceGammaTest::testVarianceGamma() {
                     error, tol);
             }
         }
+
+        // Test COS engine
+        // the series coefficients are shared by options with the same expiry
+        ext::shared_ptr<PricingEngine> cosEngine(
+            new COSVarianceGammaEngine(stochProcess));
+        for (Size j=0; j<LENGTH(options); j++)
+        {
+            ext::shared_ptr<VanillaOption> option = ext::static_pointer_cast<VanillaOption>(optionList[j]);
+            option->setPricingEngine(cosEngine);
+
+            Real calculated = option->NPV();
+            Real expected = results[i][j];
+            Real error = std::fabs(calculated-expected);
+            if (error>tol) {
+                ext::shared_ptr<StrikedTypePayoff> payoff =
+                    ext::dynamic_pointer_cast<StrikedTypePayoff>(option->payoff());
+                REPORT_FAILURE("cos value", payoff, option->exercise(),
+                    processes[i].s, processes[i].q, processes[i].r,
+                    today, processes[i].sigma, processes[i].nu,
+                    processes[i].theta, expected, calculated,
+                    error, tol);
+            }
+        }
     }
 }
 